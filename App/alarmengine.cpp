@@ -0,0 +1,384 @@
+#include "alarmengine.h"
+
+#include <QDebug>
+#include <cmath>
+
+const char *AlarmRule::kindName(Kind kind)
+{
+    switch (kind) {
+    case Threshold: return "threshold";
+    case Rate:      return "rate";
+    case CommLoss:  return "commLoss";
+    case Stale:     return "stale";
+    default:        return "external";
+    }
+}
+
+AlarmEngine::AlarmEngine(QObject *parent)
+    : QAbstractListModel(parent)
+{
+}
+
+int AlarmEngine::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_rules.size();
+}
+
+QVariant AlarmEngine::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_rules.size())
+        return QVariant();
+
+    const AlarmRule &r = m_rules[index.row()];
+    switch (role) {
+    case NameRole:      return r.name;
+    case KindRole:      return QString::fromLatin1(AlarmRule::kindName(r.kind));
+    case ChannelRole:   return r.channel;
+    case ActiveRole:    return r.active;
+    case ActionsRole:   return r.actions;
+    case EnabledRole:   return r.enabled;
+    case TripCountRole: return r.tripCount;
+    case LastTripRole:  return r.lastTripHostTime;
+    default:            return QVariant();
+    }
+}
+
+QHash<int, QByteArray> AlarmEngine::roleNames() const
+{
+    return {
+        { NameRole,      "name" },
+        { KindRole,      "kind" },
+        { ChannelRole,   "channel" },
+        { ActiveRole,    "active" },
+        { ActionsRole,   "actions" },
+        { EnabledRole,   "ruleEnabled" },
+        { TripCountRole, "tripCount" },
+        { LastTripRole,  "lastTrip" },
+    };
+}
+
+// ═══════════════════════════════════════════════
+// 규칙 관리
+// ═══════════════════════════════════════════════
+
+int AlarmEngine::indexOf(const QString &name) const
+{
+    for (int i = 0; i < m_rules.size(); ++i) {
+        if (m_rules[i].name == name)
+            return i;
+    }
+    return -1;
+}
+
+void AlarmEngine::setRule(const AlarmRule &rule)
+{
+    AlarmRule r = rule;
+    r.channelIndex = m_channelNames.indexOf(r.channel);
+
+    const int row = indexOf(r.name);
+    if (row >= 0) {
+        if (m_rules[row].active)
+            --m_activeCount;
+        m_rules[row] = r;
+        emit dataChanged(index(row), index(row));
+    } else {
+        beginInsertRows(QModelIndex(), m_rules.size(), m_rules.size());
+        m_rules.append(r);
+        endInsertRows();
+    }
+    emit activeChanged();
+    emit rulesChanged();
+}
+
+void AlarmEngine::resolveChannels(const QStringList &channelNames)
+{
+    m_channelNames = channelNames;
+    for (AlarmRule &r : m_rules)
+        r.channelIndex = m_channelNames.indexOf(r.channel);
+}
+
+bool AlarmEngine::setActions(const QString &name, int actions)
+{
+    const int row = indexOf(name);
+    if (row < 0)
+        return false;
+    m_rules[row].actions = actions & (AlarmRule::Notify | AlarmRule::Mark | AlarmRule::EStop);
+    emit dataChanged(index(row), index(row), { ActionsRole });
+    emit rulesChanged();
+    return true;
+}
+
+bool AlarmEngine::setEnabled(const QString &name, bool enabled)
+{
+    const int row = indexOf(name);
+    if (row < 0)
+        return false;
+    AlarmRule &r = m_rules[row];
+    r.enabled = enabled;
+    if (!enabled && r.active) {
+        r.active = false;
+        --m_activeCount;
+        emit alarmCleared(r.name, r.actions);
+        emit activeChanged();
+    }
+    r.pendingSinceMs = -1;
+    emit dataChanged(index(row), index(row));
+    emit rulesChanged();
+    return true;
+}
+
+bool AlarmEngine::isActive(const QString &name) const
+{
+    const int row = indexOf(name);
+    return row >= 0 && m_rules[row].active;
+}
+
+QStringList AlarmEngine::activeAlarms() const
+{
+    QStringList out;
+    for (const AlarmRule &r : m_rules) {
+        if (r.active && r.actions != AlarmRule::None)
+            out << r.name;
+    }
+    return out;
+}
+
+void AlarmEngine::resetState()
+{
+    for (AlarmRule &r : m_rules) {
+        if (r.active)
+            emit alarmCleared(r.name, r.actions);
+        r.active = false;
+        r.pendingSinceMs = -1;
+        r.prevTimeMs = -1;
+        r.lastChangeMs = -1;
+    }
+    m_activeCount = 0;
+    if (!m_rules.isEmpty())
+        emit dataChanged(index(0), index(m_rules.size() - 1));
+    emit activeChanged();
+}
+
+// ═══════════════════════════════════════════════
+// 평가
+// ═══════════════════════════════════════════════
+
+bool AlarmEngine::condition(AlarmRule &r, const float *values, quint8 commBits, double mcuMs) const
+{
+    switch (r.kind) {
+    case AlarmRule::Threshold: {
+        const double v = values[r.channelIndex];
+        r.lastValue = v;
+        // 발생 중이면 히스테리시스만큼 안쪽으로 들어와야 해제
+        const double hyst = r.active ? r.hysteresis : 0.0;
+        return (r.hasHigh && v > r.high - hyst) || (r.hasLow && v < r.low + hyst);
+    }
+    case AlarmRule::Rate: {
+        const double v = values[r.channelIndex];
+        const double dt = (mcuMs - r.prevTimeMs) / 1000.0;
+        const bool first = r.prevTimeMs < 0 || dt <= 0;
+        const double rate = first ? 0.0 : (v - r.prevValue) / dt;
+        r.prevValue = v;
+        r.prevTimeMs = mcuMs;
+        if (first)
+            return r.active;
+        r.lastValue = rate;
+        return std::fabs(rate) > r.high - (r.active ? r.hysteresis : 0.0);
+    }
+    case AlarmRule::CommLoss:
+        r.lastValue = commBits;
+        return (commBits & r.commMask) != r.commMask;
+    case AlarmRule::Stale: {
+        const double v = values[r.channelIndex];
+        if (r.lastChangeMs < 0 || v != r.prevValue || mcuMs < r.lastChangeMs) {
+            r.prevValue = v;
+            r.lastChangeMs = mcuMs;
+        }
+        r.lastValue = mcuMs - r.lastChangeMs;
+        return mcuMs - r.lastChangeMs >= r.staleMs;
+    }
+    default:
+        return r.active;
+    }
+}
+
+/**
+ * evaluate()
+ *
+ * 조건이 현재 상태와 다르면 그 시각부터 디바운스 시작, 지연(on/off)만큼 유지되면 전이.
+ * 중간에 조건이 되돌아가면 디바운스 취소.
+ */
+void AlarmEngine::evaluate(const float *values, quint8 commBits, double mcuMs, double hostTime, double detectedMs)
+{
+    for (int i = 0; i < m_rules.size(); ++i) {
+        AlarmRule &r = m_rules[i];
+        if (!r.enabled || r.kind == AlarmRule::External)
+            continue;
+        if (r.kind != AlarmRule::CommLoss && r.channelIndex < 0)
+            continue;
+
+        const bool cond = condition(r, values, commBits, mcuMs);
+        if (cond == r.active) {
+            r.pendingSinceMs = -1;
+            continue;
+        }
+        if (r.pendingSinceMs < 0 || mcuMs < r.pendingSinceMs)
+            r.pendingSinceMs = mcuMs;
+        if (mcuMs - r.pendingSinceMs >= (r.active ? r.offDelayMs : r.onDelayMs))
+            transition(i, cond, hostTime, QString(), detectedMs);
+    }
+}
+
+void AlarmEngine::raise(const QString &name, bool active, double hostTime, const QString &detail,
+                        double detectedMs)
+{
+    const int row = indexOf(name);
+    if (row < 0 || !m_rules[row].enabled || m_rules[row].active == active)
+        return;
+    transition(row, active, hostTime, detail, detectedMs);
+}
+
+void AlarmEngine::transition(int row, bool active, double hostTime, const QString &detail, double detectedMs)
+{
+    AlarmRule &r = m_rules[row];
+    r.active = active;
+    r.pendingSinceMs = -1;
+
+    if (active) {
+        ++m_activeCount;
+        ++r.tripCount;
+        r.lastTripHostTime = hostTime;
+
+        QString message = r.name + ": ";
+        switch (r.kind) {
+        case AlarmRule::Threshold:
+            message += r.channel + " = " + QString::number(r.lastValue, 'f', 2);
+            break;
+        case AlarmRule::Rate:
+            message += "d(" + r.channel + ")/dt = " + QString::number(r.lastValue, 'f', 1) + "/s";
+            break;
+        case AlarmRule::CommLoss:
+            message += QString("comm 0x%1 (need 0x%2)").arg(int(r.lastValue), 2, 16, QChar('0'))
+                                                       .arg(r.commMask, 2, 16, QChar('0'));
+            break;
+        case AlarmRule::Stale:
+            message += r.channel + " unchanged " + QString::number(r.lastValue, 'f', 0) + " ms";
+            break;
+        default:
+            message += detail;
+            break;
+        }
+        // 동작(비상 정지 등)이 먼저 — 모델 갱신은 그 다음
+        emit alarmRaised(r.name, message, r.actions, detectedMs);
+    } else {
+        --m_activeCount;
+        emit alarmCleared(r.name, r.actions);
+    }
+
+    emit dataChanged(index(row), index(row), { ActiveRole, TripCountRole, LastTripRole });
+    emit activeChanged();
+}
+
+// ═══════════════════════════════════════════════
+// JSON (alarm_rules.json)
+// ═══════════════════════════════════════════════
+
+static const struct { const char *name; AlarmRule::Action action; } ACTION_NAMES[] = {
+    { "notify", AlarmRule::Notify }, { "mark", AlarmRule::Mark }, { "estop", AlarmRule::EStop },
+};
+
+AlarmRule AlarmEngine::ruleFromMap(const QVariantMap &map, bool *ok)
+{
+    AlarmRule r;
+    *ok = false;
+    r.name = map.value("name").toString();
+    if (r.name.isEmpty())
+        return r;
+
+    const QString kind = map.value("kind").toString();
+    bool known = false;
+    for (int k = AlarmRule::Threshold; k <= AlarmRule::External; ++k) {
+        if (kind == QLatin1String(AlarmRule::kindName(AlarmRule::Kind(k)))) {
+            r.kind = AlarmRule::Kind(k);
+            known = true;
+        }
+    }
+    if (!known)
+        return r;
+
+    r.channel    = map.value("channel").toString();
+    r.high       = map.value("high", 0).toDouble();
+    r.hasHigh    = r.kind != AlarmRule::Threshold || map.contains("high");
+    r.hasLow     = map.contains("low");
+    r.low        = map.value("low", 0).toDouble();
+    r.hysteresis = map.value("hysteresis", 0).toDouble();
+    r.onDelayMs  = map.value("onDelayMs", 0).toDouble();
+    r.offDelayMs = map.value("offDelayMs", 0).toDouble();
+    r.commMask   = quint8(map.value("commMask", 0).toInt());
+    r.staleMs    = map.value("staleMs", 0).toDouble();
+    r.enabled    = map.value("enabled", true).toBool();
+
+    r.actions = AlarmRule::None;
+    const QStringList actions = map.value("actions").toStringList();
+    for (const QString &a : actions) {
+        for (const auto &n : ACTION_NAMES) {
+            if (a == QLatin1String(n.name))
+                r.actions |= n.action;
+        }
+    }
+
+    const bool needsChannel = r.kind == AlarmRule::Threshold || r.kind == AlarmRule::Rate
+                              || r.kind == AlarmRule::Stale;
+    *ok = !needsChannel || !r.channel.isEmpty();
+    return r;
+}
+
+QVariantMap AlarmEngine::ruleToMap(const AlarmRule &r)
+{
+    QVariantMap m;
+    m["name"] = r.name;
+    m["kind"] = QString::fromLatin1(AlarmRule::kindName(r.kind));
+    if (!r.channel.isEmpty())  m["channel"] = r.channel;
+    if (r.kind == AlarmRule::Threshold || r.kind == AlarmRule::Rate) {
+        if (r.hasHigh) m["high"] = r.high;
+        if (r.hasLow)  m["low"] = r.low;
+        m["hysteresis"] = r.hysteresis;
+    }
+    if (r.kind == AlarmRule::CommLoss) m["commMask"] = int(r.commMask);
+    if (r.kind == AlarmRule::Stale)    m["staleMs"] = r.staleMs;
+    m["onDelayMs"] = r.onDelayMs;
+    m["offDelayMs"] = r.offDelayMs;
+    m["enabled"] = r.enabled;
+
+    QStringList actions;
+    for (const auto &n : ACTION_NAMES) {
+        if (r.actions & n.action)
+            actions << QString::fromLatin1(n.name);
+    }
+    m["actions"] = actions;
+    return m;
+}
+
+bool AlarmEngine::load(const QVariantList &list)
+{
+    bool allOk = true;
+    for (const QVariant &v : list) {
+        bool ok = false;
+        const AlarmRule r = ruleFromMap(v.toMap(), &ok);
+        if (!ok) {
+            qWarning() << "AlarmEngine: skipping invalid rule" << v.toMap().value("name").toString();
+            allOk = false;
+            continue;
+        }
+        setRule(r);
+    }
+    return allOk;
+}
+
+QVariantList AlarmEngine::toVariant() const
+{
+    QVariantList out;
+    for (const AlarmRule &r : m_rules)
+        out << ruleToMap(r);
+    return out;
+}
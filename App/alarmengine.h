@@ -0,0 +1,131 @@
+#ifndef ALARMENGINE_H
+#define ALARMENGINE_H
+
+#include <QAbstractListModel>
+#include <QStringList>
+#include <QVariantMap>
+#include <QVector>
+
+/**
+ * AlarmRule
+ *
+ * 규칙 하나 (조건 + 히스테리시스 + 디바운스 + 동작).
+ *
+ *  Threshold : 채널 값 > high 또는 < low (각각 생략 가능)  (해제: high - hyst 이하 && low + hyst 이상)
+ *  Rate      : |d(채널)/dt| > high  (단위/s)       (해제: high - hyst 이하)
+ *  CommLoss  : (commBits & commMask) != commMask  (요구 비트 중 하나라도 빠짐)
+ *  Stale     : 채널 값이 staleMs 동안 한 번도 안 바뀜 (센서 고착)
+ *  External  : raise() 로 외부(링크 워치독 등)에서 직접 설정
+ *
+ * 조건이 onDelayMs 동안 유지돼야 발생, offDelayMs 동안 사라져야 해제 (MCU 시각 기준).
+ */
+struct AlarmRule
+{
+    enum Kind : quint8 { Threshold, Rate, CommLoss, Stale, External };
+    enum Action : quint8 { None = 0x0, Notify = 0x1, Mark = 0x2, EStop = 0x4 };
+
+    QString name;
+    Kind    kind = Threshold;
+    QString channel;
+    double  high = 0;
+    double  low = 0;
+    bool    hasHigh = true;
+    bool    hasLow = false;
+    double  hysteresis = 0;
+    double  onDelayMs = 0;
+    double  offDelayMs = 0;
+    quint8  commMask = 0;
+    double  staleMs = 0;
+    int     actions = Notify;
+    bool    enabled = true;
+
+    // ── 상태 ──
+    int     channelIndex = -1;
+    bool    active = false;
+    double  pendingSinceMs = -1;    // 조건 변화가 처음 관측된 MCU 시각
+    double  prevValue = 0;
+    double  prevTimeMs = -1;
+    double  lastChangeMs = -1;
+    double  lastValue = 0;          // 마지막 평가 값 (메시지용)
+    qint64  tripCount = 0;
+    double  lastTripHostTime = 0;
+
+    static const char *kindName(Kind kind);
+};
+
+/**
+ * AlarmEngine
+ *
+ * 디코드된 패킷마다 (수신 스레드, 디스플레이 주기 아님) 모든 규칙을 평가.
+ * 상태가 바뀔 때만 시그널/모델 갱신 → 평상시 비용은 규칙당 비교 몇 개.
+ *
+ *  - alarmRaised(): 호출자가 동작(Notify/Mark/EStop) 수행.  DirectConnection 으로
+ *    같은 호출 스택에서 비상 정지가 나가도록 evaluate() 안에서 즉시 발행
+ *  - 규칙은 JSON 으로 로드/저장 (load/toVariant), 동작/활성은 QML 에서 변경 가능
+ */
+class AlarmEngine : public QAbstractListModel
+{
+    Q_OBJECT
+
+    Q_PROPERTY(int         activeCount  READ activeCount  NOTIFY activeChanged)
+    Q_PROPERTY(QStringList activeAlarms READ activeAlarms NOTIFY activeChanged)
+
+public:
+    enum Roles {
+        NameRole = Qt::UserRole + 1,
+        KindRole,
+        ChannelRole,
+        ActiveRole,
+        ActionsRole,
+        EnabledRole,
+        TripCountRole,
+        LastTripRole,
+    };
+
+    explicit AlarmEngine(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    // 규칙 추가/교체 (같은 이름이면 교체).  채널 이름은 resolveChannels() 로 인덱스화
+    void setRule(const AlarmRule &rule);
+    void resolveChannels(const QStringList &channelNames);
+    const QVector<AlarmRule> &rules() const { return m_rules; }
+
+    bool        load(const QVariantList &list);
+    QVariantList toVariant() const;
+    static AlarmRule ruleFromMap(const QVariantMap &map, bool *ok);
+    static QVariantMap ruleToMap(const AlarmRule &rule);
+
+    // 패킷 1개 평가.  values: 히스토리 채널 순서, mcuMs: 보정된 MCU 시각, hostTime: 호스트 타임라인 (s)
+    // detectedMs: 호출자 시계로 찍은 감지 시각 (디코드 시작), alarmRaised() 로 그대로 전달
+    void evaluate(const float *values, quint8 commBits, double mcuMs, double hostTime, double detectedMs);
+    // External 규칙 직접 설정 (디바운스 없음)
+    void raise(const QString &name, bool active, double hostTime, const QString &detail = QString(),
+               double detectedMs = -1);
+    void resetState();
+
+    int         activeCount() const { return m_activeCount; }
+    QStringList activeAlarms() const;
+    Q_INVOKABLE bool isActive(const QString &name) const;
+    Q_INVOKABLE bool setActions(const QString &name, int actions);
+    Q_INVOKABLE bool setEnabled(const QString &name, bool enabled);
+
+signals:
+    void alarmRaised(const QString &name, const QString &message, int actions, double detectedMs);
+    void alarmCleared(const QString &name, int actions);
+    void activeChanged();
+    void rulesChanged();
+
+private:
+    bool condition(AlarmRule &rule, const float *values, quint8 commBits, double mcuMs) const;
+    void transition(int row, bool active, double hostTime, const QString &detail, double detectedMs);
+    int  indexOf(const QString &name) const;
+
+    QVector<AlarmRule> m_rules;
+    QStringList        m_channelNames;
+    int                m_activeCount = 0;
+};
+
+#endif // ALARMENGINE_H
@@ -0,0 +1,134 @@
+#include "clocksync.h"
+
+ClockSync::ClockSync()
+{
+    reset();
+}
+
+void ClockSync::reset()
+{
+    m_hasLast = false;
+    m_lastRaw = 0;
+    m_extended = 0;
+    m_blockOpen = false;
+    m_blockStart = 0;
+    m_blockMin = EnvelopePoint();
+    m_pointHead = 0;
+    m_pointCount = 0;
+    m_refMcu = 0;
+    m_intercept = 0;
+    m_slope = 0;
+    m_errorBoundMs = 0;
+}
+
+/**
+ * addSample()
+ *
+ * 패킷 도착마다 O(1).  회귀는 블록이 닫힐 때(1초마다) 최대 64점으로만 수행.
+ */
+qint64 ClockSync::addSample(quint32 mcuMs, double hostMs)
+{
+    // ── uint32 → 64비트 확장 (wraparound 는 int32 델타로 자연 처리) ──
+    if (!m_hasLast) {
+        m_extended = mcuMs;
+        m_hasLast = true;
+    } else {
+        const qint32 delta = static_cast<qint32>(mcuMs - m_lastRaw);
+        if (delta < RESYNC_BACK_MS) {
+            // 타임스탬프 역행 → MCU 리셋, 추정 처음부터 다시
+            reset();
+            m_hasLast = true;
+            m_extended = mcuMs;
+            ++m_resyncCount;
+        } else {
+            m_extended += delta;
+        }
+    }
+    m_lastRaw = mcuMs;
+
+    const double mcu    = static_cast<double>(m_extended);
+    const double offset = hostMs - mcu;
+
+    // ── 블록 최소점 갱신 ──
+    if (!m_blockOpen) {
+        m_blockOpen = true;
+        m_blockStart = m_extended;
+        m_blockMin = { mcu, offset };
+        if (!isLocked() && m_pointCount == 0) {
+            m_refMcu = mcu;
+            m_intercept = offset;
+        }
+    } else if (m_extended - m_blockStart >= BLOCK_MS) {
+        closeBlock();
+        m_blockStart = m_extended;
+        m_blockMin = { mcu, offset };
+    } else if (offset < m_blockMin.offsetMs) {
+        m_blockMin = { mcu, offset };
+    }
+
+    // ── 인과성 보정: 예측 도착 시각이 실제보다 늦으면 선을 즉시 내림 ──
+    const double predicted = m_intercept + m_slope * (mcu - m_refMcu);
+    if (offset < predicted)
+        m_intercept -= predicted - offset;
+
+    return m_extended;
+}
+
+double ClockSync::toHostMs(qint64 mcuMs) const
+{
+    const double mcu = static_cast<double>(mcuMs);
+    return mcu + m_intercept + m_slope * (mcu - m_refMcu);
+}
+
+void ClockSync::closeBlock()
+{
+    m_points[m_pointHead] = m_blockMin;
+    m_pointHead = (m_pointHead + 1) % MAX_POINTS;
+    if (m_pointCount < MAX_POINTS)
+        ++m_pointCount;
+
+    if (isLocked())
+        fit();
+}
+
+/**
+ * fit()
+ *
+ * 블록 최소점에 최소제곱 직선을 맞춘 뒤, 모든 점이 선 위에 오도록
+ * 절편을 내려 하한 지지선으로 만든다.  남는 최대 잔차 = 오차 한계.
+ */
+void ClockSync::fit()
+{
+    const int oldest = (m_pointHead - m_pointCount + MAX_POINTS) % MAX_POINTS;
+    const double ref = m_points[oldest].mcuMs;
+
+    double sx = 0, sy = 0, sxx = 0, sxy = 0;
+    for (int k = 0; k < m_pointCount; ++k) {
+        const EnvelopePoint &p = m_points[(oldest + k) % MAX_POINTS];
+        const double x = p.mcuMs - ref;
+        sx  += x;
+        sy  += p.offsetMs;
+        sxx += x * x;
+        sxy += x * p.offsetMs;
+    }
+
+    const double n = m_pointCount;
+    const double denom = n * sxx - sx * sx;
+    double slope = denom > 0 ? (n * sxy - sx * sy) / denom : 0.0;
+    slope = qBound(-1e-3, slope, 1e-3);   // 수정 발진기 기준 ±1000ppm 이상은 비정상
+    double intercept = (sy - slope * sx) / n;
+
+    double minResidual = 0, maxResidual = 0;
+    for (int k = 0; k < m_pointCount; ++k) {
+        const EnvelopePoint &p = m_points[(oldest + k) % MAX_POINTS];
+        const double r = p.offsetMs - (intercept + slope * (p.mcuMs - ref));
+        if (k == 0 || r < minResidual) minResidual = r;
+        if (k == 0 || r > maxResidual) maxResidual = r;
+    }
+    intercept += minResidual;
+
+    m_refMcu = ref;
+    m_intercept = intercept;
+    m_slope = slope;
+    m_errorBoundMs = maxResidual - minResidual;
+}
@@ -0,0 +1,73 @@
+#ifndef CLOCKSYNC_H
+#define CLOCKSYNC_H
+
+#include <QtGlobal>
+
+/**
+ * ClockSync
+ *
+ * MCU timestamp_ms(uint32) → 호스트 단조 시계(ms) 매핑 추정기.
+ *
+ * 시리얼 버퍼링 때문에 도착 시각은 항상 "송신 시각 + 지연(≥ 최소 지연)" 이므로
+ * (host - mcu) 오프셋의 하한(lower envelope)이 실제 시계 관계를 가장 잘 나타낸다.
+ *  1. 1초 블록마다 (host - mcu) 최소값 1점을 뽑는다 (지터 제거)
+ *  2. 최근 블록 최소점들에 온라인 선형 회귀 → offset + drift
+ *  3. uint32 wraparound(약 49.7일)는 int32 델타 누적으로 64비트 확장
+ *  4. 타임스탬프가 크게 역행하면 MCU 리셋으로 보고 재동기
+ */
+class ClockSync
+{
+public:
+    ClockSync();
+
+    void reset();
+
+    // 패킷 1개 반영. 반환값: wraparound 보정된 64비트 MCU 시각(ms)
+    qint64 addSample(quint32 mcuMs, double hostMs);
+
+    // 보정된 MCU 시각 → 호스트 시각(ms)
+    double toHostMs(qint64 mcuMs) const;
+
+    bool   isLocked()     const { return m_pointCount >= MIN_FIT_POINTS; }
+    double driftPpm()     const { return m_slope * 1e6; }
+    double errorBoundMs() const { return m_errorBoundMs; }
+    int    resyncCount()  const { return m_resyncCount; }
+
+private:
+    void closeBlock();
+    void fit();
+
+    static constexpr int    BLOCK_MS       = 1000;  // 최소값 추출 블록 길이
+    static constexpr int    MAX_POINTS     = 64;    // 회귀 창 (약 1분)
+    static constexpr int    MIN_FIT_POINTS = 3;
+    static constexpr qint32 RESYNC_BACK_MS = -1000; // 이 이상 역행 → MCU 리셋
+
+    struct EnvelopePoint {
+        double mcuMs    = 0;
+        double offsetMs = 0;   // host - mcu
+    };
+
+    // ── 64비트 확장 ──
+    bool    m_hasLast = false;
+    quint32 m_lastRaw = 0;
+    qint64  m_extended = 0;
+
+    // ── 현재 블록 최소점 ──
+    bool   m_blockOpen = false;
+    qint64 m_blockStart = 0;
+    EnvelopePoint m_blockMin;
+
+    // ── 블록 최소점 링버퍼 ──
+    EnvelopePoint m_points[MAX_POINTS];
+    int m_pointHead = 0;
+    int m_pointCount = 0;
+
+    // ── 추정 결과: offset(mcu) = m_intercept + m_slope * (mcu - m_refMcu) ──
+    double m_refMcu = 0;
+    double m_intercept = 0;
+    double m_slope = 0;
+    double m_errorBoundMs = 0;
+    int    m_resyncCount = 0;
+};
+
+#endif // CLOCKSYNC_H
@@ -1,11 +1,106 @@
 #include "cmgserialmanager.h"
 #include <QDebug>
 #include <QStandardPaths>
+#include <QVariantMap>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonArray>
 #include <cstring>
 
 static const quint8 MAGIC_BYTE_1 = 0xAA;
 static const quint8 MAGIC_BYTE_2 = 0x55;
 static const int    PACKET_SIZE  = 110;
+static const int    HISTORY_CAPACITY = 12000;   // 100Hz × 120초
+static const int    EVENT_CAPACITY   = 1000;    // 펌웨어 이벤트 타임라인
+static const double LINK_RECOVERY_MS = 5000.0;  // Silent/Corrupt 지속 → 포트 재오픈
+static const int    RECONNECT_MIN_MS = 100;     // 재연결 백오프 시작
+static const int    RECONNECT_MAX_MS = 5000;    // 재연결 백오프 상한
+
+// 보레이트 자동 탐색: 후보마다 PROBE_WINDOW_MS 동안 유효 패킷 PROBE_MIN_PACKETS 개면 확정
+// (100Hz 기준 창 하나에 약 15 패킷).  마지막 성공 보레이트를 먼저 시도
+static const int    PROBE_WINDOW_MS   = 150;
+static const int    PROBE_MIN_PACKETS = 3;
+static const int    PROBE_RATES[] = { 115200, 921600, 230400, 460800, 1000000, 2000000, 1500000, 500000, 250000 };
+static const double REPROBE_CORRUPT_MS = 1000.0;    // 자동 모드: Corrupt 지속 → 재탐색 (펌웨어 보레이트 변경)
+static const double RATE_WINDOW_MS     = 500.0;     // 링크 사용률 측정 창
+
+// 기본 알람 규칙 (alarm_rules.json 에 같은 이름이 있으면 덮어씀)
+//   name, kind, channel, high, low, hysteresis, onDelayMs, offDelayMs, actions
+static QVariantList defaultAlarmRules()
+{
+    auto rule = [](const char *name, const char *kind, const char *channel,
+                   double high, double low, double hyst, double onMs, double offMs, QStringList actions) {
+        QVariantMap m;
+        m["name"] = name;
+        m["kind"] = kind;
+        m["channel"] = channel;
+        m["high"] = high;
+        m["low"] = low;
+        m["hysteresis"] = hyst;
+        m["onDelayMs"] = onMs;
+        m["offDelayMs"] = offMs;
+        m["actions"] = actions;
+        return m;
+    };
+    const QStringList notifyMark = { "notify", "mark" };
+
+    QVariantMap commLoss;
+    commLoss["name"] = "comm_loss";
+    commLoss["kind"] = "commLoss";
+    commLoss["commMask"] = 0x3F;           // 6개 통신 비트 모두 필요
+    commLoss["onDelayMs"] = 50;
+    commLoss["offDelayMs"] = 200;
+    commLoss["actions"] = notifyMark;
+
+    QVariantMap imuStale;
+    imuStale["name"] = "imu_stale";
+    imuStale["kind"] = "stale";
+    imuStale["channel"] = "roll";
+    imuStale["staleMs"] = 500;
+    imuStale["actions"] = notifyMark;
+
+    return {
+        rule("roll_limit",      "threshold", "roll",        25,    -25,    3,   30, 200, notifyMark),
+        rule("roll_rate",       "rate",      "roll",        300,   0,      50,  20, 200, notifyMark),
+        rule("gimbal_limit",    "threshold", "gimbalAngle", 60,    -60,    5,   30, 200, notifyMark),
+        rule("wheel_overspeed", "threshold", "wheel1Rpm",   10500, -10500, 300, 50, 200, notifyMark),
+        commLoss,
+        imuStale,
+        // 링크 워치독 (external: raise() 로만 설정)
+        rule("link_degraded",   "external",  "",            0,     0,      0,   0,  0,   notifyMark),
+        rule("link_silent",     "external",  "",            0,     0,      0,   0,  0,   notifyMark),
+        rule("link_corrupt",    "external",  "",            0,     0,      0,   0,  0,   notifyMark),
+        // 표시 전용 (동작 없음): 안정 램프
+        rule("roll_unstable",   "threshold", "roll",        2,     -2,     0.5, 0,  100, {}),
+    };
+}
+
+// 네이티브 채널 (parseTelemetryPacket 의 m_sampleValues 순서와 일치), 뒤에 파생 채널이 이어짐
+static const char *const NATIVE_CHANNELS[] = {
+    "roll", "pitch", "yaw",
+    "gyroX", "gyroY", "gyroZ",
+    "accelX", "accelY",
+    "targetRPM", "wheel1Rpm", "wheel2Rpm",
+    "wheel1Pwm", "wheel2Pwm",
+    "gimbalAngle", "gimbalTarget", "gimbalVelocity",
+};
+static const int NATIVE_CHANNEL_COUNT = int(sizeof(NATIVE_CHANNELS) / sizeof(NATIVE_CHANNELS[0]));
+
+// 기본 파생 채널 (사용자 정의 파일로 덮어쓸 수 있음)
+static const char *const DEFAULT_DERIVED[][2] = {
+    { "torque",       "wheel1Rpm / 1000 * gimbalVelocity" },
+    { "wheelRpmDiff", "wheel1Rpm - wheel2Rpm" },
+    { "gimbalError",  "gimbalTarget - gimbalAngle" },
+    { "rollRateLpf",  "lpf(gyroX, 5)" },
+};
+
+static QStringList nativeChannelNames()
+{
+    QStringList names;
+    for (const char *name : NATIVE_CHANNELS)
+        names << QString::fromLatin1(name);
+    return names;
+}
 
 // ═══════════════════════════════════════════════
 // 생성자 / 소멸자
@@ -14,33 +109,145 @@ static const int    PACKET_SIZE  = 110;
 CMGSerialManager::CMGSerialManager(QObject *parent)
     : QObject(parent)
     , m_serial(new QSerialPort(this))
+    , m_scheduler(new CommandScheduler(m_serial, this))
+    , m_commandTracker(new CommandTracker(this))
+    , m_ackTimer(new QTimer(this))
+    , m_logs(new LogRouter(this))
     , m_reconnectTimer(new QTimer(this))
-    , m_dataTimeoutTimer(new QTimer(this))
+    , m_portWatcher(new PortWatcher(this))
+    , m_opener(new PortOpener(this))
+    , m_probeTimer(new QTimer(this))
+    , m_watchdogTimer(new QTimer(this))
+    , m_history(new TelemetryHistory(HISTORY_CAPACITY, this))
+    , m_derived(nativeChannelNames())
 {
+    for (const char *name : NATIVE_CHANNELS)
+        m_history->addChannel(QString::fromLatin1(name));
+    m_sampleValues.resize(NATIVE_CHANNEL_COUNT);
+
+    for (const auto &def : DEFAULT_DERIVED) {
+        QString error;
+        if (!addDerivedChannel(def[0], def[1], &error))
+            qWarning() << "CMGSerialManager: default derived channel" << def[0] << "-" << error;
+    }
+    loadDerivedChannels();
+    m_torqueChannel = m_history->channelIndex("torque");
+
+    // 통계 채널/창: 20초 창은 차트 표시 구간 (Y축 자동 스케일용)
+    m_stats = new TelemetryStats(m_history,
+                                 { "roll", "gyroX", "gimbalAngle", "gimbalVelocity",
+                                   "torque", "wheel1Rpm", "wheel2Rpm" },
+                                 { 1.0, 5.0, 20.0, 30.0 }, this);
+    m_spectrum = new SpectrumAnalyzer(m_history, this);
+    m_events = new EventTimeline(m_history, EVENT_CAPACITY, this);
+
+    // 알람: 기본 규칙 → 사용자 파일로 덮어쓰기, 이후 변경은 파일에 저장
+    m_alarms = new AlarmEngine(this);
+    m_alarms->resolveChannels(m_history->channelNames());
+    m_alarms->load(defaultAlarmRules());
+    loadAlarmRules();
+    connect(m_alarms, &AlarmEngine::alarmRaised, this, &CMGSerialManager::onAlarmRaised, Qt::DirectConnection);
+    connect(m_alarms, &AlarmEngine::alarmCleared, this, [this](const QString &name, int actions) {
+        if (actions & AlarmRule::Notify)
+            emit logReceived("ALARM CLEARED: " + name);
+        if (actions & AlarmRule::Mark) {
+            QJsonObject fields;
+            fields["name"] = name;
+            fields["active"] = false;
+            writeSessionEvent("alarm", fields);
+        }
+    });
+    connect(m_alarms, &AlarmEngine::rulesChanged, this, &CMGSerialManager::saveAlarmRules);
+
     connect(m_serial, &QSerialPort::readyRead,
             this, &CMGSerialManager::onReadyRead);
     connect(m_serial, &QSerialPort::errorOccurred,
             this, &CMGSerialManager::onErrorOccurred);
 
-    // 재연결 타이머: 2초 간격
-    m_reconnectTimer->setInterval(2000);
+    // 저지연 모드 수신 스레드: readyRead 와 같은 수신 경로, 읽기 실패 = 장치 제거
+    m_reader = new SerialReader(this);
+    connect(m_reader, &SerialReader::dataRead,
+            this, &CMGSerialManager::receiveBytes);
+    connect(m_reader, &SerialReader::readFailed, this, [this](const QString &reason) {
+        qWarning() << "CMGSerialManager: reader failed -" << reason << "- will auto-reconnect";
+        emit logReceived("Serial error: " + reason);
+        dropPort("Device lost — reconnecting...");
+    });
+    connect(m_reader, &SerialReader::threadTuned, this, [this](const QVariantMap &report) {
+        for (auto it = report.cbegin(); it != report.cend(); ++it) {
+            m_lowLatencyReport.insert(it.key(), it.value());
+            qWarning().noquote() << "CMGSerialManager: low-latency" << it.key() << "=" << it.value().toString();
+        }
+        emit lowLatencyChanged();
+    });
+
+    // 송신 큐: 실제 송신/폐기를 로그로 전달
+    connect(m_scheduler, &CommandScheduler::commandSent, this, [this](const QString &cmd) {
+        qDebug().noquote() << QString("TX @%1s:").arg(hostTime(), 0, 'f', 3) << cmd;
+        m_commandTracker->commandSent(cmd, hostNowMs());
+        m_logs->ingestCommand(cmd, hostTime());   // 실제 송신된 명령만 (병합된 중간 값 제외)
+        emit commandSent(cmd);
+    });
+
+    // 모든 로그 메시지 → C++ 분류/포맷 → 카테고리별 링버퍼 모델
+    connect(this, &CMGSerialManager::logReceived, m_logs, &LogRouter::ingest);
+    // 분류된 원본 → 회전 세션 로그 파일 (화면 100줄 밖 내용 보존)
+    m_sessionLog = new SessionLog(dataFolderPath() + "/logs", this);
+    m_logViewer = new LogFileModel(this);
+    connect(m_logs, &LogRouter::routed, this, [this](int category, const QString &message) {
+        m_sessionLog->append(category, hostTime(), message);
+    });
+    connect(m_scheduler, &CommandScheduler::commandDropped, this,
+            [this](const QString &cmd, const QString &reason) {
+        emit logReceived("TX dropped: " + cmd + " (" + reason + ")");
+    });
+    connect(m_scheduler, &CommandScheduler::queueChanged,
+            this, &CMGSerialManager::txQueueChanged);
+
+    // 응답 타임아웃: 100ms 마다 검사, 초과 시 경고 (펌웨어 메인 루프 과부하 징후)
+    m_ackTimer->setInterval(100);
+    connect(m_ackTimer, &QTimer::timeout, this, [this]() {
+        m_commandTracker->expire(hostNowMs());
+    });
+    connect(m_commandTracker, &CommandTracker::commandTimedOut, this, [this](const QString &cmd) {
+        qWarning() << "CMGSerialManager: ACK timeout -" << cmd;
+        emit logReceived("ACK TIMEOUT: " + cmd);
+    });
+    m_ackTimer->start();
+
+    // 재연결: 단발 타이머 + 지수 백오프, 핫플러그 알림이 오면 즉시
+    m_reconnectTimer->setSingleShot(true);
     connect(m_reconnectTimer, &QTimer::timeout,
             this, &CMGSerialManager::tryReconnect);
-
-    // 데이터 수신 감시 타이머: 3초 내 유효 데이터 없으면 경고
-    m_dataTimeoutTimer->setInterval(3000);
-    m_dataTimeoutTimer->setSingleShot(true);
-    connect(m_dataTimeoutTimer, &QTimer::timeout,
-            this, &CMGSerialManager::onDataTimeout);
-
-    refreshPorts();
+    connect(m_portWatcher, &PortWatcher::devicesChanged,
+            this, &CMGSerialManager::onDevicesChanged);
+    // 포트 열기: I/O 스레드 결과 (큐잉)
+    connect(m_opener, &PortOpener::finished,
+            this, &CMGSerialManager::onPortOpened);
+
+    m_probeTimer->setSingleShot(true);
+    m_probeTimer->setInterval(PROBE_WINDOW_MS);
+    connect(m_probeTimer, &QTimer::timeout,
+            this, &CMGSerialManager::onBaudProbeTimeout);
+
+    // 링크 워치독: 포트가 열려 있는 동안 10 ms 마다 판정 (데드라인 30 ~ 50 ms 해상도)
+    m_watchdogTimer->setInterval(10);
+    m_watchdogTimer->setTimerType(Qt::PreciseTimer);
+    connect(m_watchdogTimer, &QTimer::timeout,
+            this, &CMGSerialManager::onWatchdogTick);
+
+    // 호스트 타임라인 원점 (차트/녹화/명령 로그 공통)
+    m_hostClock.start();
+
+    // 시작 시 한 번은 동기 열거 (QML Component.onCompleted 가 바로 목록을 읽음)
+    m_portWatcher->scanNow();
+    m_ports = m_portWatcher->portNames();
     qWarning() << "CMGSerialManager: initialized, ports:" << m_ports;
 }
 
 CMGSerialManager::~CMGSerialManager()
 {
-    if (m_serial->isOpen())
-        m_serial->close();
+    closePort();
 }
 
 // ═══════════════════════════════════════════════
@@ -70,30 +277,97 @@ QStringList CMGSerialManager::availablePorts() const
     return m_ports;
 }
 
+// 비동기 재열거 (결과는 onDevicesChanged → portsChanged).  시작 시 목록은 생성자에서 동기 열거
 void CMGSerialManager::refreshPorts()
 {
-    QStringList ports;
-    const auto infos = QSerialPortInfo::availablePorts();
-    for (const QSerialPortInfo &info : infos)
-        ports << info.portName();
-    ports.sort();
-
-    if (m_ports != ports) {
-        m_ports = ports;
-        emit portsChanged();
-    }
+    m_portWatcher->rescan();
 }
 
 void CMGSerialManager::connectPort(const QString &portName, int baudRate)
 {
-    if (m_serial->isOpen())
+    if (m_serial->isOpen() || m_opener->isPending())
         disconnectPort();
 
     // 재연결용 파라미터 기억
+    // baudRate <= 0 → 자동 탐색 (마지막 성공 보레이트부터)
     m_lastPortName = portName;
-    m_lastBaudRate = baudRate;
+    m_autoBaud = baudRate <= 0;
+    if (!m_autoBaud)
+        m_lastBaudRate = baudRate;
     m_autoReconnect = true;
+    // 재열거 후 같은 보드를 찾기 위한 식별 정보 (VID/PID/시리얼)
+    m_targetDevice = m_portWatcher->device(portName);
 
+    setConnectionStatus("Opening: " + portName);
+    beginOpen(m_targetDevice, m_lastBaudRate, OpenConnect);
+}
+
+/**
+ * beginOpen()
+ *
+ * 포트 열기 요청 (수동 연결, 자동 재연결, 저지연 모드 전환 공통).
+ * open(2)/termios/저지연 장치 설정은 PortOpener 의 I/O 스레드에서 — 응답 없는 USB 장치도
+ * GUI 스레드를 막지 않음.  결과는 onPortOpened (대기 중인 이전 요청은 취소).
+ */
+void CMGSerialManager::beginOpen(const SerialDeviceInfo &device, int baudRate, OpenReason reason)
+{
+    m_openReason = reason;
+    m_openingDevice = device;
+    m_opener->open(device.portName, baudRate, m_lowLatency.enabled);
+}
+
+/**
+ * onPortOpened()
+ *
+ * I/O 스레드의 열기 결과.  성공하면 openPort() 로 마무리, 실패(열기 오류,
+ * PortOpener::OPEN_TIMEOUT_MS 초과)면 요청 이유별로 보고/재시도.
+ */
+void CMGSerialManager::onPortOpened(const PortOpenResult &result)
+{
+    QString error = result.error;
+    const bool opened = result.ok() && openPort(result, &error);
+
+    switch (m_openReason) {
+    case OpenConnect:
+        if (opened) {
+            stopReconnectTimer();
+            qWarning() << "CMGSerialManager: Port opened:" << m_targetDevice.describe()
+                       << "@" << (m_autoBaud ? QString("auto") : QString::number(m_lastBaudRate));
+        } else {
+            qWarning() << "CMGSerialManager: FAILED to open" << result.portName << "-" << error;
+            setConnectionStatus("Failed: " + error);
+            emit logReceived("Connection failed: " + error);
+            startReconnectTimer();
+        }
+        break;
+    case OpenReconnect:
+        if (opened) {
+            m_targetDevice = m_openingDevice;
+            stopReconnectTimer();
+        } else {
+            // 노드는 생겼지만 아직 권한 설정 전(EACCES), 장치 무응답(타임아웃) 등 → 짧은 백오프로 재시도
+            qDebug() << "CMGSerialManager: Reconnect failed -" << error;
+            scheduleReconnect();
+        }
+        break;
+    case OpenReopen:
+        if (!opened)
+            dropPort("Reopen failed: " + error);
+        break;
+    }
+}
+
+/**
+ * openPort()
+ *
+ * I/O 스레드가 연 장치에 QSerialPort 를 붙이고 수신 상태 초기화.
+ * 장치는 이미 활성화되고 같은 termios 로 설정돼 있어 QSerialPort::open() 이 막히지 않음.
+ * 실패 시 상태는 건드리지 않고 false + error (호출자가 보고/재시도).
+ */
+bool CMGSerialManager::openPort(const PortOpenResult &opened, QString *error)
+{
+    const QString &portName = opened.portName;
+    const int baudRate = opened.baudRate;
     m_serial->setPortName(portName);
     m_serial->setBaudRate(baudRate);
     m_serial->setDataBits(QSerialPort::Data8);
@@ -101,26 +375,162 @@ void CMGSerialManager::connectPort(const QString &portName, int baudRate)
     m_serial->setStopBits(QSerialPort::OneStop);
     m_serial->setFlowControl(QSerialPort::NoFlowControl);
 
-    if (m_serial->open(QIODevice::ReadWrite)) {
-        // 시리얼 입출력 버퍼 클리어 (잔여 데이터 방지)
-        m_serial->clear();
-        stopReconnectTimer();
-        m_buffer.clear();
-        m_asciiCarry.clear();
-        m_packetCount = 0;
-        m_checksumFails = 0;
-        m_totalBytesReceived = 0;
-        m_dataReceived = false;
-        qWarning() << "CMGSerialManager: Port opened:" << portName << "@" << baudRate;
-        setConnectionStatus("Connecting: " + portName + " @ " + QString::number(baudRate));
-        emit logReceived("Connecting: " + portName + " @ " + QString::number(baudRate));
-        m_dataTimeoutTimer->start();  // 3초 후 데이터 없으면 경고
-    } else {
-        qWarning() << "CMGSerialManager: FAILED to open" << portName << "-" << m_serial->errorString();
-        setConnectionStatus("Failed: " + m_serial->errorString());
-        emit logReceived("Connection failed: " + m_serial->errorString());
-        startReconnectTimer();
+    // 저지연 모드: 수신 스레드가 I/O 스레드의 fd 로 받고 QSerialPort 는 송신 전용
+    // (그 fd 는 QSerialPort::open() 의 TIOCEXCL 보다 먼저 열려 있음).
+    // 미리 연 fd 가 없으면 (비 Linux) 기존 readyRead 경로로
+    const bool useReader = opened.lowLatency && opened.fd >= 0;
+    if (!m_serial->open(useReader ? QIODevice::WriteOnly : QIODevice::ReadWrite)) {
+        *error = m_serial->errorString();
+        m_opener->release(opened);
+        return false;
+    }
+    if (useReader && !m_reader->adopt(opened.fd, m_hostClock)) {
+        *error = "reader thread: " + m_reader->errorString();
+        m_serial->close();
+        m_opener->release(opened);
+        return false;
+    }
+    // readyRead 경로면 미리 연 fd 는 필요 없음 (QSerialPort 가 열고 있으므로 마지막 close 아님)
+    if (!useReader)
+        m_opener->release(opened);
+
+    // 시리얼 입출력 버퍼 클리어 (잔여 데이터 방지)
+    m_serial->clear();
+    if (opened.lowLatency)
+        applyLowLatency(opened);
+    m_buffer.clear();
+    m_buffer.reserve(PACKET_SIZE * 32);
+    m_asciiCarry.clear();
+    m_packetCount = 0;
+    m_checksumFails = 0;
+    m_totalBytesReceived = 0;
+    m_rxLogBucket = -1;
+    m_dataReceived = false;
+    m_clockSync.reset();
+    m_gapTracker.reset();
+    m_alarms->resetState();
+    m_prevMcuTimeMs = -1;
+    setConnectionStatus("Connecting: " + portName + " @ " + QString::number(baudRate));
+    emit logReceived("Connecting: " + portName + " @ " + QString::number(baudRate));
+    m_linkWatchdog.open(hostNowMs());
+    applyLinkState(LinkWatchdog::Waiting);
+    resetRateWindow();
+    m_watchdogTimer->start();
+    // 수신 상태 초기화 뒤에 시작 (clear() 전 잔여 바이트가 새 버퍼로 들어오지 않게)
+    if (useReader)
+        m_reader->start(m_lowLatency);
+
+    if (m_autoBaud)
+        startBaudProbe();
+    return true;
+}
+
+// ═══════════════════════════════════════════════
+// Baud Rate Probe
+// ═══════════════════════════════════════════════
+
+/**
+ * startBaudProbe()
+ *
+ * 열린 포트에서 후보 보레이트를 차례로 적용 (setBaudRate 는 열린 상태에서 가능).
+ * 체크섬 통과 패킷이 창 안에 PROBE_MIN_PACKETS 개 나오면 확정 (processBuffer).
+ * USB CDC 는 보레이트와 무관하게 첫 후보에서 바로 확정됨.
+ */
+void CMGSerialManager::startBaudProbe()
+{
+    m_probeRates.clear();
+    m_probeRates << m_lastBaudRate;
+    for (int rate : PROBE_RATES) {
+        if (!m_probeRates.contains(rate))
+            m_probeRates << rate;
+    }
+    m_probeIndex = 0;
+    m_baudProbing = true;
+    qWarning() << "CMGSerialManager: Baud probe on" << m_lastPortName << m_probeRates;
+    emit logReceived("Baud probe: " + m_lastPortName);
+    applyProbeRate();
+    emit connectionChanged();
+}
+
+void CMGSerialManager::applyProbeRate()
+{
+    const int rate = m_probeRates[m_probeIndex];
+    m_serial->setBaudRate(rate);
+    m_serial->clear();
+    m_buffer.clear();
+    m_asciiCarry.clear();
+    m_packetCount = 0;
+    m_checksumFails = 0;
+    m_lastBaudRate = rate;
+    m_linkWatchdog.open(hostNowMs());
+    resetRateWindow();
+    setConnectionStatus("Connecting: " + m_lastPortName + " probing " + QString::number(rate));
+    m_probeTimer->start();
+}
+
+void CMGSerialManager::onBaudProbeTimeout()
+{
+    if (!m_baudProbing || !m_serial->isOpen())
+        return;
+
+    if (++m_probeIndex < m_probeRates.size()) {
+        applyProbeRate();
+        return;
     }
+
+    // 모든 후보 실패 → 첫 후보로 되돌리고 워치독에 맡김 (Corrupt 지속 시 재탐색, Silent 면 재오픈)
+    m_baudProbing = false;
+    m_lastBaudRate = m_probeRates.first();
+    m_serial->setBaudRate(m_lastBaudRate);
+    m_linkWatchdog.open(hostNowMs());
+    qWarning() << "CMGSerialManager: Baud probe failed on" << m_lastPortName;
+    setConnectionStatus("No data — baud probe failed (" + m_lastPortName + ")");
+    emit logReceived("Baud probe failed: no valid packets at any rate");
+    emit connectionChanged();
+}
+
+void CMGSerialManager::finishBaudProbe()
+{
+    m_probeTimer->stop();
+    m_baudProbing = false;
+    qWarning() << "CMGSerialManager: Baud locked:" << m_lastBaudRate;
+    emit logReceived(QString("Baud locked: %1").arg(m_lastBaudRate));
+    emit connectionChanged();
+}
+
+void CMGSerialManager::stopBaudProbe()
+{
+    m_probeTimer->stop();
+    m_baudProbing = false;
+}
+
+// 링크 사용률 측정 창 재시작 (포트 열기/보레이트 변경 시 누적 카운터가 0 으로 돌아감)
+void CMGSerialManager::resetRateWindow()
+{
+    m_rateWindowStartMs = hostNowMs();
+    m_rateWindowBytes = m_totalBytesReceived;
+    m_rateWindowPackets = m_packetCount;
+}
+
+/**
+ * updateLinkRate()
+ *
+ * RATE_WINDOW_MS 마다 수신 바이트/s 와 8N1 용량(baud / 10 B/s) 대비 사용률.
+ * telemetryUtilization 은 그중 바이너리 패킷 몫 (나머지는 ASCII/깨진 바이트).
+ */
+void CMGSerialManager::updateLinkRate(double now)
+{
+    const double elapsed = now - m_rateWindowStartMs;
+    if (elapsed < RATE_WINDOW_MS)
+        return;
+
+    const double capacity = m_lastBaudRate / 10.0;
+    m_rxBytesPerSec = (m_totalBytesReceived - m_rateWindowBytes) * 1000.0 / elapsed;
+    const double packetBytesPerSec = double(m_packetCount - m_rateWindowPackets) * PACKET_SIZE * 1000.0 / elapsed;
+    m_linkUtilization = capacity > 0 ? 100.0 * m_rxBytesPerSec / capacity : 0.0;
+    m_telemetryUtilization = capacity > 0 ? 100.0 * packetBytesPerSec / capacity : 0.0;
+    resetRateWindow();
+    emit linkRateChanged();
 }
 
 void CMGSerialManager::disconnectPort()
@@ -128,10 +538,16 @@ void CMGSerialManager::disconnectPort()
     // 수동 해제 → 자동 재연결 비활성화
     m_autoReconnect = false;
     stopReconnectTimer();
-    m_dataTimeoutTimer->stop();
+    stopBaudProbe();
+    m_watchdogTimer->stop();
+    m_linkWatchdog.close();
+    applyLinkState(LinkWatchdog::Closed);
 
-    if (m_serial->isOpen()) {
-        m_serial->close();
+    m_scheduler->clear();
+    m_commandTracker->clear();
+
+    if (m_serial->isOpen() || m_opener->isPending()) {
+        closePort();
         m_buffer.clear();
         m_asciiCarry.clear();
         m_dataReceived = false;
@@ -151,9 +567,8 @@ void CMGSerialManager::sendCommand(const QString &cmd)
         emit logReceived("Not connected");
         return;
     }
-    QByteArray data = cmd.toUtf8() + "\n";
-    m_serial->write(data);
-    qDebug() << "TX:" << cmd;
+    // 우선순위/병합/속도 제한은 스케줄러가 담당 (E 는 fast lane)
+    m_scheduler->submit(cmd);
 }
 
 // §1.2  휠 모터 제어
@@ -164,7 +579,16 @@ void CMGSerialManager::sendRPM(int rpm)
 
 void CMGSerialManager::startWheel()    { sendCommand("S1"); }
 void CMGSerialManager::stopWheel()     { sendCommand("S0"); }
-void CMGSerialManager::emergencyStop() { sendCommand("E");  }
+void CMGSerialManager::emergencyStop()
+{
+    // fast lane: 대기 중 명령을 모두 폐기하고 즉시 송신
+    if (!m_serial->isOpen()) {
+        emit logReceived("Not connected");
+        return;
+    }
+    m_scheduler->submit("E", CommandScheduler::Emergency);
+}
+
 void CMGSerialManager::resetEmergency(){ sendCommand("X");  }
 void CMGSerialManager::queryStatus()   { sendCommand("?");  }
 
@@ -213,12 +637,32 @@ void CMGSerialManager::sendRawCommand(const QString &cmd)
 
 void CMGSerialManager::onReadyRead()
 {
-    QByteArray incoming = m_serial->readAll();
+    const double rxHostMs = hostNowMs();
+    receiveBytes(m_serial->readAll(), rxHostMs);
+}
+
+/**
+ * receiveBytes()
+ *
+ * 수신 조각 처리 (readyRead, 저지연 모드 수신 스레드 공통).
+ * rxHostMs: 조각이 준비된 시각 — 수신 스레드는 poll 복귀 시각을 넘겨줌.
+ */
+void CMGSerialManager::receiveBytes(const QByteArray &incoming, double rxHostMs)
+{
+    TRACE_SCOPE(TraceBuffer::Read, incoming.size(), m_buffer.size());
+
+    // 이번 읽기에서 완성되는 패킷들의 도착 시각 (ClockSync 입력)
+    m_rxHostMs = rxHostMs;
+
     m_buffer.append(incoming);
 
-    // 디버그: 수신 바이트 수 (첫 수신 시만 표시, 이후 100패킷마다)
+    // 디버그: 수신 바이트 수 (첫 수신 시, 이후 100패킷 구간마다 한 번)
+    // (m_packetCount % 100 == 0 은 다음 패킷까지 매 읽기마다 참 → 구간 번호로 판단)
     m_totalBytesReceived += incoming.size();
-    if (m_totalBytesReceived == incoming.size() || m_packetCount % 100 == 0) {
+    m_linkWatchdog.bytesReceived(m_rxHostMs);
+    const int rxBucket = m_packetCount / 100;
+    if (rxBucket != m_rxLogBucket) {
+        m_rxLogBucket = rxBucket;
         QString rxMsg = QString("RX: %1 bytes, total: %2, buf: %3")
                             .arg(incoming.size()).arg(m_totalBytesReceived).arg(m_buffer.size());
         qWarning().noquote() << rxMsg;
@@ -267,25 +711,112 @@ void CMGSerialManager::onErrorOccurred(QSerialPort::SerialPortError error)
     // 디바이스 제거(케이블 분리 등) → 포트 닫고 자동 재연결 시작
     if (error == QSerialPort::ResourceError) {
         qWarning() << "CMGSerialManager: Device lost, will auto-reconnect";
-        m_serial->close();
-        m_buffer.clear();
-        m_asciiCarry.clear();
-        m_dataReceived = false;
-        m_dataTimeoutTimer->stop();
-        setConnectionStatus("Device lost — reconnecting...");
-        emit logReceived("Device lost — reconnecting...");
-        startReconnectTimer();
+        dropPort("Device lost — reconnecting...");
+    }
+}
+
+/**
+ * dropPort()
+ *
+ * 포트를 닫고 자동 재연결 타이머 시작 (장치 분리, 워치독 복구 공통).
+ * 수동 해제(disconnectPort)와 달리 m_autoReconnect 는 유지.
+ */
+void CMGSerialManager::dropPort(const QString &reason)
+{
+    m_scheduler->clear();
+    m_commandTracker->clear();
+    closePort();
+    m_buffer.clear();
+    m_asciiCarry.clear();
+    m_dataReceived = false;
+    stopBaudProbe();
+    m_watchdogTimer->stop();
+    m_linkWatchdog.close();
+    applyLinkState(LinkWatchdog::Closed);
+    setConnectionStatus(reason);
+    emit logReceived(reason);
+    startReconnectTimer();
+}
+
+// ═══════════════════════════════════════════════
+// Link Watchdog
+// ═══════════════════════════════════════════════
+
+void CMGSerialManager::onWatchdogTick()
+{
+    if (!m_serial->isOpen())
+        return;
+
+    const double now = hostNowMs();
+    updateLinkRate(now);
+
+    // 보레이트 탐색 중에는 깨진 바이트가 정상 → 판정 보류
+    if (m_baudProbing)
+        return;
+
+    if (m_linkWatchdog.update(now)) {
+        const LinkWatchdog::State state = m_linkWatchdog.state();
+        qWarning() << "CMGSerialManager: link" << LinkWatchdog::stateName(state)
+                   << "silence" << qRound(m_linkWatchdog.silenceMs(now)) << "ms"
+                   << "deadline" << qRound(m_linkWatchdog.deadlineMs()) << "ms";
+        applyLinkState(state);
+    }
+
+    // 자동 복구: 무응답/깨진 데이터가 오래 지속되면 포트를 다시 열어 드라이버/장치 상태 초기화
+    const LinkWatchdog::State state = m_linkWatchdog.state();
+    if (state == LinkWatchdog::Corrupt && m_autoBaud
+        && m_linkWatchdog.silenceMs(now) > REPROBE_CORRUPT_MS) {
+        qWarning() << "CMGSerialManager: link corrupt, re-probing baud rate";
+        startBaudProbe();
+        return;
+    }
+    if ((state == LinkWatchdog::Silent || state == LinkWatchdog::Corrupt)
+        && m_linkWatchdog.silenceMs(now) > LINK_RECOVERY_MS && m_autoReconnect) {
+        qWarning() << "CMGSerialManager: link recovery, reopening" << m_lastPortName;
+        dropPort("Link lost — reopening " + m_lastPortName + "...");
     }
 }
 
-void CMGSerialManager::onDataTimeout()
+/**
+ * applyLinkState()
+ *
+ * 워치독 상태 → 연결 상태 문자열 + external 알람 (link_degraded/silent/corrupt).
+ * 상태 문자열 접두어("Connected:", "No data", ...)는 QML 색상 판정에 사용.
+ */
+void CMGSerialManager::applyLinkState(LinkWatchdog::State state)
 {
-    // 포트는 열렸지만 유효 데이터가 3초간 없음
-    if (m_serial->isOpen() && !m_dataReceived) {
-        qWarning() << "CMGSerialManager: No valid data received — check wiring";
-        setConnectionStatus("No data — check wiring (" + m_lastPortName + ")");
-        emit logReceived("No data received — check wiring or port");
+    const QString port = m_lastPortName + " @ " + QString::number(m_lastBaudRate);
+    const double now = hostNowMs();
+
+    switch (state) {
+    case LinkWatchdog::Healthy:
+        // 첫 패킷의 "Connected:" 는 processBuffer 에서 즉시 표시, 여기서는 회복 시
+        setConnectionStatus("Connected: " + port);
+        break;
+    case LinkWatchdog::Degraded:
+        setConnectionStatus(QString("Link degraded: no packets > %1 ms (%2)")
+                                .arg(qRound(m_linkWatchdog.deadlineMs())).arg(port));
+        break;
+    case LinkWatchdog::Silent:
+        setConnectionStatus("No data — MCU silent (" + m_lastPortName + ")");
+        break;
+    case LinkWatchdog::Corrupt:
+        setConnectionStatus("Bad data — checksum failures (" + port + ")");
+        break;
+    case LinkWatchdog::Waiting:
+    case LinkWatchdog::Closed:
+        break;
     }
+
+    const QString detail = QString("%1 ms since last packet, period %2 ms")
+                               .arg(qRound(m_linkWatchdog.silenceMs(now)))
+                               .arg(m_linkWatchdog.periodMs(), 0, 'f', 1);
+    m_alarms->raise("link_degraded", state == LinkWatchdog::Degraded, now / 1000.0, detail, now);
+    m_alarms->raise("link_silent",   state == LinkWatchdog::Silent,   now / 1000.0, detail, now);
+    m_alarms->raise("link_corrupt",  state == LinkWatchdog::Corrupt,
+                    now / 1000.0, QString("%1 checksum failures").arg(m_linkWatchdog.failsSincePacket()), now);
+
+    emit linkStateChanged();
 }
 
 /**
@@ -314,6 +845,8 @@ void CMGSerialManager::onDataTimeout()
  */
 void CMGSerialManager::processBuffer()
 {
+    TRACE_SCOPE(TraceBuffer::Frame, m_buffer.size());
+
     while (m_buffer.size() >= 2) {
 
         // ── 매직과 줄바꿈 중 먼저 오는 것 탐색 ──
@@ -366,9 +899,9 @@ void CMGSerialManager::processBuffer()
                         --end;
                     lineBytes = lineBytes.mid(start, end - start + 1);
 
-                    QString line = QString::fromUtf8(lineBytes).trimmed();
-                    if (!line.isEmpty())
-                        processAsciiLine(line);
+                    lineBytes = lineBytes.trimmed();
+                    if (!lineBytes.isEmpty())
+                        processAsciiLine(lineBytes);
                 }
                 // else: 바이너리 노이즈에 우연히 \n 포함 → 무시
             }
@@ -420,10 +953,12 @@ void CMGSerialManager::processBuffer()
                 parseTelemetryPacket(packet);
                 m_buffer = m_buffer.mid(PACKET_SIZE);
 
+                if (m_baudProbing && m_packetCount >= PROBE_MIN_PACKETS)
+                    finishBaudProbe();
+
                 // 첫 유효 패킷 수신 → 연결 확정
-                if (!m_dataReceived) {
+                if (!m_dataReceived && !m_baudProbing) {
                     m_dataReceived = true;
-                    m_dataTimeoutTimer->stop();
                     setConnectionStatus("Connected: " + m_lastPortName + " @ " + QString::number(m_lastBaudRate));
                     emit logReceived("Connected: " + m_lastPortName + " @ " + QString::number(m_lastBaudRate));
                 }
@@ -438,6 +973,7 @@ void CMGSerialManager::processBuffer()
                 }
             } else {
                 m_checksumFails++;
+                m_linkWatchdog.checksumFailed(m_rxHostMs);
                 if (m_checksumFails <= 5) {
                     QString failMsg = QString("CHECKSUM FAIL #%1 expected:%2 full:%3 noMagic:%4")
                         .arg(m_checksumFails)
@@ -483,10 +1019,29 @@ void CMGSerialManager::processBuffer()
  */
 void CMGSerialManager::parseTelemetryPacket(const QByteArray &pkt)
 {
+    TRACE_SCOPE(TraceBuffer::Parse, m_packetCount);
+
+    // 알람 감지 시각: 이 패킷으로 규칙이 발생하면 detect→TX 는 여기서부터 (디코드·평가 포함)
+    const double decodeStartMs = hostNowMs();
     const char *d = pkt.constData();
 
     std::memcpy(&m_telemetry.timestampMs, d + 2,  4);
 
+    // MCU 시각 → 호스트 타임라인 (wraparound/드리프트 보정)
+    m_mcuTimeMs = m_clockSync.addSample(m_telemetry.timestampMs, m_rxHostMs);
+    m_telemetryHostMs = m_clockSync.toHostMs(m_mcuTimeMs);
+
+    // MCU 리셋으로 재동기된 경우 갭 계산 기준도 새로 시작
+    if (m_clockSync.resyncCount() != m_clockResyncs) {
+        m_clockResyncs = m_clockSync.resyncCount();
+        m_gapTracker.reset();
+    }
+    // 손실 판정 주기 = 워치독이 학습한 주기 (펌웨어 텔레메트리 주기가 10 ms 가 아니어도 맞게)
+    m_linkWatchdog.packetReceived(m_rxHostMs, m_mcuTimeMs);
+    if (m_linkWatchdog.periodMs() > 0)
+        m_gapTracker.setNominalPeriodMs(m_linkWatchdog.periodMs());
+    m_lastMissed = m_gapTracker.addTimestamp(m_mcuTimeMs);
+
     std::memcpy(&m_telemetry.roll,  d + 6,  4);
     std::memcpy(&m_telemetry.pitch, d + 10, 4);
     std::memcpy(&m_telemetry.yaw,   d + 14, 4);
@@ -526,17 +1081,51 @@ void CMGSerialManager::parseTelemetryPacket(const QByteArray &pkt)
 
     m_telemetry.commBits = static_cast<quint8>(d[108]);
 
+    // 네이티브 채널 (NATIVE_CHANNELS 순서)
+    float *values = m_sampleValues.data();
+    const float native[NATIVE_CHANNEL_COUNT] = {
+        m_telemetry.roll, m_telemetry.pitch, m_telemetry.yaw,
+        m_telemetry.gyroX, m_telemetry.gyroY, m_telemetry.gyroZ,
+        m_telemetry.accelX, m_telemetry.accelY,
+        float(m_telemetry.targetRPM), float(m_telemetry.wheel1Rpm), float(m_telemetry.wheel2Rpm),
+        m_telemetry.wheel1Pwm, m_telemetry.wheel2Pwm,
+        m_telemetry.gimbalAngle, m_telemetry.gimbalTarget, m_telemetry.gimbalVelocity,
+    };
+    std::memcpy(values, native, sizeof(native));
+
+    // 파생 채널: dt 는 MCU 시각 기준 (재동기/첫 패킷이면 필터 상태 초기화)
+    if (m_prevMcuTimeMs < 0 || m_mcuTimeMs <= m_prevMcuTimeMs)
+        m_derived.resetState();
+    const double dt = m_prevMcuTimeMs < 0 ? 0.0 : (m_mcuTimeMs - m_prevMcuTimeMs) / 1000.0;
+    m_prevMcuTimeMs = m_mcuTimeMs;
+    m_derived.evaluate(values, dt);
+
+    // 알람: 히스토리/통계/차트보다 먼저 (비상 정지 지연 최소화)
+    m_evaluatingPacket = true;
+    m_alarms->evaluate(values, m_telemetry.commBits, double(m_mcuTimeMs), m_telemetryHostMs / 1000.0,
+                       decodeStartMs);
+    m_evaluatingPacket = false;
+
+    const double torque = m_torqueChannel >= 0 ? values[m_torqueChannel] : 0.0;
+
+    // 풀레이트 히스토리 (네이티브 + 파생)
+    m_history->append(m_telemetryHostMs / 1000.0, values, m_lastMissed);
+    m_stats->update();
+
+    analyzeStepResponses(m_telemetryHostMs / 1000.0);
+
     // CSV 녹화: 매 패킷마다 기록
     if (m_recording && m_csvStream) {
-        quint32 elapsed = m_telemetry.timestampMs - m_recordStartTs;
-        int mins = (elapsed / 60000) % 100;
-        int secs = (elapsed / 1000) % 60;
-        int ms   = elapsed % 1000;
+        TRACE_SCOPE(TraceBuffer::Record);
+        // 경과 시간은 동기된 호스트 타임라인 기준 (MCU wraparound/드리프트 무관)
+        const qint64 elapsed = qMax<qint64>(0, qRound64(m_telemetryHostMs - m_recordStartHostMs));
+        int mins = int((elapsed / 60000) % 100);
+        int secs = int((elapsed / 1000) % 60);
+        int ms   = int(elapsed % 1000);
         QString timeStr = QString("%1:%2.%3")
             .arg(mins, 2, 10, QChar('0'))
             .arg(secs, 2, 10, QChar('0'))
             .arg(ms, 3, 10, QChar('0'));
-        double torque = (m_telemetry.wheel1Rpm / 1000.0) * m_telemetry.gimbalVelocity;
         *m_csvStream << timeStr << ","
                      << m_telemetry.timestampMs << ","
                      << QString::number(m_telemetry.roll, 'f', 4) << ","
@@ -545,23 +1134,116 @@ void CMGSerialManager::parseTelemetryPacket(const QByteArray &pkt)
                      << QString::number(m_telemetry.gimbalVelocity, 'f', 4) << ","
                      << QString::number(torque, 'f', 4) << ","
                      << m_telemetry.wheel1Rpm << ","
-                     << m_telemetry.wheel2Rpm << "\n";
+                     << m_telemetry.wheel2Rpm << ","
+                     << m_lastMissed;   // 직전 손실 패킷 수 (0 = 연속)
+        for (int c : std::as_const(m_csvDerivedChannels))
+            *m_csvStream << "," << QString::number(values[c], 'f', 4);
+        *m_csvStream << "\n";
     }
 
+    TRACE_SCOPE(TraceBuffer::Notify);
     emit telemetryUpdated();
 }
 
-void CMGSerialManager::processAsciiLine(const QString &line)
+/**
+ * analyzeStepResponses()
+ *
+ * 풀레이트 패킷마다 세 루프의 계단 응답을 O(1) 로 누적.
+ *  gimbal : gimbalTarget → gimbalAngle
+ *  wheel  : targetRPM    → wheel1Rpm
+ *  balance: 0            → roll  (밸런싱 시작 시점부터)
+ */
+void CMGSerialManager::analyzeStepResponses(double timeSec)
+{
+    StepResponseAnalyzer::Result r;
+
+    if (m_stepGimbal.addSample(timeSec, m_telemetry.gimbalTarget, m_telemetry.gimbalAngle, &r))
+        reportStepResponse("gimbal", r);
+
+    if (m_stepWheel.addSample(timeSec, m_telemetry.targetRPM, m_telemetry.wheel1Rpm, &r))
+        reportStepResponse("wheel", r);
+
+    const bool balancing = m_telemetry.balancing != 0;
+    if (balancing && !m_prevBalancing)
+        m_stepBalance.arm(0.0);
+    if (!balancing)
+        m_stepBalance.reset();
+    else if (m_stepBalance.addSample(timeSec, 0.0, m_telemetry.roll, &r))
+        reportStepResponse("balance", r);
+    m_prevBalancing = balancing;
+}
+
+void CMGSerialManager::reportStepResponse(const QString &loop, const StepResponseAnalyzer::Result &r)
 {
-    if (line.isEmpty())
+    QVariantMap result;
+    result["loop"]             = loop;
+    result["startTime"]        = r.startTime;
+    result["initial"]          = r.initial;
+    result["target"]           = r.target;
+    result["riseTime"]         = r.riseTime;
+    result["overshootPct"]     = r.overshootPct;
+    result["settlingTime"]     = r.settlingTime;
+    result["steadyStateError"] = r.steadyStateError;
+    result["iae"]              = r.iae;
+    result["itae"]             = r.itae;
+    result["duration"]         = r.duration;
+    result["settled"]          = r.settled;
+
+    m_stepResults[loop] = result;
+    emit stepResponseCompleted(loop, result);
+    emit stepResponsesChanged();
+
+    // 세션 파일에는 녹화 시작 기준 시각으로 기록
+    QJsonObject event = QJsonObject::fromVariantMap(result);
+    event["startTime"] = r.startTime - m_recordStartHostMs / 1000.0;
+    writeSessionEvent("step_response", event);
+}
+
+void CMGSerialManager::processAsciiLine(const QByteArray &bytes)
+{
+    if (bytes.isEmpty())
         return;
+    TRACE_SCOPE(TraceBuffer::Ascii, bytes.size());
 
+    const QString line = QString::fromUtf8(bytes);
     if (line.startsWith("STATUS:"))
         emit statusReceived(line);
 
+    // 타입 레코드로 변환 → 이벤트 타임라인 (차트 마커/조회용)
+    FirmwareEvent ev = FirmwareEventParser::parse(bytes);
+    ev.hostTime = eventHostTime(ev);
+    m_events->append(ev);
+    if (ev.kind != FirmwareEvent::Text) {
+        QJsonObject fields = QJsonObject::fromVariantMap(EventTimeline::toMap(ev));
+        fields.remove("time");
+        fields["mcuTime"] = fields.take("t");
+        writeSessionEvent("firmware", fields);
+    }
+
+    // 대기 중 명령의 응답이면 왕복 지연 기록 (readyRead 시각 기준)
+    m_commandTracker->lineReceived(line, m_rxHostMs);
+
     emit logReceived(line);
 }
 
+/**
+ * eventHostTime()
+ *
+ * 이벤트의 펌웨어 시각 "t" (ms) 를 호스트 타임라인으로.
+ * t 는 32비트 millis() → 최근 패킷 시각 기준 부호 있는 차이로 wraparound 보정.
+ * t 가 없거나 클럭이 안 잡혔거나 1초 이상 어긋나면 수신 시각 사용.
+ */
+double CMGSerialManager::eventHostTime(const FirmwareEvent &ev) const
+{
+    const double rxSec = m_rxHostMs / 1000.0;
+    if (!ev.hasT || !m_clockSync.isLocked())
+        return rxSec;
+
+    const qint32 delta = qint32(quint32(qint64(ev.t)) - quint32(m_mcuTimeMs));
+    const double mapped = m_clockSync.toHostMs(m_mcuTimeMs + delta) / 1000.0;
+    return qAbs(mapped - rxSec) <= 1.0 ? mapped : rxSec;
+}
+
 // ═══════════════════════════════════════════════
 // Property Getters
 // ═══════════════════════════════════════════════
@@ -600,6 +1282,340 @@ int     CMGSerialManager::commBits()    const { return m_telemetry.commBits; }
 quint32 CMGSerialManager::timestampMs() const { return m_telemetry.timestampMs; }
 int     CMGSerialManager::packetCount() const { return m_packetCount; }
 
+double CMGSerialManager::telemetryTime() const { return m_telemetryHostMs / 1000.0; }
+bool   CMGSerialManager::clockLocked()   const { return m_clockSync.isLocked(); }
+double CMGSerialManager::clockDriftPpm() const { return m_clockSync.driftPpm(); }
+double CMGSerialManager::clockErrorMs()  const { return m_clockSync.errorBoundMs(); }
+
+double CMGSerialManager::linkQuality()     const { return m_gapTracker.linkQuality(); }
+qint64 CMGSerialManager::packetsExpected() const { return m_gapTracker.expected(); }
+qint64 CMGSerialManager::packetsLost()     const { return m_gapTracker.lost(); }
+qint64 CMGSerialManager::longestGapMs()    const { return m_gapTracker.longestGapMs(); }
+int    CMGSerialManager::checksumFails()   const { return m_checksumFails; }
+
+QString CMGSerialManager::linkState()      const { return LinkWatchdog::stateName(m_linkWatchdog.state()); }
+double  CMGSerialManager::linkPeriodMs()   const { return m_linkWatchdog.periodMs(); }
+double  CMGSerialManager::linkDeadlineMs() const { return m_linkWatchdog.deadlineMs(); }
+
+int    CMGSerialManager::baudRate()             const { return m_lastBaudRate; }
+bool   CMGSerialManager::autoBaud()             const { return m_autoBaud; }
+bool   CMGSerialManager::baudProbing()          const { return m_baudProbing; }
+double CMGSerialManager::rxBytesPerSec()        const { return m_rxBytesPerSec; }
+double CMGSerialManager::linkUtilization()      const { return m_linkUtilization; }
+double CMGSerialManager::telemetryUtilization() const { return m_telemetryUtilization; }
+
+QVariantList CMGSerialManager::gapHistogram() const
+{
+    QVariantList bins;
+    for (int b = 0; b < GapTracker::HISTOGRAM_BINS; ++b) {
+        QVariantMap bin;
+        bin["label"] = QString::fromLatin1(GapTracker::histogramLabel(b));
+        bin["count"] = m_gapTracker.histogramBin(b);
+        bins << bin;
+    }
+    return bins;
+}
+
+int CMGSerialManager::txQueueDepth() const { return m_scheduler->queueDepth(); }
+CommandTracker *CMGSerialManager::commands() const { return m_commandTracker; }
+LogRouter      *CMGSerialManager::logs()     const { return m_logs; }
+
+QVariantMap CMGSerialManager::stepResponses() const { return m_stepResults; }
+
+TelemetryHistory *CMGSerialManager::history() const { return m_history; }
+TelemetryStats   *CMGSerialManager::stats()   const { return m_stats; }
+SpectrumAnalyzer *CMGSerialManager::spectrum() const { return m_spectrum; }
+EventTimeline  *CMGSerialManager::events()   const { return m_events; }
+SessionLog     *CMGSerialManager::sessionLog() const { return m_sessionLog; }
+LogFileModel   *CMGSerialManager::logViewer()  const { return m_logViewer; }
+AlarmEngine    *CMGSerialManager::alarms()     const { return m_alarms; }
+
+QVariantMap CMGSerialManager::alarmLatency() const
+{
+    QVariantMap m;
+    m["detectToTxMs"] = m_alarmDetectToTxMs;
+    m["rxToTxMs"]     = m_alarmRxToTxMs;
+    m["rxToTxMaxMs"]  = m_alarmRxToTxMaxMs;
+    m["estopCount"]   = m_alarmEStops;
+    return m;
+}
+
+double CMGSerialManager::torque() const
+{
+    return m_torqueChannel >= 0 ? m_sampleValues[m_torqueChannel] : 0.0;
+}
+
+double CMGSerialManager::channelValue(const QString &name) const
+{
+    const int c = m_history->channelIndex(name);
+    return c >= 0 ? m_sampleValues[c] : 0.0;
+}
+
+double CMGSerialManager::hostNowMs() const { return m_hostClock.nsecsElapsed() / 1e6; }
+double CMGSerialManager::hostTime()  const { return hostNowMs() / 1000.0; }
+
+bool CMGSerialManager::tracing() const { return TraceBuffer::enabled(); }
+
+void CMGSerialManager::setTracing(bool on)
+{
+    if (TraceBuffer::enabled() == on)
+        return;
+    if (on)
+        TraceBuffer::clear();   // 켤 때마다 새 구간부터
+    TraceBuffer::setEnabled(on);
+    emit tracingChanged();
+}
+
+// ═══════════════════════════════════════════════
+// Low-Latency Mode (Linux)
+// ═══════════════════════════════════════════════
+
+bool        CMGSerialManager::lowLatency()       const { return m_lowLatency.enabled; }
+QVariantMap CMGSerialManager::lowLatencyReport() const { return m_lowLatencyReport; }
+
+void CMGSerialManager::setLowLatency(bool on)
+{
+    if (m_lowLatency.enabled == on)
+        return;
+    m_lowLatency.enabled = on;
+    m_lowLatencyReport.clear();
+    // 수신 경로(readyRead ↔ 수신 스레드)가 바뀌므로 열려 있으면 다시 연다
+    // (closePort 가 켜기 전 포트 설정을 복원), 여는 중이면 새 모드로 다시 요청, 아니면 다음 열기에서
+    if (m_serial->isOpen()) {
+        closePort();
+        beginOpen(m_targetDevice, m_lastBaudRate, OpenReopen);
+    } else if (m_opener->isPending()) {
+        beginOpen(m_openingDevice, m_lastBaudRate, m_openReason);
+    }
+    if (!on)
+        emit logReceived("Low-latency mode off");
+    emit lowLatencyChanged();
+}
+
+void CMGSerialManager::setLowLatencyThread(int rtPriority, int cpu)
+{
+    m_lowLatency.rtPriority = rtPriority;
+    m_lowLatency.cpu = cpu;
+    // 수신 스레드 안에서 적용 → threadTuned 로 보고 갱신
+    if (m_lowLatency.enabled && m_reader->isOpen())
+        m_reader->setThreadOptions(m_lowLatency);
+    emit lowLatencyChanged();
+}
+
+/**
+ * applyLowLatency()
+ *
+ * 방금 연 포트의 저지연 설정.  ASYNC_LOW_LATENCY / latency_timer 는 I/O 스레드가 열면서 적용
+ * (opened.tuning), VMIN/VTIME 은 QSerialPort::open() 뒤에 여기서 읽기 fd 에.
+ * 원래 값은 m_lowLatencySaved.  스레드 항목(rtPriority/cpuAffinity)은 수신 스레드가 시작하면서
+ * threadTuned 로 추가.
+ */
+void CMGSerialManager::applyLowLatency(const PortOpenResult &opened)
+{
+    m_lowLatencySaved = opened.saved;
+    m_lowLatencyReport = opened.tuning;
+    if (m_reader->isOpen()) {
+        m_lowLatencyReport["termios"] = SerialTuning::applyTermios(m_reader->handle(), &m_lowLatencySaved);
+        m_lowLatencyReport["reader"] = QString("thread, read %1 B (%2 frames)")
+                                           .arg(SerialReader::READ_BYTES).arg(SerialReader::READ_FRAMES);
+    } else {
+        m_lowLatencyReport["reader"] = QString("unsupported on this platform");
+    }
+    for (auto it = m_lowLatencyReport.cbegin(); it != m_lowLatencyReport.cend(); ++it)
+        qWarning().noquote() << "CMGSerialManager: low-latency" << it.key() << "=" << it.value().toString();
+    emit logReceived("Low-latency mode on");
+    emit lowLatencyChanged();
+}
+
+/**
+ * closePort()
+ *
+ * 대기 중인 열기 취소 (늦게 도착한 결과는 PortOpener 가 release) → 저지연 설정 복원
+ * (포트/읽기 fd 가 열려 있어야 ioctl/tcsetattr 가능) → 수신 스레드 정지 → 포트 닫기.
+ * 리더는 close() 에서 세션을 넘기므로 닫힌 뒤의 조각은 전달되지 않음.
+ */
+void CMGSerialManager::closePort()
+{
+    m_opener->cancel();
+    // 저지연 설정은 수신 스레드 모드에서만 적용되므로 장치/읽기 fd 모두 리더 fd
+    SerialTuning::restore(m_reader->handle(), m_reader->handle(), &m_lowLatencySaved);
+    m_reader->close();
+    if (m_serial->isOpen())
+        m_serial->close();
+}
+
+QString CMGSerialManager::exportTrace()
+{
+    const QString folder = dataFolderPath() + "/traces";
+    QDir().mkpath(folder);
+    const QString filePath = folder + "/trace_" + QDateTime::currentDateTime().toString("yyyyMMdd_hhmmss") + ".json";
+    if (!TraceBuffer::exportChromeJson(filePath)) {
+        qWarning() << "CMGSerialManager: Failed to export trace -" << filePath;
+        return QString();
+    }
+    emit logReceived("Trace exported: " + filePath + " (" + QString::number(TraceBuffer::recordCount()) + " records)");
+    return filePath;
+}
+
+// ═══════════════════════════════════════════════
+// Derived Channels
+// ═══════════════════════════════════════════════
+
+bool CMGSerialManager::addDerivedChannel(const QString &name, const QString &expression, QString *error)
+{
+    const bool isNew = m_derived.indexOf(name.trimmed()) < 0;
+    if (!m_derived.define(name, expression, error))
+        return false;
+
+    // 새 채널은 히스토리 끝에 추가 (히스토리 채널 순서 = 네이티브 + 파생 정의 순서)
+    if (isNew) {
+        m_history->addChannel(name.trimmed());
+        m_sampleValues.resize(m_history->channelCount());
+    }
+    return true;
+}
+
+QString CMGSerialManager::defineDerivedChannel(const QString &name, const QString &expression)
+{
+    QString error;
+    if (!addDerivedChannel(name, expression, &error)) {
+        qWarning() << "CMGSerialManager: derived channel" << name << "-" << error;
+        return error;
+    }
+    saveDerivedChannels();
+    m_alarms->resolveChannels(m_history->channelNames());   // 파생 채널 대상 규칙
+    emit derivedChannelsChanged();
+    return QString();
+}
+
+QVariantList CMGSerialManager::derivedChannels() const
+{
+    QVariantList list;
+    for (int i = 0; i < m_derived.count(); ++i) {
+        QVariantMap ch;
+        ch["name"] = m_derived.name(i);
+        ch["expression"] = m_derived.expression(i);
+        list << ch;
+    }
+    return list;
+}
+
+QString CMGSerialManager::derivedChannelsFile() const
+{
+    return dataFolderPath() + "/derived_channels.json";
+}
+
+/**
+ * loadDerivedChannels()
+ *
+ * derived_channels.json: [ { "name": ..., "expression": ... }, ... ]
+ * 기본 채널과 이름이 같으면 식을 교체, 아니면 정의 순서대로 추가.
+ */
+void CMGSerialManager::loadDerivedChannels()
+{
+    QFile file(derivedChannelsFile());
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+
+    const QJsonArray defs = QJsonDocument::fromJson(file.readAll()).array();
+    for (const QJsonValue &v : defs) {
+        const QJsonObject def = v.toObject();
+        const QString name = def.value("name").toString();
+        QString error;
+        if (!addDerivedChannel(name, def.value("expression").toString(), &error))
+            qWarning() << "CMGSerialManager: skipping derived channel" << name << "-" << error;
+    }
+}
+
+void CMGSerialManager::saveDerivedChannels() const
+{
+    QDir().mkpath(dataFolderPath());
+    QFile file(derivedChannelsFile());
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "CMGSerialManager: Failed to save derived channels -" << file.fileName();
+        return;
+    }
+    QJsonArray defs;
+    for (int i = 0; i < m_derived.count(); ++i)
+        defs.append(QJsonObject { { "name", m_derived.name(i) }, { "expression", m_derived.expression(i) } });
+    file.write(QJsonDocument(defs).toJson());
+}
+
+// ═══════════════════════════════════════════════
+// 알람
+// ═══════════════════════════════════════════════
+
+/**
+ * onAlarmRaised()
+ *
+ * AlarmEngine::evaluate() 안에서 직접 호출 (같은 호출 스택).
+ * EStop 이 먼저: 송신 큐 fast lane 으로 즉시 write + flush 후 지연 측정
+ *   detectToTx : 감지 시각(detectedMs: 패킷 디코드 시작, 외부 규칙은 raise 시각) → write 완료
+ *   rxToTx     : 해당 패킷의 수신 시각 → write 완료 (파싱·평가 포함).
+ *                패킷 규칙만 — 워치독 external 알람(link_silent 등)의 m_rxHostMs 는
+ *                마지막 패킷 시각이라 수백 ms 전일 수 있음
+ */
+void CMGSerialManager::onAlarmRaised(const QString &name, const QString &message, int actions, double detectedMs)
+{
+    if ((actions & AlarmRule::EStop) && m_serial->isOpen()) {
+        const double detectMs = detectedMs >= 0 ? detectedMs : hostNowMs();
+        m_scheduler->submit("E", CommandScheduler::Emergency);
+        const double txMs = hostNowMs();
+
+        m_alarmDetectToTxMs = txMs - detectMs;
+        ++m_alarmEStops;
+        if (m_evaluatingPacket) {
+            m_alarmRxToTxMs = txMs - m_rxHostMs;
+            m_alarmRxToTxMaxMs = qMax(m_alarmRxToTxMaxMs, m_alarmRxToTxMs);
+            if (m_alarmRxToTxMs > 10.0)
+                qWarning() << "CMGSerialManager: alarm E-stop latency" << m_alarmRxToTxMs << "ms (" << name << ")";
+            emit logReceived(QString("ALARM E-STOP: %1 (detect→TX %2 ms, rx→TX %3 ms)")
+                                 .arg(name).arg(m_alarmDetectToTxMs, 0, 'f', 3).arg(m_alarmRxToTxMs, 0, 'f', 3));
+        } else {
+            emit logReceived(QString("ALARM E-STOP: %1 (detect→TX %2 ms)")
+                                 .arg(name).arg(m_alarmDetectToTxMs, 0, 'f', 3));
+        }
+        emit alarmLatencyChanged();
+    }
+
+    if (actions & AlarmRule::Notify)
+        emit logReceived("ALARM: " + message);
+
+    if (actions & AlarmRule::Mark) {
+        QJsonObject fields;
+        fields["name"] = name;
+        fields["active"] = true;
+        fields["message"] = message;
+        fields["estop"] = (actions & AlarmRule::EStop) != 0;
+        writeSessionEvent("alarm", fields);
+    }
+}
+
+QString CMGSerialManager::alarmRulesFile() const
+{
+    return dataFolderPath() + "/alarm_rules.json";
+}
+
+// alarm_rules.json: [ { "name": ..., "kind": ..., ... }, ... ]  (AlarmEngine::ruleToMap 형식)
+void CMGSerialManager::loadAlarmRules()
+{
+    QFile file(alarmRulesFile());
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+    m_alarms->load(QJsonDocument::fromJson(file.readAll()).array().toVariantList());
+}
+
+void CMGSerialManager::saveAlarmRules() const
+{
+    QDir().mkpath(dataFolderPath());
+    QFile file(alarmRulesFile());
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "CMGSerialManager: Failed to save alarm rules -" << file.fileName();
+        return;
+    }
+    file.write(QJsonDocument(QJsonArray::fromVariantList(m_alarms->toVariant())).toJson());
+}
+
 // ═══════════════════════════════════════════════
 // CSV Recording
 // ═══════════════════════════════════════════════
@@ -619,12 +1635,30 @@ void CMGSerialManager::startRecording(const QString &folderPath)
     m_csvFile = new QFile(filePath, this);
     if (m_csvFile->open(QIODevice::WriteOnly | QIODevice::Text)) {
         m_csvStream = new QTextStream(m_csvFile);
-        *m_csvStream << "time,timestamp_ms,roll_angle,roll_velocity,gimbal_angle,gimbal_velocity,torque,wheel_rpm1,wheel_rpm2\n";
+        *m_csvStream << "time,timestamp_ms,roll_angle,roll_velocity,gimbal_angle,gimbal_velocity,torque,wheel_rpm1,wheel_rpm2,gap_missed";
+        // 파생 채널 칼럼 (torque 는 고정 칼럼). 녹화 중 새로 정의한 채널은 다음 녹화부터
+        m_csvDerivedChannels.clear();
+        for (const QString &name : m_derived.names()) {
+            if (name == "torque")
+                continue;
+            m_csvDerivedChannels << m_history->channelIndex(name);
+            *m_csvStream << "," << name;
+        }
+        *m_csvStream << "\n";
         m_csvStream->flush();
         m_recording = true;
-        m_recordStartTs = m_telemetry.timestampMs;
+        m_recordStartHostMs = hostNowMs();
         qWarning() << "CMGSerialManager: Recording started -" << filePath;
         emit logReceived("Recording: " + filePath);
+
+        // 세션 이벤트 파일: 계단 응답 등 CSV 행으로 표현하기 어려운 결과 (JSON Lines)
+        const QFileInfo csvInfo(filePath);
+        m_eventFile = new QFile(csvInfo.path() + "/" + csvInfo.completeBaseName() + ".events.jsonl", this);
+        if (!m_eventFile->open(QIODevice::WriteOnly | QIODevice::Text)) {
+            qWarning() << "CMGSerialManager: Failed to create event file -" << m_eventFile->fileName();
+            delete m_eventFile;
+            m_eventFile = nullptr;
+        }
     } else {
         qWarning() << "CMGSerialManager: Failed to create CSV -" << filePath;
         emit logReceived("Recording failed: " + filePath);
@@ -651,6 +1685,29 @@ void CMGSerialManager::stopRecording()
         delete m_csvFile;
         m_csvFile = nullptr;
     }
+    if (m_eventFile) {
+        m_eventFile->close();
+        delete m_eventFile;
+        m_eventFile = nullptr;
+    }
+}
+
+/**
+ * writeSessionEvent()
+ *
+ * 녹화 중이면 이벤트 파일에 한 줄 기록.
+ * "t" = 녹화 시작 기준 호스트 타임라인 (s), CSV time 칼럼과 같은 기준.
+ */
+void CMGSerialManager::writeSessionEvent(const QString &type, QJsonObject fields)
+{
+    if (!m_recording || !m_eventFile)
+        return;
+
+    fields.insert("type", type);
+    fields.insert("t", (hostNowMs() - m_recordStartHostMs) / 1000.0);
+    m_eventFile->write(QJsonDocument(fields).toJson(QJsonDocument::Compact));
+    m_eventFile->write("\n");
+    m_eventFile->flush();
 }
 
 bool CMGSerialManager::isRecording() const
@@ -671,9 +1728,9 @@ QString CMGSerialManager::dataFolderPath() const
 void CMGSerialManager::startReconnectTimer()
 {
     if (m_autoReconnect && !m_reconnectTimer->isActive()) {
-        qWarning() << "CMGSerialManager: Reconnect timer started (every"
-                   << m_reconnectTimer->interval() << "ms)";
-        m_reconnectTimer->start();
+        m_reconnectDelayMs = RECONNECT_MIN_MS;
+        qWarning() << "CMGSerialManager: Reconnect scheduled, looking for" << m_targetDevice.describe();
+        m_reconnectTimer->start(m_reconnectDelayMs);
     }
 }
 
@@ -685,61 +1742,59 @@ void CMGSerialManager::stopReconnectTimer()
     }
 }
 
-void CMGSerialManager::tryReconnect()
+// 다음 시도는 지수 백오프 (RECONNECT_MIN_MS → RECONNECT_MAX_MS).  핫플러그 알림이 오면 즉시 재시도
+void CMGSerialManager::scheduleReconnect()
 {
-    if (!m_autoReconnect) {
-        stopReconnectTimer();
-        return;
-    }
+    m_reconnectDelayMs = qMin(m_reconnectDelayMs * 2, RECONNECT_MAX_MS);
+    m_reconnectTimer->start(m_reconnectDelayMs);
+}
 
-    // 이미 연결되어 있으면 중단
-    if (m_serial->isOpen()) {
-        stopReconnectTimer();
-        return;
+/**
+ * onDevicesChanged()
+ *
+ * 핫플러그 후 (열거 스레드에서) 새 포트 목록이 도착.
+ * 재연결 대기 중이고 대상 장치가 나타났으면 백오프를 건너뛰고 바로 연다.
+ */
+void CMGSerialManager::onDevicesChanged()
+{
+    const QStringList ports = m_portWatcher->portNames();
+    if (m_ports != ports) {
+        m_ports = ports;
+        emit portsChanged();
     }
 
-    // 포트 목록 갱신
-    refreshPorts();
-
-    if (m_ports.isEmpty()) {
-        qDebug() << "CMGSerialManager: No ports available, retrying...";
-        return;   // 타이머 계속 → 다음 주기에 재시도
+    if (m_autoReconnect && !m_serial->isOpen() && !m_opener->isPending()
+        && m_portWatcher->bestMatch(m_targetDevice).isValid()) {
+        m_reconnectTimer->stop();
+        m_reconnectDelayMs = RECONNECT_MIN_MS;
+        tryReconnect();
     }
+}
 
-    // 1순위: 마지막으로 연결했던 포트
-    QString targetPort;
-    if (!m_lastPortName.isEmpty() && m_ports.contains(m_lastPortName)) {
-        targetPort = m_lastPortName;
-    } else {
-        // 2순위: 사용 가능한 마지막 포트 (보통 가장 최근 장치)
-        targetPort = m_ports.last();
+/**
+ * tryReconnect()
+ *
+ * 마지막으로 연결했던 장치를 VID/PID/시리얼 번호로 찾아 다시 연다
+ * (재열거로 COM 번호/ttyACMn 이 바뀌어도 같은 보드).  못 찾으면 열기를 시도하지 않고
+ * 백오프 후 재시도 — 핫플러그가 없는 플랫폼에서는 PortWatcher 주기 열거가 목록을 갱신.
+ * 열기는 비동기 (결과는 onPortOpened, 실패하면 거기서 백오프).
+ */
+void CMGSerialManager::tryReconnect()
+{
+    if (!m_autoReconnect || m_serial->isOpen() || m_opener->isPending()) {
+        stopReconnectTimer();
+        return;
     }
 
-    qWarning() << "CMGSerialManager: Trying reconnect to" << targetPort << "@" << m_lastBaudRate;
-
-    m_serial->setPortName(targetPort);
-    m_serial->setBaudRate(m_lastBaudRate);
-    m_serial->setDataBits(QSerialPort::Data8);
-    m_serial->setParity(QSerialPort::NoParity);
-    m_serial->setStopBits(QSerialPort::OneStop);
-    m_serial->setFlowControl(QSerialPort::NoFlowControl);
-
-    if (m_serial->open(QIODevice::ReadWrite)) {
-        m_serial->clear();
-        stopReconnectTimer();
-        m_lastPortName = targetPort;
-        m_buffer.clear();
-        m_asciiCarry.clear();
-        m_packetCount = 0;
-        m_checksumFails = 0;
-        m_totalBytesReceived = 0;
-        m_dataReceived = false;
-        qWarning() << "CMGSerialManager: Port reopened:" << targetPort << "@" << m_lastBaudRate;
-        setConnectionStatus("Connecting: " + targetPort + " @ " + QString::number(m_lastBaudRate));
-        emit logReceived("Connecting: " + targetPort + " @ " + QString::number(m_lastBaudRate));
-        m_dataTimeoutTimer->start();
-    } else {
-        qDebug() << "CMGSerialManager: Reconnect failed -" << m_serial->errorString();
-        // 타이머 계속 → 다음 주기에 재시도
+    const SerialDeviceInfo device = m_portWatcher->bestMatch(m_targetDevice);
+    if (!device.isValid()) {
+        qDebug() << "CMGSerialManager: Device not present, retry in" << m_reconnectDelayMs * 2 << "ms";
+        scheduleReconnect();
+        return;
     }
+
+    qWarning() << "CMGSerialManager: Trying reconnect to" << device.describe() << "@" << m_lastBaudRate;
+    // openPort() 가 시작하는 보율 탐색이 새 노드 이름을 보고하도록 먼저 갱신
+    m_lastPortName = device.portName;
+    beginOpen(device, m_lastBaudRate, OpenReconnect);
 }
@@ -11,6 +11,31 @@
 #include <QTextStream>
 #include <QDir>
 #include <QDateTime>
+#include <QElapsedTimer>
+#include <QVariantList>
+#include <QVariantMap>
+#include <QJsonObject>
+
+#include "alarmengine.h"
+#include "clocksync.h"
+#include "derivedchannels.h"
+#include "commandscheduler.h"
+#include "commandtracker.h"
+#include "gaptracker.h"
+#include "linkwatchdog.h"
+#include "logmodel.h"
+#include "portopener.h"
+#include "portwatcher.h"
+#include "stepresponse.h"
+#include "telemetryhistory.h"
+#include "tracebuffer.h"
+#include "telemetrystats.h"
+#include "spectrumanalyzer.h"
+#include "eventtimeline.h"
+#include "logfilemodel.h"
+#include "sessionlog.h"
+#include "serialreader.h"
+#include "serialtuning.h"
 
 /**
  * CMGSerialManager
@@ -72,6 +97,74 @@ class CMGSerialManager : public QObject
     // ── Diagnostic ──
     Q_PROPERTY(int packetCount READ packetCount NOTIFY telemetryUpdated)
 
+    // ── Clock Sync (MCU → 호스트 타임라인) ──
+    Q_PROPERTY(double telemetryTime READ telemetryTime NOTIFY telemetryUpdated)
+    Q_PROPERTY(bool   clockLocked   READ clockLocked   NOTIFY telemetryUpdated)
+    Q_PROPERTY(double clockDriftPpm READ clockDriftPpm NOTIFY telemetryUpdated)
+    Q_PROPERTY(double clockErrorMs  READ clockErrorMs  NOTIFY telemetryUpdated)
+
+    // ── Link Quality (timestamp 델타 기반 손실 검출) ──
+    Q_PROPERTY(double       linkQuality     READ linkQuality     NOTIFY telemetryUpdated)
+    Q_PROPERTY(qint64       packetsExpected READ packetsExpected NOTIFY telemetryUpdated)
+    Q_PROPERTY(qint64       packetsLost     READ packetsLost     NOTIFY telemetryUpdated)
+    Q_PROPERTY(qint64       longestGapMs    READ longestGapMs    NOTIFY telemetryUpdated)
+    Q_PROPERTY(QVariantList gapHistogram    READ gapHistogram    NOTIFY telemetryUpdated)
+    Q_PROPERTY(int          checksumFails   READ checksumFails   NOTIFY telemetryUpdated)
+
+    // ── 링크 워치독 (학습된 주기 기반 상태: waiting/healthy/degraded/silent/corrupt) ──
+    Q_PROPERTY(QString linkState      READ linkState      NOTIFY linkStateChanged)
+    Q_PROPERTY(double  linkPeriodMs   READ linkPeriodMs   NOTIFY telemetryUpdated)
+    Q_PROPERTY(double  linkDeadlineMs READ linkDeadlineMs NOTIFY telemetryUpdated)
+
+    // ── 보레이트 / 링크 사용률 (8N1 용량 대비) ──
+    Q_PROPERTY(int    baudRate             READ baudRate             NOTIFY connectionChanged)
+    Q_PROPERTY(bool   autoBaud             READ autoBaud             NOTIFY connectionChanged)
+    Q_PROPERTY(bool   baudProbing          READ baudProbing          NOTIFY connectionChanged)
+    Q_PROPERTY(double rxBytesPerSec        READ rxBytesPerSec        NOTIFY linkRateChanged)
+    Q_PROPERTY(double linkUtilization      READ linkUtilization      NOTIFY linkRateChanged)   // %
+    Q_PROPERTY(double telemetryUtilization READ telemetryUtilization NOTIFY linkRateChanged)   // %, 패킷 몫
+
+    // ── 명령 송신 큐 ──
+    Q_PROPERTY(int txQueueDepth READ txQueueDepth NOTIFY txQueueChanged)
+    Q_PROPERTY(CommandTracker *commands READ commands CONSTANT)   // 명령별 응답 상태/지연
+
+    // ── 로그 모델 (RPM TX / PID TX / RX / PKT 링버퍼) ──
+    Q_PROPERTY(LogRouter *logs READ logs CONSTANT)
+
+    // ── 계단 응답 분석 (loop 이름 → 최근 결과) ──
+    Q_PROPERTY(QVariantMap stepResponses READ stepResponses NOTIFY stepResponsesChanged)
+
+    // ── 풀레이트 히스토리 (차트 렌더링) ──
+    Q_PROPERTY(TelemetryHistory *history READ history CONSTANT)
+
+    // ── 슬라이딩 통계 (1/5/20/30초 창, 디스플레이 주기 발행) ──
+    Q_PROPERTY(TelemetryStats *stats READ stats CONSTANT)
+
+    // ── 스펙트럼 분석 (Welch PSD, 분석 스레드) ──
+    Q_PROPERTY(SpectrumAnalyzer *spectrum READ spectrum CONSTANT)
+
+    // ── 펌웨어 이벤트 타임라인 (LOG/STATUS/JSON 타입 레코드) ──
+    Q_PROPERTY(EventTimeline *events READ events CONSTANT)
+
+    // ── 세션 로그 파일 (회전 + 인덱스) / 파일 뷰어 ──
+    Q_PROPERTY(SessionLog   *sessionLog READ sessionLog CONSTANT)
+    Q_PROPERTY(LogFileModel *logViewer  READ logViewer  CONSTANT)
+
+    // ── 알람 (패킷마다 규칙 평가, 동작: 알림/녹화 마크/비상 정지) ──
+    Q_PROPERTY(AlarmEngine *alarms       READ alarms       CONSTANT)
+    Q_PROPERTY(QVariantMap  alarmLatency READ alarmLatency NOTIFY alarmLatencyChanged)
+
+    // ── 트레이스 링 (수신/파싱/차트 구간 계측, Chrome trace 내보내기) ──
+    Q_PROPERTY(bool tracing READ tracing WRITE setTracing NOTIFY tracingChanged)
+
+    // ── 저지연 모드 (Linux: 전용 수신 스레드 + ASYNC_LOW_LATENCY, latency_timer, 읽기 fd VMIN/VTIME, 수신 스레드 RT 우선순위) ──
+    Q_PROPERTY(bool        lowLatency       READ lowLatency       WRITE setLowLatency NOTIFY lowLatencyChanged)
+    Q_PROPERTY(QVariantMap lowLatencyReport READ lowLatencyReport NOTIFY lowLatencyChanged)   // 항목 → 적용 결과
+
+    // ── 파생 채널 (이름 = 식, 패킷마다 C++ 에서 평가) ──
+    Q_PROPERTY(double       torque          READ torque          NOTIFY telemetryUpdated)
+    Q_PROPERTY(QVariantList derivedChannels READ derivedChannels NOTIFY derivedChannelsChanged)
+
 public:
     explicit CMGSerialManager(QObject *parent = nullptr);
     ~CMGSerialManager();
@@ -115,6 +208,67 @@ public:
     quint32 timestampMs() const;
     int     packetCount() const;
 
+    double telemetryTime() const;   // 최신 패킷의 호스트 타임라인 시각 (s)
+    bool   clockLocked()   const;
+    double clockDriftPpm() const;
+    double clockErrorMs()  const;
+
+    double       linkQuality()     const;
+    qint64       packetsExpected() const;
+    qint64       packetsLost()     const;
+    qint64       longestGapMs()    const;
+    QVariantList gapHistogram()    const;
+    int          checksumFails()   const;
+
+    QString linkState()      const;
+    double  linkPeriodMs()   const;
+    double  linkDeadlineMs() const;
+
+    int    baudRate()             const;
+    bool   autoBaud()             const;
+    bool   baudProbing()          const;
+    double rxBytesPerSec()        const;
+    double linkUtilization()      const;
+    double telemetryUtilization() const;
+
+    int txQueueDepth() const;
+    CommandTracker *commands() const;
+    LogRouter      *logs() const;
+
+    QVariantMap stepResponses() const;
+
+    TelemetryHistory *history() const;
+    TelemetryStats   *stats() const;
+    SpectrumAnalyzer *spectrum() const;
+    EventTimeline    *events() const;
+    SessionLog       *sessionLog() const;
+    LogFileModel     *logViewer() const;
+    AlarmEngine      *alarms() const;
+    QVariantMap       alarmLatency() const;
+
+    double       torque() const;
+    QVariantList derivedChannels() const;
+
+    // 파생 채널 정의/교체.  성공 시 빈 문자열, 실패 시 오류 메시지
+    Q_INVOKABLE QString defineDerivedChannel(const QString &name, const QString &expression);
+    // 채널(네이티브/파생) 최신 값
+    Q_INVOKABLE double channelValue(const QString &name) const;
+
+    bool tracing() const;
+    void setTracing(bool on);
+    // 트레이스 링 → <data>/traces/trace_*.json (Perfetto).  성공 시 파일 경로, 실패 시 빈 문자열
+    Q_INVOKABLE QString exportTrace();
+
+    bool        lowLatency() const;
+    void        setLowLatency(bool on);
+    QVariantMap lowLatencyReport() const;
+    // 수신 스레드(SerialReader) SCHED_FIFO 우선순위 (0 = 원래 값) / CPU 고정 (-1 = 원래 값).
+    // 저지연 모드일 때만 적용, GUI 스레드는 건드리지 않음
+    Q_INVOKABLE void setLowLatencyThread(int rtPriority, int cpu);
+
+    // 호스트 타임라인 현재 시각 (s) — 차트/녹화/명령 로그 공통 기준
+    Q_INVOKABLE double hostTime() const;
+
     // ── QML Invokable: Connection ──
     Q_INVOKABLE void connectPort(const QString &portName, int baudRate);
     Q_INVOKABLE void disconnectPort();
@@ -147,34 +301,106 @@ signals:
     void telemetryUpdated();
     void logReceived(const QString &message);
     void statusReceived(const QString &message);
+    void commandSent(const QString &command);   // 실제 송신 시점 (큐 통과 후)
+    void txQueueChanged();
+    void stepResponsesChanged();
+    void stepResponseCompleted(const QString &loop, const QVariantMap &result);
+    void derivedChannelsChanged();
+    void tracingChanged();
+    void lowLatencyChanged();
+    void alarmLatencyChanged();
+    void linkStateChanged();
+    void linkRateChanged();
 
 private slots:
     void onReadyRead();
     void onErrorOccurred(QSerialPort::SerialPortError error);
     void tryReconnect();
-    void onDataTimeout();
+    void onWatchdogTick();
+    void onDevicesChanged();
+    void onBaudProbeTimeout();
 
 private:
     void sendCommand(const QString &cmd);
+    void receiveBytes(const QByteArray &incoming, double rxHostMs);
     void processBuffer();
     void parseTelemetryPacket(const QByteArray &packet);
-    void processAsciiLine(const QString &line);
+    void processAsciiLine(const QByteArray &bytes);
+    double eventHostTime(const FirmwareEvent &ev) const;
+    // 포트 열기는 I/O 스레드 (PortOpener) → onPortOpened 에서 마무리.  이유별로 실패 처리가 다름
+    enum OpenReason { OpenConnect, OpenReconnect, OpenReopen };
+    void beginOpen(const SerialDeviceInfo &device, int baudRate, OpenReason reason);
+    void onPortOpened(const PortOpenResult &result);
+    bool openPort(const PortOpenResult &opened, QString *error);
+    void closePort();
     void startReconnectTimer();
+    void scheduleReconnect();
+    void startBaudProbe();
+    void applyProbeRate();
+    void finishBaudProbe();
+    void stopBaudProbe();
+    void resetRateWindow();
+    void updateLinkRate(double now);
+    void applyLowLatency(const PortOpenResult &opened);
     void stopReconnectTimer();
     void setConnectionStatus(const QString &status);
+    void applyLinkState(LinkWatchdog::State state);
+    void dropPort(const QString &reason);
+    double hostNowMs() const;
+    void analyzeStepResponses(double timeSec);
+    void reportStepResponse(const QString &loop, const StepResponseAnalyzer::Result &r);
+    void writeSessionEvent(const QString &type, QJsonObject fields);
+    bool addDerivedChannel(const QString &name, const QString &expression, QString *error);
+    void loadDerivedChannels();
+    void saveDerivedChannels() const;
+    QString derivedChannelsFile() const;
+    void onAlarmRaised(const QString &name, const QString &message, int actions, double detectedMs);
+    void loadAlarmRules();
+    void saveAlarmRules() const;
+    QString alarmRulesFile() const;
 
     QSerialPort *m_serial;
     QByteArray   m_buffer;
     QByteArray   m_asciiCarry;   // 매직 앞에서 잘린 ASCII 조각 보관 (split line 복원용)
+    CommandScheduler *m_scheduler;   // 우선순위 송신 큐 (E fast lane, 세트포인트 병합)
+    CommandTracker   *m_commandTracker;  // 송신 명령 ↔ LOG 응답 매칭
+    QTimer           *m_ackTimer;        // 응답 타임아웃 검사
+    LogRouter        *m_logs;            // logReceived/commandSent → 분류된 로그 모델
 
     // ── 자동 재연결 ──
     QTimer      *m_reconnectTimer = nullptr;
+    PortWatcher *m_portWatcher = nullptr;     // 핫플러그 감시 + 비동기 열거
+    PortOpener  *m_opener = nullptr;          // I/O 스레드 포트 열기 (GUI 스레드를 막지 않음)
+    OpenReason   m_openReason = OpenConnect;
+    SerialDeviceInfo m_targetDevice;          // 재연결 대상 (VID/PID/시리얼)
+    SerialDeviceInfo m_openingDevice;         // 열기 대기 중인 장치 (성공하면 m_targetDevice)
+    int          m_reconnectDelayMs = 0;
     QString      m_lastPortName;
     int          m_lastBaudRate = 115200;
+
+    // ── 보레이트 자동 탐색 / 링크 사용률 ──
+    QTimer      *m_probeTimer = nullptr;
+    bool         m_autoBaud = false;
+    bool         m_baudProbing = false;
+    QList<int>   m_probeRates;
+    int          m_probeIndex = 0;
+    double       m_rateWindowStartMs = 0;
+    qint64       m_rateWindowBytes = 0;
+    qint64       m_rateWindowPackets = 0;
+    double       m_rxBytesPerSec = 0;
+    double       m_linkUtilization = 0;
+    double       m_telemetryUtilization = 0;
+
+    // ── 저지연 모드 ──
+    SerialTuning::Options   m_lowLatency;
+    SerialTuning::PortSaved m_lowLatencySaved;   // 켜기 직전 포트 설정 (closePort 에서 복원)
+    QVariantMap             m_lowLatencyReport;
+    SerialReader           *m_reader = nullptr;   // 저지연 모드 수신 스레드 (열려 있으면 포트는 송신 전용)
     bool         m_autoReconnect = false;   // connectPort 호출 후 활성화
 
     // ── 연결 상태 감시 ──
-    QTimer      *m_dataTimeoutTimer = nullptr;
+    QTimer      *m_watchdogTimer = nullptr;   // 링크 워치독 판정 주기 (10 ms)
+    LinkWatchdog m_linkWatchdog;
     QString      m_connectionStatus = "Disconnected";
     bool         m_dataReceived = false;     // 유효 패킷/ASCII 수신 여부
 
@@ -182,7 +408,48 @@ private:
     QFile       *m_csvFile = nullptr;
     QTextStream *m_csvStream = nullptr;
     bool         m_recording = false;
-    quint32      m_recordStartTs = 0;   // 녹화 시작 시 MCU timestamp
+    double       m_recordStartHostMs = 0;   // 녹화 시작 시 호스트 타임라인 시각
+    QFile       *m_eventFile = nullptr;     // 세션 이벤트 (<녹화>.events.jsonl)
+
+    // ── 시계 동기 ──
+    QElapsedTimer m_hostClock;             // 호스트 단조 시계 (타임라인 원점)
+    ClockSync    m_clockSync;
+    double       m_rxHostMs = 0;           // 현재 수신 조각의 도착 시각
+    qint64       m_mcuTimeMs = 0;          // wraparound 보정된 MCU 시각
+    double       m_telemetryHostMs = 0;    // 최신 패킷의 호스트 타임라인 시각
+    int          m_clockResyncs = 0;       // ClockSync 재동기 횟수 (MCU 리셋 감지용)
+
+    // ── 갭 검출 / 히스토리 ──
+    GapTracker        m_gapTracker;
+    int               m_lastMissed = 0;    // 최신 패킷 직전 손실 수
+    TelemetryHistory *m_history = nullptr;
+    TelemetryStats   *m_stats = nullptr;
+    SpectrumAnalyzer *m_spectrum = nullptr;
+    EventTimeline    *m_events = nullptr;
+    SessionLog       *m_sessionLog = nullptr;
+    LogFileModel     *m_logViewer = nullptr;
+
+    // ── 알람 ──
+    AlarmEngine *m_alarms = nullptr;
+    double       m_alarmDetectToTxMs = -1;  // 마지막 자동 비상 정지: 패킷 디코드 시작 → write 완료
+    double       m_alarmRxToTxMs = -1;      //                         패킷 수신 → write 완료 (패킷 규칙만)
+    double       m_alarmRxToTxMaxMs = 0;
+    int          m_alarmEStops = 0;
+    bool         m_evaluatingPacket = false; // evaluate() 중 = 패킷 규칙 알람 (rx→TX 기록 대상)
+
+    // ── 파생 채널 (히스토리 채널 = 네이티브 + 파생, 같은 순서) ──
+    DerivedChannels m_derived;
+    QVector<float>  m_sampleValues;        // 최신 샘플 (히스토리 채널 순서)
+    int             m_torqueChannel = -1;
+    qint64          m_prevMcuTimeMs = -1;  // 파생 채널 dt 계산용
+    QList<int>      m_csvDerivedChannels;  // 녹화 시작 시점의 추가 CSV 칼럼
+
+    // ── 계단 응답 분석 (gimbal: A 명령, wheel: R 명령, balance: B1 시작) ──
+    StepResponseAnalyzer m_stepGimbal  { 0.5 };    // deg
+    StepResponseAnalyzer m_stepWheel   { 50.0 };   // rpm
+    StepResponseAnalyzer m_stepBalance { 1e9 };    // 세트포인트 고정(0) → arm() 으로만 시작
+    bool                 m_prevBalancing = false;
+    QVariantMap          m_stepResults;
 
     // ── 텔레메트리 패킷 구조 (110 bytes, Little-endian) ──
     struct TelemetryData {
@@ -206,6 +473,7 @@ private:
     int m_packetCount = 0;
     int m_checksumFails = 0;
     qint64 m_totalBytesReceived = 0;
+    int m_rxLogBucket = -1;             // RX 디버그 로그: 100패킷 구간이 바뀔 때만
 };
 
 #endif // CMGSERIALMANAGER_H
@@ -0,0 +1,222 @@
+#include "commandscheduler.h"
+
+#include <QDebug>
+#include <QSerialPort>
+#include <QTimer>
+
+CommandScheduler::CommandScheduler(QSerialPort *port, QObject *parent)
+    : QObject(parent)
+    , m_port(port)
+    , m_pumpTimer(new QTimer(this))
+{
+    m_clock.start();
+
+    m_pumpTimer->setInterval(PUMP_INTERVAL_MS);
+    m_pumpTimer->setTimerType(Qt::PreciseTimer);
+    connect(m_pumpTimer, &QTimer::timeout, this, &CommandScheduler::pump);
+}
+
+// ═══════════════════════════════════════════════
+// 분류
+// ═══════════════════════════════════════════════
+
+CommandScheduler::Priority CommandScheduler::classify(const QString &cmd)
+{
+    if (cmd == "E" || cmd == "EMER")
+        return Emergency;
+    if (cmd.startsWith('?'))
+        return Background;
+    if (!coalesceKey(cmd).isEmpty())
+        return SetPoint;
+    return Control;
+}
+
+/**
+ * coalesceKey()
+ *
+ * 세트포인트 명령의 키 (같은 키는 최신 값만 의미 있음).
+ *   R<rpm> → "R",  A<deg> → "A",  K... → "K",  WK... → "WK",  W<g> → "W",  P... → "P"
+ * 세트포인트가 아니면 빈 문자열.
+ */
+QString CommandScheduler::coalesceKey(const QString &cmd)
+{
+    if (cmd.startsWith("WK"))
+        return QStringLiteral("WK");
+    if (cmd.size() < 2)
+        return {};
+
+    const QChar head = cmd.at(0);
+    const QChar next = cmd.at(1);
+    const bool numeric = next.isDigit() || next == '-' || next == '.';
+    if (numeric && (head == 'R' || head == 'A' || head == 'K' || head == 'W' || head == 'P'))
+        return QString(head);
+    return {};
+}
+
+// ═══════════════════════════════════════════════
+// 제출
+// ═══════════════════════════════════════════════
+
+void CommandScheduler::submit(const QString &cmd)
+{
+    submit(cmd, classify(cmd));
+}
+
+void CommandScheduler::submit(const QString &cmd, Priority priority)
+{
+    if (!m_port->isOpen()) {
+        emit commandDropped(cmd, "Not connected");
+        return;
+    }
+
+    // ── Fast lane: 대기 명령 폐기 후 즉시 송신 ──
+    if (priority == Emergency) {
+        if (!m_queue.isEmpty() || !m_background.isEmpty()) {
+            for (const Entry &e : std::as_const(m_queue))
+                emit commandDropped(e.cmd, "Preempted by " + cmd);
+            for (const Entry &e : std::as_const(m_background))
+                emit commandDropped(e.cmd, "Preempted by " + cmd);
+            m_queue.clear();
+            m_background.clear();
+            emit queueChanged();
+        }
+        QElapsedTimer latency;
+        latency.start();
+        writeNow(cmd);
+        m_lastEmergencyTxUs = latency.nsecsElapsed() / 1000;
+        return;
+    }
+
+    Entry entry;
+    entry.cmd = cmd;
+    entry.priority = priority;
+
+    if (priority == SetPoint) {
+        entry.key = coalesceKey(cmd);
+        // 마지막 Control 이후에 같은 키가 대기 중일 때만 값 교체.
+        // 그 앞의 것과 합치면 Control 을 건너뛰어 순서가 바뀜 (R100, S0 + R200 → R200, S0)
+        for (qsizetype i = m_queue.size() - 1; i >= 0; --i) {
+            Entry &queued = m_queue[i];
+            if (queued.priority == Control)
+                break;
+            if (queued.priority == SetPoint && queued.key == entry.key) {
+                queued.cmd = cmd;
+                ++m_coalesced;
+                return;
+            }
+        }
+    }
+
+    if (priority == Background)
+        m_background.append(entry);
+    else
+        m_queue.append(entry);
+
+    emit queueChanged();
+    pump();   // 여유가 있으면 바로 송신
+}
+
+void CommandScheduler::clear()
+{
+    m_queue.clear();
+    m_background.clear();
+    m_lastSentByKey.clear();
+    m_pumpTimer->stop();
+    emit queueChanged();
+}
+
+// ═══════════════════════════════════════════════
+// 송신
+// ═══════════════════════════════════════════════
+
+void CommandScheduler::pump()
+{
+    const qint64 now = m_clock.elapsed();
+    refillTokens(now);
+
+    QList<Entry> &lane = !m_queue.isEmpty() ? m_queue : m_background;
+    const qsizetype index = nextSendable(lane, now);
+    if (index >= 0) {
+        const Entry entry = lane.takeAt(index);
+        if (writeNow(entry.cmd) && entry.priority == SetPoint)
+            m_lastSentByKey.insert(entry.key, now);
+        emit queueChanged();
+    }
+
+    schedulePump();
+}
+
+/**
+ * nextSendable()
+ *
+ * 지금 보낼 수 있는 첫 항목 (없으면 -1).
+ * 키 최소 간격에 걸린 세트포인트는 다른 키의 세트포인트만 앞지를 수 있음.
+ * 그 뒤의 Control 은 대기 — K... 다음 B1 이 옛 게인으로 밸런싱을 시작하면 안 됨.
+ * 그 외 사유(링크 한도, 토큰 부족)로 막힌 항목은 FIFO 를 지키기 위해 거기서 멈춤.
+ */
+qsizetype CommandScheduler::nextSendable(const QList<Entry> &lane, qint64 nowMs) const
+{
+    // QSerialPort 의 사용자 공간 쓰기 버퍼에 이전 명령이 남아 있으면 대기
+    if (m_port->bytesToWrite() > 0)
+        return -1;
+    if (nowMs - m_lastSentMs < MIN_COMMAND_GAP_MS)
+        return -1;
+
+    for (qsizetype i = 0; i < lane.size(); ++i) {
+        const Entry &entry = lane.at(i);
+        if (entry.priority != SetPoint && i > 0)
+            return -1;    // 앞에 대기 중인 세트포인트가 있음
+        // 버킷보다 긴 명령(sendRawCommand)은 버킷이 가득 찼을 때 송신, 토큰은 음수로
+        if (m_tokens < qMin(entry.cmd.size() + 1.0, TX_BUCKET_BYTES))
+            return -1;
+        if (entry.priority == SetPoint) {
+            const auto it = m_lastSentByKey.constFind(entry.key);
+            if (it != m_lastSentByKey.constEnd() && nowMs - it.value() < SETPOINT_MIN_INTERVAL_MS)
+                continue;
+        }
+        return i;
+    }
+    return -1;
+}
+
+bool CommandScheduler::writeNow(const QString &cmd)
+{
+    if (!m_port->isOpen()) {
+        emit commandDropped(cmd, "Not connected");
+        return false;
+    }
+
+    const QByteArray data = cmd.toUtf8() + "\n";
+    const qint64 written = m_port->write(data);
+    m_port->flush();
+
+    if (written != data.size()) {
+        qWarning() << "CommandScheduler: write failed -" << cmd << m_port->errorString();
+        emit commandDropped(cmd, "Write failed: " + m_port->errorString());
+        return false;
+    }
+
+    const qint64 now = m_clock.elapsed();
+    m_tokens -= data.size();          // Emergency / 긴 명령은 음수 허용 (다음 명령이 대신 대기)
+    m_lastSentMs = now;
+    emit commandSent(cmd);
+    return true;
+}
+
+void CommandScheduler::refillTokens(qint64 nowMs)
+{
+    const qint64 elapsed = nowMs - m_lastRefillMs;
+    if (elapsed <= 0)
+        return;
+    m_tokens = qMin(TX_BUCKET_BYTES, m_tokens + elapsed * TX_BYTES_PER_SEC / 1000.0);
+    m_lastRefillMs = nowMs;
+}
+
+void CommandScheduler::schedulePump()
+{
+    const bool pending = !m_queue.isEmpty() || !m_background.isEmpty();
+    if (pending && !m_pumpTimer->isActive())
+        m_pumpTimer->start();
+    else if (!pending && m_pumpTimer->isActive())
+        m_pumpTimer->stop();
+}
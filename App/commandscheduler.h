@@ -0,0 +1,95 @@
+#ifndef COMMANDSCHEDULER_H
+#define COMMANDSCHEDULER_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QString>
+
+class QSerialPort;
+class QTimer;
+
+/**
+ * CommandScheduler
+ *
+ * HMI 명령 송신 큐.  sendCommand() 가 직접 write 하던 것을 대체.
+ *
+ * 우선순위:
+ *  - Emergency  : E.  큐를 건너뛰고 즉시 write + flush, 대기 중 명령은 모두 폐기
+ *                 (E 이후에 S1 등이 뒤늦게 나가면 안 되므로)
+ *  - Control    : S/B/X 등.  FIFO
+ *  - SetPoint   : R/K/A/WK/W/P.  Control 과 같은 FIFO.  마지막 Control 뒤에 같은 키가
+ *                 대기 중이면 그 자리에서 최신 값으로 교체 (coalescing).
+ *                 키 최소 간격에 걸려 대기 중이면 다른 키의 세트포인트만 먼저 나갈 수 있고
+ *                 뒤의 Control 은 기다림 (K → B1 순서 보장, 즉시 정지는 Emergency)
+ *  - Background : ? 등.  위 큐가 빌 때만 송신
+ *
+ * 송신 속도 제한: 토큰 버킷(바이트/초) + 명령 간 최소 간격 + 같은 세트포인트 키
+ * 최소 간격.  버킷보다 긴 명령은 버킷이 가득 찼을 때 보내고 토큰을 음수로 (큐 정체 방지).
+ * QSerialPort 쓰기 버퍼가 비어 있을 때만 다음 명령을 쓴다 → 100Hz 텔레메트리 보호.
+ */
+class CommandScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Priority { Emergency, Control, SetPoint, Background };
+
+    explicit CommandScheduler(QSerialPort *port, QObject *parent = nullptr);
+
+    void submit(const QString &cmd);
+    void submit(const QString &cmd, Priority priority);
+    void clear();
+
+    int    queueDepth()          const { return m_queue.size() + m_background.size(); }
+    qint64 coalescedCount()      const { return m_coalesced; }
+    qint64 lastEmergencyTxUs()   const { return m_lastEmergencyTxUs; }
+
+    static Priority classify(const QString &cmd);
+    static QString  coalesceKey(const QString &cmd);
+
+signals:
+    void commandSent(const QString &cmd);
+    void commandDropped(const QString &cmd, const QString &reason);
+    void queueChanged();
+
+private slots:
+    void pump();
+
+private:
+    struct Entry {
+        QString  cmd;
+        QString  key;        // SetPoint 만 사용
+        Priority priority = Control;
+    };
+
+    bool writeNow(const QString &cmd);
+    qsizetype nextSendable(const QList<Entry> &lane, qint64 nowMs) const;
+    void refillTokens(qint64 nowMs);
+    void schedulePump();
+
+    static constexpr int    PUMP_INTERVAL_MS       = 5;
+    static constexpr int    MIN_COMMAND_GAP_MS     = 10;    // 텔레메트리 1주기
+    static constexpr int    SETPOINT_MIN_INTERVAL_MS = 100; // 같은 키 재송신 간격
+    static constexpr double TX_BYTES_PER_SEC       = 600.0; // 115200 8N1 의 약 5%
+    static constexpr double TX_BUCKET_BYTES        = 64.0;
+
+    QSerialPort  *m_port;
+    QTimer       *m_pumpTimer;
+    QElapsedTimer m_clock;
+
+    QList<Entry>  m_queue;        // Control + SetPoint (순서 유지)
+    QList<Entry>  m_background;
+    QHash<QString, qint64> m_lastSentByKey;
+
+    double m_tokens = TX_BUCKET_BYTES;
+    qint64 m_lastRefillMs = 0;
+    qint64 m_lastSentMs = -MIN_COMMAND_GAP_MS;
+
+    qint64 m_coalesced = 0;
+    qint64 m_lastEmergencyTxUs = 0;
+};
+
+#endif // COMMANDSCHEDULER_H
@@ -0,0 +1,190 @@
+#include "commandtracker.h"
+
+#include <QVariantMap>
+
+// 지연 히스토그램 상한 (ms), 마지막 빈은 그 이상
+static const double LATENCY_BIN_EDGES[] = { 5, 10, 20, 50, 100, 200, 500 };
+static const char *const LATENCY_BIN_LABELS[] = {
+    "<5", "5-10", "10-20", "20-50", "50-100", "100-200", "200-500", "500+"
+};
+
+CommandTracker::CommandTracker(QObject *parent)
+    : QAbstractListModel(parent)
+{
+}
+
+int CommandTracker::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_records.size();
+}
+
+QVariant CommandTracker::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_records.size())
+        return {};
+
+    const Record &r = m_records.at(index.row());
+    switch (role) {
+    case Qt::DisplayRole:
+    case CommandRole: return r.cmd;
+    case StatusRole:
+        switch (r.status) {
+        case Pending: return QStringLiteral("pending");
+        case Acked:   return QStringLiteral("ok");
+        case Timeout: return QStringLiteral("timeout");
+        case NoAck:   return QStringLiteral("sent");
+        }
+        return {};
+    case LatencyRole: return r.latencyMs;
+    case TimeRole:    return r.sentMs / 1000.0;
+    }
+    return {};
+}
+
+QHash<int, QByteArray> CommandTracker::roleNames() const
+{
+    return {
+        { CommandRole, "command" },
+        { StatusRole,  "status" },
+        { LatencyRole, "latencyMs" },
+        { TimeRole,    "time" },
+    };
+}
+
+/**
+ * ackPattern()
+ *
+ * 명령에 대응하는 응답 줄의 시작 패턴 ("LOG: " 제거 후 비교).
+ * 응답이 정의되지 않은 명령(P 등)은 빈 문자열.
+ */
+QString CommandTracker::ackPattern(const QString &cmd)
+{
+    if (cmd.startsWith("WK"))                return QStringLiteral("Wheel PID");
+    if (cmd == "E" || cmd == "EMER")         return QStringLiteral("EMERGENCY STOP");
+    if (cmd == "X" || cmd == "XRESET")       return QStringLiteral("Emergency stop RESET");
+    if (cmd == "S1")                         return QStringLiteral("Wheel START");
+    if (cmd == "S0")                         return QStringLiteral("Wheel STOP");
+    if (cmd == "B1")                         return QStringLiteral("Balancing START");
+    if (cmd == "B0")                         return QStringLiteral("Balancing STOP");
+    if (cmd.startsWith('?'))                 return QStringLiteral("STATUS:");
+    if (cmd.startsWith('R'))                 return QStringLiteral("Target RPM set to");
+    if (cmd.startsWith('A'))                 return QStringLiteral("Gimbal angle set to");
+    if (cmd.startsWith('K'))                 return QStringLiteral("Balancing PID");
+    if (cmd.startsWith('W'))                 return QStringLiteral("Washout gain set to");
+    return {};
+}
+
+void CommandTracker::commandSent(const QString &cmd, double hostMs)
+{
+    if (m_records.size() >= MAX_RECORDS) {
+        beginRemoveRows({}, 0, 0);
+        m_records.removeFirst();
+        endRemoveRows();
+    }
+
+    Record r;
+    r.cmd = cmd;
+    r.pattern = ackPattern(cmd);
+    r.status = r.pattern.isEmpty() ? NoAck : Pending;
+    r.sentMs = hostMs;
+
+    beginInsertRows({}, m_records.size(), m_records.size());
+    m_records.append(r);
+    endInsertRows();
+    emit statsChanged();
+}
+
+bool CommandTracker::lineReceived(const QString &line, double hostMs)
+{
+    QStringView text(line);
+    if (text.startsWith(u"LOG:"))
+        text = text.mid(4).trimmed();
+
+    // 가장 오래된 대기 명령부터 (같은 패턴은 FIFO)
+    for (int row = 0; row < m_records.size(); ++row) {
+        Record &r = m_records[row];
+        if (r.status != Pending || !text.startsWith(r.pattern))
+            continue;
+
+        r.status = Acked;
+        r.latencyMs = hostMs - r.sentMs;
+        ++m_acked;
+        ++m_histogram[binFor(r.latencyMs)];
+        m_lastLatencyMs = r.latencyMs;
+        m_maxLatencyMs = qMax(m_maxLatencyMs, r.latencyMs);
+
+        updateRow(row);
+        emit commandAcked(r.cmd, r.latencyMs);
+        emit statsChanged();
+        return true;
+    }
+    return false;
+}
+
+void CommandTracker::expire(double hostMs)
+{
+    bool changed = false;
+    for (int row = 0; row < m_records.size(); ++row) {
+        Record &r = m_records[row];
+        if (r.status != Pending || hostMs - r.sentMs < ACK_TIMEOUT_MS)
+            continue;
+
+        r.status = Timeout;
+        ++m_timeouts;
+        updateRow(row);
+        emit commandTimedOut(r.cmd);
+        changed = true;
+    }
+    if (changed)
+        emit statsChanged();
+}
+
+void CommandTracker::clear()
+{
+    // 연결이 끊기면 대기 중 명령은 응답 불가 → 목록은 유지, 대기 상태만 정리
+    for (int row = 0; row < m_records.size(); ++row) {
+        if (m_records[row].status == Pending) {
+            m_records[row].status = NoAck;
+            updateRow(row);
+        }
+    }
+    emit statsChanged();
+}
+
+int CommandTracker::pendingCount() const
+{
+    int n = 0;
+    for (const Record &r : m_records)
+        if (r.status == Pending)
+            ++n;
+    return n;
+}
+
+QVariantList CommandTracker::latencyHistogram() const
+{
+    QVariantList bins;
+    for (int b = 0; b < HISTOGRAM_BINS; ++b) {
+        QVariantMap bin;
+        bin["label"] = QString::fromLatin1(LATENCY_BIN_LABELS[b]);
+        bin["count"] = m_histogram[b];
+        bins << bin;
+    }
+    return bins;
+}
+
+int CommandTracker::binFor(double latencyMs)
+{
+    int b = 0;
+    for (double edge : LATENCY_BIN_EDGES) {
+        if (latencyMs < edge)
+            return b;
+        ++b;
+    }
+    return HISTOGRAM_BINS - 1;
+}
+
+void CommandTracker::updateRow(int row)
+{
+    const QModelIndex idx = index(row);
+    emit dataChanged(idx, idx, { StatusRole, LatencyRole });
+}
@@ -0,0 +1,99 @@
+#ifndef COMMANDTRACKER_H
+#define COMMANDTRACKER_H
+
+#include <QAbstractListModel>
+#include <QList>
+#include <QString>
+#include <QVariantList>
+
+class QTimer;
+
+/**
+ * CommandTracker
+ *
+ * 송신된 명령을 펌웨어 응답(LOG: ...)과 짝지어 왕복 지연을 측정.
+ * 매뉴얼 §1.2 ~ §1.4 응답 예시 기준:
+ *
+ *   R → "Target RPM set to"      S1/S0 → "Wheel START" / "Wheel STOP"
+ *   E → "EMERGENCY STOP"         X     → "Emergency stop RESET"
+ *   A → "Gimbal angle set to"    B1/B0 → "Balancing START" / "Balancing STOP"
+ *   K → "Balancing PID"          WK    → "Wheel PID"
+ *   W → "Washout gain set to"    ?     → "STATUS:"
+ *
+ * 같은 응답 패턴은 FIFO 로 매칭.  ACK_TIMEOUT_MS 안에 응답이 없으면 Timeout.
+ * 최근 명령 목록은 QML ListView 용 모델 (roles: command, status, latencyMs, time).
+ */
+class CommandTracker : public QAbstractListModel
+{
+    Q_OBJECT
+
+    Q_PROPERTY(int          pendingCount     READ pendingCount     NOTIFY statsChanged)
+    Q_PROPERTY(qint64       ackedCount       READ ackedCount       NOTIFY statsChanged)
+    Q_PROPERTY(qint64       timeoutCount     READ timeoutCount     NOTIFY statsChanged)
+    Q_PROPERTY(double       lastLatencyMs    READ lastLatencyMs    NOTIFY statsChanged)
+    Q_PROPERTY(double       maxLatencyMs     READ maxLatencyMs     NOTIFY statsChanged)
+    Q_PROPERTY(QVariantList latencyHistogram READ latencyHistogram NOTIFY statsChanged)
+
+public:
+    enum Status { Pending, Acked, Timeout, NoAck };
+    Q_ENUM(Status)
+
+    enum Roles {
+        CommandRole = Qt::UserRole + 1,
+        StatusRole,
+        LatencyRole,
+        TimeRole,
+    };
+
+    static constexpr int HISTOGRAM_BINS = 8;
+
+    explicit CommandTracker(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = {}) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    // hostMs: 호스트 타임라인 (ms)
+    void commandSent(const QString &cmd, double hostMs);
+    bool lineReceived(const QString &line, double hostMs);   // 응답으로 소비했으면 true
+    void expire(double hostMs);
+    void clear();
+
+    int          pendingCount()  const;
+    qint64       ackedCount()    const { return m_acked; }
+    qint64       timeoutCount()  const { return m_timeouts; }
+    double       lastLatencyMs() const { return m_lastLatencyMs; }
+    double       maxLatencyMs()  const { return m_maxLatencyMs; }
+    QVariantList latencyHistogram() const;
+
+    static QString ackPattern(const QString &cmd);
+
+signals:
+    void statsChanged();
+    void commandAcked(const QString &cmd, double latencyMs);
+    void commandTimedOut(const QString &cmd);
+
+private:
+    struct Record {
+        QString cmd;
+        QString pattern;
+        Status  status = Pending;
+        double  sentMs = 0;
+        double  latencyMs = -1;
+    };
+
+    static int binFor(double latencyMs);
+    void updateRow(int row);
+
+    static constexpr int    MAX_RECORDS    = 50;
+    static constexpr double ACK_TIMEOUT_MS = 1000.0;
+
+    QList<Record> m_records;    // 0 = 가장 오래된 것
+    qint64 m_acked = 0;
+    qint64 m_timeouts = 0;
+    double m_lastLatencyMs = 0;
+    double m_maxLatencyMs = 0;
+    qint64 m_histogram[HISTOGRAM_BINS] = {};
+};
+
+#endif // COMMANDTRACKER_H
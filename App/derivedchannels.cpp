@@ -0,0 +1,457 @@
+#include "derivedchannels.h"
+
+#include <cmath>
+#include <utility>
+
+static const int MAX_REGISTERS = 256;   // Instr 피연산자 quint8
+
+// ═══════════════════════════════════════════════
+// Parser (재귀 하강 → 바이트코드 직접 생성, 상수 접기)
+// ═══════════════════════════════════════════════
+
+class ExpressionProgram::Parser
+{
+public:
+    Parser(ExpressionProgram &prog, const QString &src, const QStringList &inputs)
+        : m_prog(prog), m_src(src), m_inputs(inputs) {}
+
+    // 피연산자: 상수면 아직 레지스터를 쓰지 않는다
+    struct Value {
+        bool  isConst = false;
+        float k = 0;
+        int   reg = -1;
+    };
+
+    bool parse(int *resultReg, QString *error)
+    {
+        Value v = expr();
+        skipSpace();
+        if (m_error.isEmpty() && m_pos < m_src.size())
+            fail("unexpected '" + QString(m_src[m_pos]) + "'");
+        if (m_error.isEmpty())
+            *resultReg = reg(v);
+        if (m_error.isEmpty() && m_prog.m_regCount > MAX_REGISTERS)
+            fail("expression too complex");
+        if (!m_error.isEmpty()) {
+            if (error)
+                *error = m_error;
+            return false;
+        }
+        return true;
+    }
+
+private:
+    Value expr()
+    {
+        Value v = term();
+        for (;;) {
+            if (accept('+'))      v = binary(Add, v, term());
+            else if (accept('-')) v = binary(Sub, v, term());
+            else return v;
+        }
+    }
+
+    Value term()
+    {
+        Value v = unary();
+        for (;;) {
+            if (accept('*'))      v = binary(Mul, v, unary());
+            else if (accept('/')) v = binary(Div, v, unary());
+            else return v;
+        }
+    }
+
+    Value unary()
+    {
+        if (accept('-')) {
+            Value v = unary();
+            if (v.isConst) { v.k = -v.k; return v; }
+            return temp(m_prog.addInstr(Neg, v.reg));
+        }
+        return power();
+    }
+
+    Value power()
+    {
+        Value v = primary();
+        if (accept('^'))
+            v = binary(Pow, v, unary());
+        return v;
+    }
+
+    Value primary()
+    {
+        skipSpace();
+        if (!m_error.isEmpty() || m_pos >= m_src.size()) {
+            fail("unexpected end of expression");
+            return {};
+        }
+
+        const QChar ch = m_src[m_pos];
+        if (ch.isDigit() || ch == '.')
+            return number();
+
+        if (accept('(')) {
+            Value v = expr();
+            expect(')');
+            return v;
+        }
+
+        if (ch.isLetter() || ch == '_') {
+            const QString name = identifier();
+            if (accept('('))
+                return call(name);
+            const int idx = m_inputs.indexOf(name);
+            if (idx < 0) {
+                fail("unknown channel '" + name + "'");
+                return {};
+            }
+            Value v;
+            v.reg = idx;
+            return v;
+        }
+
+        fail("unexpected '" + QString(ch) + "'");
+        return {};
+    }
+
+    Value number()
+    {
+        const int start = m_pos;
+        while (m_pos < m_src.size() && (m_src[m_pos].isDigit() || m_src[m_pos] == '.'))
+            ++m_pos;
+        if (m_pos < m_src.size() && (m_src[m_pos] == 'e' || m_src[m_pos] == 'E')) {
+            ++m_pos;
+            if (m_pos < m_src.size() && (m_src[m_pos] == '+' || m_src[m_pos] == '-'))
+                ++m_pos;
+            while (m_pos < m_src.size() && m_src[m_pos].isDigit())
+                ++m_pos;
+        }
+        bool ok = false;
+        Value v;
+        v.isConst = true;
+        v.k = m_src.mid(start, m_pos - start).toFloat(&ok);
+        if (!ok)
+            fail("bad number '" + m_src.mid(start, m_pos - start) + "'");
+        return v;
+    }
+
+    QString identifier()
+    {
+        const int start = m_pos;
+        while (m_pos < m_src.size() && (m_src[m_pos].isLetterOrNumber() || m_src[m_pos] == '_'))
+            ++m_pos;
+        return m_src.mid(start, m_pos - start);
+    }
+
+    Value call(const QString &name)
+    {
+        QList<Value> args;
+        if (!accept(')')) {
+            do {
+                args.append(expr());
+            } while (m_error.isEmpty() && accept(','));
+            expect(')');
+        }
+        if (!m_error.isEmpty())
+            return {};
+
+        struct Fn { const char *name; Op op; int argc; };
+        static const Fn fns[] = {
+            { "abs", Abs, 1 }, { "sqrt", Sqrt, 1 }, { "sin", Sin, 1 }, { "cos", Cos, 1 },
+            { "min", Min, 2 }, { "max", Max, 2 }, { "atan2", Atan2, 2 }, { "clamp", Clamp, 3 },
+            { "lpf", Lpf, 2 }, { "diff", Diff, 1 },
+        };
+        for (const Fn &fn : fns) {
+            if (name != QLatin1String(fn.name))
+                continue;
+            if (args.size() != fn.argc) {
+                fail(name + "() takes " + QString::number(fn.argc) + " argument(s)");
+                return {};
+            }
+
+            if (fn.op == Lpf) {
+                // 차단주파수는 상수여야 함 → 시정수 τ = 1 / (2π fc) 로 상태 슬롯에 저장
+                if (!args[1].isConst || args[1].k <= 0) {
+                    fail("lpf() cutoff must be a positive constant");
+                    return {};
+                }
+                const int s = m_prog.addState(float(1.0 / (2.0 * M_PI * args[1].k)));
+                return temp(m_prog.addInstr(Lpf, reg(args[0]), 0, s));
+            }
+            if (fn.op == Diff) {
+                const int s = m_prog.addState(0);
+                return temp(m_prog.addInstr(Diff, reg(args[0]), 0, s));
+            }
+
+            // 순수 함수 + 모든 인자가 상수 → 접기
+            bool allConst = true;
+            for (const Value &a : args)
+                allConst = allConst && a.isConst;
+            if (allConst) {
+                Value v;
+                v.isConst = true;
+                v.k = fold(fn.op, args[0].k, argc(args, 1), argc(args, 2));
+                return v;
+            }
+            const int a = reg(args[0]);
+            const int b = args.size() > 1 ? reg(args[1]) : 0;
+            const int c = args.size() > 2 ? reg(args[2]) : 0;
+            return temp(m_prog.addInstr(fn.op, a, b, c));
+        }
+
+        fail("unknown function '" + name + "'");
+        return {};
+    }
+
+    static float argc(const QList<Value> &args, int i) { return i < args.size() ? args[i].k : 0.0f; }
+
+    Value binary(Op op, const Value &a, const Value &b)
+    {
+        if (!m_error.isEmpty())
+            return {};
+        if (a.isConst && b.isConst) {
+            Value v;
+            v.isConst = true;
+            v.k = fold(op, a.k, b.k, 0);
+            return v;
+        }
+        return temp(m_prog.addInstr(op, reg(a), reg(b)));
+    }
+
+    static float fold(Op op, float a, float b, float c)
+    {
+        float r[3] = { a, b, c };
+        Instr in { op, 0, 0, 1, 2, 0 };
+        return ExpressionProgram::execute(in, r, nullptr, 0);
+    }
+
+    int reg(const Value &v)
+    {
+        return v.isConst ? m_prog.addConstant(v.k) : v.reg;
+    }
+
+    static Value temp(int reg)
+    {
+        Value v;
+        v.reg = reg;
+        return v;
+    }
+
+    void skipSpace()
+    {
+        while (m_pos < m_src.size() && m_src[m_pos].isSpace())
+            ++m_pos;
+    }
+
+    bool accept(char c)
+    {
+        skipSpace();
+        if (m_error.isEmpty() && m_pos < m_src.size() && m_src[m_pos] == QLatin1Char(c)) {
+            ++m_pos;
+            return true;
+        }
+        return false;
+    }
+
+    void expect(char c)
+    {
+        if (!accept(c))
+            fail(QString("expected '%1'").arg(QLatin1Char(c)));
+    }
+
+    void fail(const QString &msg)
+    {
+        if (m_error.isEmpty())
+            m_error = QString("col %1: %2").arg(m_pos + 1).arg(msg);
+    }
+
+    ExpressionProgram &m_prog;
+    const QString     &m_src;
+    const QStringList &m_inputs;
+    int                m_pos = 0;
+    QString            m_error;
+};
+
+// ═══════════════════════════════════════════════
+// ExpressionProgram
+// ═══════════════════════════════════════════════
+
+bool ExpressionProgram::compile(const QString &source, const QStringList &inputs, QString *error)
+{
+    ExpressionProgram prog;
+    prog.m_source = source.trimmed();
+    prog.m_inputCount = inputs.size();
+    prog.m_regCount = inputs.size();
+    prog.m_regs.resize(inputs.size());
+
+    int result = 0;
+    Parser parser(prog, prog.m_source, inputs);
+    if (!parser.parse(&result, error))
+        return false;
+
+    prog.m_result = result;
+    prog.m_stateValid.fill(false, prog.m_state.size());
+    *this = prog;
+    return true;
+}
+
+int ExpressionProgram::addInstr(Op op, int a, int b, int c)
+{
+    const int dst = m_regCount++;
+    m_regs.append(0.0f);
+    // state 슬롯은 c 로 전달 (Lpf/Diff 는 c 피연산자를 쓰지 않음)
+    const bool stateful = op == Lpf || op == Diff;
+    m_code.append(Instr { op, quint8(dst), quint8(a), quint8(b),
+                          quint8(stateful ? 0 : c), quint8(stateful ? c : 0) });
+    return dst;
+}
+
+int ExpressionProgram::addConstant(float value)
+{
+    const int r = m_regCount++;
+    m_regs.append(value);
+    return r;
+}
+
+int ExpressionProgram::addState(float param)
+{
+    m_state.append(0.0f);
+    m_stateParam.append(param);
+    return m_state.size() - 1;
+}
+
+void ExpressionProgram::resetState()
+{
+    m_stateValid.fill(false);
+}
+
+float ExpressionProgram::evaluate(const float *inputs, double dt)
+{
+    if (m_code.isEmpty() && m_result >= m_regs.size())
+        return 0.0f;
+
+    float *r = m_regs.data();
+    std::copy(inputs, inputs + m_inputCount, r);
+
+    for (const Instr &in : std::as_const(m_code))
+        r[in.dst] = execute(in, r, this, dt);
+
+    return r[m_result];
+}
+
+float ExpressionProgram::execute(const Instr &in, const float *r, ExpressionProgram *prog, double dt)
+{
+    const float a = r[in.a];
+    switch (in.op) {
+    case Add:   return a + r[in.b];
+    case Sub:   return a - r[in.b];
+    case Mul:   return a * r[in.b];
+    case Div:   return a / r[in.b];
+    case Neg:   return -a;
+    case Pow:   return std::pow(a, r[in.b]);
+    case Abs:   return std::fabs(a);
+    case Sqrt:  return std::sqrt(a);
+    case Sin:   return std::sin(a);
+    case Cos:   return std::cos(a);
+    case Min:   return qMin(a, r[in.b]);
+    case Max:   return qMax(a, r[in.b]);
+    case Atan2: return std::atan2(a, r[in.b]);
+    case Clamp: return qBound(r[in.b], a, r[in.c]);
+
+    case Lpf: {
+        // y += α (x - y),  α = dt / (τ + dt)
+        float &y = prog->m_state[in.state];
+        if (!prog->m_stateValid[in.state]) {
+            prog->m_stateValid[in.state] = true;
+            y = a;
+        } else if (dt > 0) {
+            const float alpha = float(dt / (prog->m_stateParam[in.state] + dt));
+            y += alpha * (a - y);
+        }
+        return y;
+    }
+    case Diff: {
+        // 직전 입력은 m_state, 직전 출력은 m_stateParam 에 보관
+        float &prev = prog->m_state[in.state];
+        float &last = prog->m_stateParam[in.state];
+        if (!prog->m_stateValid[in.state]) {
+            prog->m_stateValid[in.state] = true;
+            last = 0.0f;
+        } else if (dt > 0) {
+            last = float((a - prev) / dt);
+        }
+        prev = a;
+        return last;
+    }
+    }
+    return 0.0f;
+}
+
+// ═══════════════════════════════════════════════
+// DerivedChannels
+// ═══════════════════════════════════════════════
+
+DerivedChannels::DerivedChannels(const QStringList &nativeChannels)
+    : m_native(nativeChannels)
+{
+}
+
+bool DerivedChannels::define(const QString &name, const QString &expression, QString *error)
+{
+    const QString key = name.trimmed();
+    if (key.isEmpty() || !(key[0].isLetter() || key[0] == '_')) {
+        if (error) *error = "invalid channel name";
+        return false;
+    }
+    if (m_native.contains(key)) {
+        if (error) *error = "'" + key + "' is a native channel";
+        return false;
+    }
+
+    // 참조 가능 채널: 네이티브 + 앞서 정의된 파생 채널
+    int slot = indexOf(key);
+    QStringList inputs = m_native;
+    for (int i = 0; i < (slot >= 0 ? slot : m_channels.size()); ++i)
+        inputs << m_channels[i].name;
+
+    ExpressionProgram program;
+    if (!program.compile(expression, inputs, error))
+        return false;
+
+    if (slot >= 0) {
+        m_channels[slot].program = program;
+    } else {
+        m_channels.append(Channel { key, program });
+    }
+    return true;
+}
+
+int DerivedChannels::indexOf(const QString &name) const
+{
+    for (int i = 0; i < m_channels.size(); ++i)
+        if (m_channels[i].name == name)
+            return i;
+    return -1;
+}
+
+QStringList DerivedChannels::names() const
+{
+    QStringList list;
+    for (const Channel &ch : m_channels)
+        list << ch.name;
+    return list;
+}
+
+void DerivedChannels::evaluate(float *values, double dt)
+{
+    const int base = m_native.size();
+    for (int i = 0; i < m_channels.size(); ++i)
+        values[base + i] = m_channels[i].program.evaluate(values, dt);
+}
+
+void DerivedChannels::resetState()
+{
+    for (Channel &ch : m_channels)
+        ch.program.resetState();
+}
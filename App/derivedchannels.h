@@ -0,0 +1,108 @@
+#ifndef DERIVEDCHANNELS_H
+#define DERIVEDCHANNELS_H
+
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+/**
+ * ExpressionProgram
+ *
+ * 텔레메트리 채널 식을 한 번 파싱해 레지스터 기반 바이트코드로 컴파일.
+ * 패킷마다 evaluate() 는 입력 복사 + 명령 수 만큼의 switch 디스패치뿐이라
+ * 식 하나당 수십 ns 수준 (할당 없음).
+ *
+ * 문법:
+ *   expr    := term (('+' | '-') term)*
+ *   term    := unary (('*' | '/') unary)*
+ *   unary   := '-' unary | power
+ *   power   := primary ('^' unary)?
+ *   primary := 숫자 | 채널명 | 함수 '(' 인자, ... ')' | '(' expr ')'
+ *
+ * 함수: abs sqrt sin cos min max atan2 clamp(x, lo, hi)
+ *       lpf(x, 차단주파수Hz)  1차 저역통과 (상태 보존)
+ *       diff(x)              초당 변화율   (상태 보존)
+ * 상수끼리의 연산은 컴파일 시 접어 둔다.
+ */
+class ExpressionProgram
+{
+public:
+    // inputs: 식에서 참조 가능한 채널 이름 (evaluate 의 inputs 배열 순서)
+    bool compile(const QString &source, const QStringList &inputs, QString *error);
+
+    // dt: 직전 샘플과의 간격 (s), 0 이하면 상태 함수는 이전 값 유지
+    float evaluate(const float *inputs, double dt);
+    void  resetState();
+
+    QString source() const { return m_source; }
+
+private:
+    enum Op : quint8 {
+        Add, Sub, Mul, Div, Neg, Pow,
+        Abs, Sqrt, Sin, Cos, Min, Max, Atan2, Clamp,
+        Lpf, Diff,
+    };
+
+    struct Instr {
+        Op     op;
+        quint8 dst, a, b, c;
+        quint8 state;          // Lpf/Diff 상태 슬롯
+    };
+
+    class Parser;
+    friend class Parser;
+
+    static float execute(const Instr &in, const float *r, ExpressionProgram *prog, double dt);
+    int addInstr(Op op, int a, int b = 0, int c = 0);
+    int addConstant(float value);
+    int addState(float param);
+
+    QString        m_source;
+    int            m_inputCount = 0;
+    int            m_regCount = 0;
+    int            m_result = 0;
+    QVector<Instr> m_code;
+    QVector<float> m_regs;         // [입력 | 상수·임시], 상수는 컴파일 시 값이 채워진 채 유지
+    QVector<float> m_state;        // 상태 함수별 직전 값
+    QVector<float> m_stateParam;   // Lpf: 시정수 τ (s)
+    QVector<bool>  m_stateValid;
+};
+
+/**
+ * DerivedChannels
+ *
+ * 이름 = 식 으로 정의한 파생 채널 목록.  네이티브 채널 뒤에 정의 순서대로 놓이며,
+ * 각 식은 네이티브 채널과 앞서 정의된 파생 채널을 참조할 수 있다.
+ *
+ * evaluate(values, dt): values[0 .. nativeCount) 를 읽어
+ * values[nativeCount + i] 에 파생 채널 i 를 채운다 (히스토리/통계/녹화가 그대로 사용).
+ */
+class DerivedChannels
+{
+public:
+    explicit DerivedChannels(const QStringList &nativeChannels);
+
+    // 새 이름이면 추가, 기존 이름이면 식 교체.  실패 시 false + error
+    bool define(const QString &name, const QString &expression, QString *error);
+
+    int         count() const { return m_channels.size(); }
+    int         indexOf(const QString &name) const;
+    QString     name(int i) const { return m_channels[i].name; }
+    QString     expression(int i) const { return m_channels[i].program.source(); }
+    QStringList names() const;
+
+    void evaluate(float *values, double dt);
+    void resetState();
+
+private:
+    struct Channel {
+        QString           name;
+        ExpressionProgram program;
+    };
+
+    QStringList    m_native;
+    QList<Channel> m_channels;
+};
+
+#endif // DERIVEDCHANNELS_H
@@ -0,0 +1,156 @@
+#include "eventtimeline.h"
+#include "telemetryhistory.h"
+
+#include <QPointF>
+#include <QVariantMap>
+#include <QtCharts/QXYSeries>
+
+EventTimeline::EventTimeline(TelemetryHistory *history, int capacity, QObject *parent)
+    : QAbstractListModel(parent)
+    , m_history(history)
+    , m_capacity(qMax(1, capacity))
+    , m_ring(m_capacity)
+{
+}
+
+int EventTimeline::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_count;
+}
+
+QVariant EventTimeline::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_count)
+        return QVariant();
+
+    const FirmwareEvent &ev = at(index.row());
+    switch (role) {
+    case TimeRole:    return ev.hostTime;
+    case KindRole:    return QString::fromLatin1(FirmwareEvent::kindName(ev.kind));
+    case EventRole:   return ev.event;
+    case DetailRole:  return ev.detail;
+    case SummaryRole: return summary(ev);
+    default:          return QVariant();
+    }
+}
+
+QHash<int, QByteArray> EventTimeline::roleNames() const
+{
+    return {
+        { TimeRole,    "time" },
+        { KindRole,    "kind" },
+        { EventRole,   "event" },
+        { DetailRole,  "detail" },
+        { SummaryRole, "summary" },
+    };
+}
+
+void EventTimeline::append(const FirmwareEvent &event)
+{
+    if (m_count == m_capacity) {
+        beginRemoveRows(QModelIndex(), 0, 0);
+        m_head = (m_head + 1) % m_capacity;
+        --m_count;
+        endRemoveRows();
+    }
+
+    beginInsertRows(QModelIndex(), m_count, m_count);
+    m_ring[(m_head + m_count) % m_capacity] = event;
+    ++m_count;
+    endInsertRows();
+
+    emit countChanged();
+    emit eventAppended(QString::fromLatin1(FirmwareEvent::kindName(event.kind)), event.event);
+}
+
+void EventTimeline::clear()
+{
+    beginResetModel();
+    m_head = 0;
+    m_count = 0;
+    endResetModel();
+    emit countChanged();
+}
+
+QVariantList EventTimeline::query(const QString &filter, double fromTime, double toTime) const
+{
+    QVariantList out;
+    for (int i = 0; i < m_count; ++i) {
+        const FirmwareEvent &ev = at(i);
+        if (ev.hostTime < fromTime || ev.hostTime > toTime)
+            continue;
+        if (!filter.isEmpty()
+            && ev.event.compare(filter, Qt::CaseInsensitive) != 0
+            && filter.compare(QLatin1String(FirmwareEvent::kindName(ev.kind)), Qt::CaseInsensitive) != 0
+            && !ev.detail.contains(filter, Qt::CaseInsensitive))
+            continue;
+        out << toMap(ev);
+    }
+    return out;
+}
+
+int EventTimeline::updateMarkerSeries(QAbstractSeries *series, const QString &channel,
+                                      double origin, double fromTime, double toTime) const
+{
+    auto *xySeries = qobject_cast<QXYSeries *>(series);
+    const int c = m_history ? m_history->channelIndex(channel) : -1;
+    if (!xySeries || c < 0)
+        return 0;
+
+    QList<QPointF> points;
+    for (int i = 0; i < m_count; ++i) {
+        const FirmwareEvent &ev = at(i);
+        if (ev.kind != FirmwareEvent::Json || ev.hostTime < fromTime || ev.hostTime > toTime)
+            continue;
+        // 이벤트 시각 이후 첫 샘플 값 (없으면 마지막 샘플)
+        int s = m_history->lowerBound(ev.hostTime);
+        if (s >= m_history->size())
+            s = m_history->size() - 1;
+        if (s < 0)
+            continue;
+        points.append(QPointF(ev.hostTime - origin, m_history->valueAt(c, s)));
+    }
+
+    xySeries->replace(points);
+    return points.size();
+}
+
+static QString numberText(double v)
+{
+    return v == qint64(v) ? QString::number(qint64(v)) : QString::number(v, 'g', 10);
+}
+
+/**
+ * summary()
+ *
+ * 한 줄 요약:  json  → "event: detail  wheel=1 bal=ON RPM=3000 gimbal=10"
+ *             그 외 → detail
+ */
+QString EventTimeline::summary(const FirmwareEvent &ev)
+{
+    if (ev.kind != FirmwareEvent::Json)
+        return ev.detail;
+
+    QString s = (ev.event.isEmpty() ? QString("?") : ev.event) + ": " + ev.detail;
+    if (ev.wheelState >= 0)  s += "  wheel=" + QString::number(ev.wheelState);
+    if (ev.balancing >= 0)   s += ev.balancing ? "  bal=ON" : "  bal=OFF";
+    if (ev.hasTargetRpm)     s += "  RPM=" + numberText(ev.targetRpm);
+    if (ev.hasTargetGimbal)  s += "  gimbal=" + numberText(ev.targetGimbal);
+    return s;
+}
+
+QVariantMap EventTimeline::toMap(const FirmwareEvent &ev)
+{
+    QVariantMap m;
+    m["time"] = ev.hostTime;
+    m["kind"] = QString::fromLatin1(FirmwareEvent::kindName(ev.kind));
+    m["event"] = ev.event;
+    m["detail"] = ev.detail;
+    if (ev.hasT)             m["t"] = ev.t;
+    if (ev.wheelState >= 0)  m["wheelState"] = int(ev.wheelState);
+    if (ev.balancing >= 0)   m["balancing"] = ev.balancing != 0;
+    if (ev.hasTargetRpm)     m["targetRPM"] = ev.targetRpm;
+    if (ev.hasTargetGimbal)  m["targetGimbal"] = ev.targetGimbal;
+    if (ev.hasComm)          m["comm"] = int(ev.comm);
+    return m;
+}
@@ -0,0 +1,68 @@
+#ifndef EVENTTIMELINE_H
+#define EVENTTIMELINE_H
+
+#include <QAbstractListModel>
+#include <QVariantList>
+#include <QVector>
+#include <QtCharts/QAbstractSeries>
+
+#include "firmwareevent.h"
+
+class TelemetryHistory;
+
+/**
+ * EventTimeline
+ *
+ * 펌웨어 이벤트 레코드 링버퍼 (호스트 타임라인 시각 순).
+ *  - 리스트 모델: time, kind, event, detail, summary 역할
+ *  - query(): 이름/종류/본문 필터 + 시간 구간 조회
+ *  - updateMarkerSeries(): JSON 이벤트를 차트 위 마커로 (해당 시각의 채널 값 위치)
+ */
+class EventTimeline : public QAbstractListModel
+{
+    Q_OBJECT
+
+    Q_PROPERTY(int count READ rowCount NOTIFY countChanged)
+
+public:
+    enum Roles {
+        TimeRole = Qt::UserRole + 1,
+        KindRole,
+        EventRole,
+        DetailRole,
+        SummaryRole,
+    };
+
+    EventTimeline(TelemetryHistory *history, int capacity, QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    void append(const FirmwareEvent &event);
+    Q_INVOKABLE void clear();
+
+    const FirmwareEvent &at(int row) const { return m_ring[(m_head + row) % m_capacity]; }
+
+    // filter: 빈 문자열이면 전체.  이벤트 이름/종류 일치 또는 detail 부분 문자열 (대소문자 무시)
+    Q_INVOKABLE QVariantList query(const QString &filter, double fromTime, double toTime) const;
+    // [fromTime, toTime] 의 JSON 이벤트를 x = t - origin, y = channel 값 으로 표시
+    Q_INVOKABLE int updateMarkerSeries(QAbstractSeries *series, const QString &channel,
+                                       double origin, double fromTime, double toTime) const;
+
+    static QString summary(const FirmwareEvent &event);
+    static QVariantMap toMap(const FirmwareEvent &event);
+
+signals:
+    void countChanged();
+    void eventAppended(const QString &kind, const QString &event);
+
+private:
+    TelemetryHistory *m_history;
+    int m_capacity;
+    int m_head = 0;
+    int m_count = 0;
+    QVector<FirmwareEvent> m_ring;
+};
+
+#endif // EVENTTIMELINE_H
@@ -0,0 +1,109 @@
+#include "fft.h"
+
+#include <cmath>
+
+RealFft::RealFft(int n)
+    : m_n(isPowerOfTwo(n) ? n : 256)
+    , m_half(m_n / 2)
+    , m_bitrev(m_half)
+    , m_postRe(m_half)
+    , m_postIm(m_half)
+    , m_re(m_half)
+    , m_im(m_half)
+{
+    // 비트 반전 순서
+    int bits = 0;
+    while ((1 << bits) < m_half)
+        ++bits;
+    for (int i = 0; i < m_half; ++i) {
+        int r = 0;
+        for (int b = 0; b < bits; ++b)
+            if (i & (1 << b))
+                r |= 1 << (bits - 1 - b);
+        m_bitrev[i] = r;
+    }
+
+    // 단별 트위들: 단 크기 2h 에서 w_j = exp(-2πi j / 2h), j < h
+    for (int h = 1; h < m_half; h *= 2) {
+        for (int j = 0; j < h; ++j) {
+            const double a = -M_PI * j / h;
+            m_twRe.append(float(std::cos(a)));
+            m_twIm.append(float(std::sin(a)));
+        }
+    }
+
+    for (int k = 0; k < m_half; ++k) {
+        const double a = -2.0 * M_PI * k / m_n;
+        m_postRe[k] = float(std::cos(a));
+        m_postIm[k] = float(std::sin(a));
+    }
+}
+
+/**
+ * complexFft()
+ *
+ * m_re/m_im (비트 반전 순서로 채워진 상태) 를 제자리 변환.
+ */
+void RealFft::complexFft()
+{
+    float *re = m_re.data();
+    float *im = m_im.data();
+    const float *twRe = m_twRe.constData();
+    const float *twIm = m_twIm.constData();
+
+    for (int h = 1; h < m_half; h *= 2) {
+        for (int k = 0; k < m_half; k += 2 * h) {
+            float *aRe = re + k, *aIm = im + k;
+            float *bRe = aRe + h, *bIm = aIm + h;
+            // 내부 루프: 연속 접근, 분기 없음 → 벡터화
+            for (int j = 0; j < h; ++j) {
+                const float tRe = bRe[j] * twRe[j] - bIm[j] * twIm[j];
+                const float tIm = bRe[j] * twIm[j] + bIm[j] * twRe[j];
+                bRe[j] = aRe[j] - tRe;
+                bIm[j] = aIm[j] - tIm;
+                aRe[j] += tRe;
+                aIm[j] += tIm;
+            }
+        }
+        twRe += h;
+        twIm += h;
+    }
+}
+
+/**
+ * powerSpectrum()
+ *
+ * z[m] = x[2m] + i·x[2m+1] 로 묶어 N/2 점 FFT 후 분리:
+ *   E[k] = (Z[k] + conj(Z[N/2-k])) / 2
+ *   O[k] = (Z[k] - conj(Z[N/2-k])) / 2i
+ *   X[k] = E[k] + W^k · O[k],   W = exp(-2πi/N)
+ */
+void RealFft::powerSpectrum(const float *in, float *power)
+{
+    for (int m = 0; m < m_half; ++m) {
+        const int r = m_bitrev[m];
+        m_re[r] = in[2 * m];
+        m_im[r] = in[2 * m + 1];
+    }
+
+    complexFft();
+
+    // k = 0 과 k = N/2 (DC, 나이퀴스트)
+    const float dc  = m_re[0] + m_im[0];
+    const float nyq = m_re[0] - m_im[0];
+    power[0] = dc * dc;
+    power[m_half] = nyq * nyq;
+
+    for (int k = 1; k < m_half; ++k) {
+        const float zRe = m_re[k],          zIm = m_im[k];
+        const float cRe = m_re[m_half - k], cIm = -m_im[m_half - k];   // conj(Z[N/2-k])
+
+        const float eRe = 0.5f * (zRe + cRe), eIm = 0.5f * (zIm + cIm);
+        // (Z - conj) / 2i = (dIm, -dRe) / 2
+        const float oRe = 0.5f * (zIm - cIm), oIm = -0.5f * (zRe - cRe);
+
+        const float xRe = eRe + m_postRe[k] * oRe - m_postIm[k] * oIm;
+        const float xIm = eIm + m_postRe[k] * oIm + m_postIm[k] * oRe;
+        power[k] = xRe * xRe + xIm * xIm;
+    }
+}
@@ -0,0 +1,44 @@
+#ifndef FFT_H
+#define FFT_H
+
+#include <QVector>
+
+/**
+ * RealFft
+ *
+ * 실수 입력 FFT (N = 2의 거듭제곱, 외부 라이브러리 없음).
+ * N/2 점 복소 FFT 한 번 + 후처리(real unpack) 로 N 점 실수 스펙트럼을 얻는다.
+ *
+ *  - 복소 FFT: 반복형 radix-2 DIT, 실수부/허수부 분리 배열(SoA)
+ *  - 단별 트위들을 연속 배열로 미리 계산 → 버터플라이 내부 루프가
+ *    분기 없는 연속 접근이라 컴파일러 자동 벡터화(SSE/AVX/NEON) 대상
+ *  - 작업 버퍼는 생성 시 한 번만 할당 (호출마다 할당 없음)
+ *
+ * 한 인스턴스는 스레드 하나에서만 사용 (내부 작업 버퍼 공유).
+ */
+class RealFft
+{
+public:
+    explicit RealFft(int n = 256);
+
+    int size() const { return m_n; }
+    int bins() const { return m_n / 2 + 1; }
+
+    // in: N 개 실수 → power: N/2+1 개 |X_k|²
+    void powerSpectrum(const float *in, float *power);
+
+    static bool isPowerOfTwo(int n) { return n >= 4 && (n & (n - 1)) == 0; }
+
+private:
+    void complexFft();
+
+    int m_n;
+    int m_half;
+
+    QVector<int>   m_bitrev;            // N/2 점 비트 반전 순서
+    QVector<float> m_twRe, m_twIm;      // 단별 트위들 (단 h: h 개, 연속 배치)
+    QVector<float> m_postRe, m_postIm;  // real unpack 트위들 exp(-2πik/N)
+    QVector<float> m_re, m_im;          // 작업 버퍼 (N/2)
+};
+
+#endif // FFT_H
@@ -0,0 +1,322 @@
+#include "firmwareevent.h"
+
+#include <charconv>
+#include <cstring>
+
+const char *FirmwareEvent::kindName(Kind kind)
+{
+    switch (kind) {
+    case Log:    return "log";
+    case Status: return "status";
+    case Json:   return "json";
+    default:     return "text";
+    }
+}
+
+// ═══════════════════════════════════════════════
+// JSON 토크나이저 (입력 버퍼 뷰, 할당 없음)
+// ═══════════════════════════════════════════════
+
+namespace {
+
+struct Token {
+    enum Type : quint8 { Invalid, Object, Array, String, Number, True, False, Null };
+    Type        type = Invalid;
+    const char *begin = nullptr;   // String: 따옴표 안쪽, 그 외: 토큰 전체
+    int         size = 0;
+    bool        escaped = false;   // String 에 '\' 포함 (디코드 필요)
+
+    bool is(const char *literal) const
+    {
+        const int n = int(std::strlen(literal));
+        return type == String && !escaped && size == n && std::memcmp(begin, literal, n) == 0;
+    }
+};
+
+class JsonScanner
+{
+public:
+    JsonScanner(const char *begin, const char *end) : m_p(begin), m_end(end) {}
+
+    bool atEnd() { skipSpace(); return m_p >= m_end; }
+
+    // 값 하나 읽기 (객체/배열은 범위만 잡고 건너뜀)
+    bool value(Token *tok)
+    {
+        skipSpace();
+        if (m_p >= m_end)
+            return false;
+
+        const char c = *m_p;
+        if (c == '"')
+            return string(tok);
+        if (c == '{' || c == '[')
+            return container(tok);
+        if (c == '-' || (c >= '0' && c <= '9'))
+            return number(tok);
+        if (literal("true"))  { *tok = Token { Token::True,  m_p - 4, 4 }; return true; }
+        if (literal("false")) { *tok = Token { Token::False, m_p - 5, 5 }; return true; }
+        if (literal("null"))  { *tok = Token { Token::Null,  m_p - 4, 4 }; return true; }
+        return false;
+    }
+
+    // 객체 멤버 순회: fn(key, value) — 키/값은 버퍼 뷰
+    template <typename Fn>
+    bool members(Fn fn)
+    {
+        if (!expect('{'))
+            return false;
+        if (accept('}'))
+            return true;
+        for (;;) {
+            Token key, val;
+            skipSpace();
+            if (m_p >= m_end || *m_p != '"' || !string(&key))
+                return false;
+            if (!expect(':') || !value(&val))
+                return false;
+            fn(key, val);
+            if (accept(','))
+                continue;
+            return expect('}');
+        }
+    }
+
+private:
+    void skipSpace()
+    {
+        while (m_p < m_end && (*m_p == ' ' || *m_p == '\t' || *m_p == '\r' || *m_p == '\n'))
+            ++m_p;
+    }
+
+    bool accept(char c)
+    {
+        skipSpace();
+        if (m_p < m_end && *m_p == c) {
+            ++m_p;
+            return true;
+        }
+        return false;
+    }
+
+    bool expect(char c) { return accept(c); }
+
+    bool literal(const char *word)
+    {
+        const int n = int(std::strlen(word));
+        if (m_end - m_p >= n && std::memcmp(m_p, word, n) == 0) {
+            m_p += n;
+            return true;
+        }
+        return false;
+    }
+
+    bool string(Token *tok)
+    {
+        const char *start = ++m_p;   // 여는 따옴표 다음
+        bool escaped = false;
+        while (m_p < m_end && *m_p != '"') {
+            if (*m_p == '\\') {
+                escaped = true;
+                ++m_p;
+            }
+            ++m_p;
+        }
+        if (m_p >= m_end)
+            return false;
+        *tok = Token { Token::String, start, int(m_p - start), escaped };
+        ++m_p;   // 닫는 따옴표
+        return true;
+    }
+
+    bool number(Token *tok)
+    {
+        const char *start = m_p;
+        while (m_p < m_end && ((*m_p >= '0' && *m_p <= '9') || (*m_p != '\0' && std::strchr("+-.eE", *m_p))))
+            ++m_p;
+        *tok = Token { Token::Number, start, int(m_p - start) };
+        return true;
+    }
+
+    // 중첩 깊이만 세며 건너뜀 (문자열 안의 괄호는 무시)
+    bool container(Token *tok)
+    {
+        const char *start = m_p;
+        int depth = 0;
+        while (m_p < m_end) {
+            const char c = *m_p++;
+            if (c == '"') {
+                while (m_p < m_end && *m_p != '"') {
+                    if (*m_p == '\\')
+                        ++m_p;
+                    ++m_p;
+                }
+                ++m_p;
+            } else if (c == '{' || c == '[') {
+                ++depth;
+            } else if (c == '}' || c == ']') {
+                if (--depth == 0) {
+                    *tok = Token { *start == '{' ? Token::Object : Token::Array, start, int(m_p - start) };
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    const char *m_p;
+    const char *m_end;
+};
+
+// 로캘 무관 (strtod 는 소수점 쉼표 로캘에서 "1.5" → 1)
+double parseNumber(const Token &tok)
+{
+    const char *begin = tok.begin;
+    const char *end = tok.begin + tok.size;
+    if (begin < end && *begin == '+')   // from_chars 는 '+' 부호를 받지 않음
+        ++begin;
+    double value = 0;
+    std::from_chars(begin, end, value);
+    return value;
+}
+
+double toNumber(const Token &tok)
+{
+    switch (tok.type) {
+    case Token::Number: return parseNumber(tok);
+    case Token::True:   return 1;
+    default:            return 0;
+    }
+}
+
+bool truthy(const Token &tok)
+{
+    switch (tok.type) {
+    case Token::True:   return true;
+    case Token::Number: return parseNumber(tok) != 0;
+    case Token::String: return tok.size > 0;
+    case Token::Object:
+    case Token::Array:  return true;
+    default:            return false;
+    }
+}
+
+// 문자열 토큰 → QString (이스케이프가 있을 때만 디코드)
+QString toText(const Token &tok)
+{
+    if (tok.type == Token::Number)
+        return QString::fromLatin1(tok.begin, tok.size);
+    if (tok.type != Token::String)
+        return QString();
+    if (!tok.escaped)
+        return QString::fromUtf8(tok.begin, tok.size);
+
+    QByteArray out;
+    out.reserve(tok.size);
+    for (int i = 0; i < tok.size; ++i) {
+        char c = tok.begin[i];
+        if (c != '\\' || i + 1 >= tok.size) {
+            out.append(c);
+            continue;
+        }
+        c = tok.begin[++i];
+        switch (c) {
+        case 'n': out.append('\n'); break;
+        case 't': out.append('\t'); break;
+        case 'r': out.append('\r'); break;
+        case 'b': out.append('\b'); break;
+        case 'f': out.append('\f'); break;
+        case 'u':
+            if (i + 4 < tok.size) {
+                const char16_t code = char16_t(QByteArray(tok.begin + i + 1, 4).toUShort(nullptr, 16));
+                out.append(QString(QChar(code)).toUtf8());
+                i += 4;
+            }
+            break;
+        default:  out.append(c); break;   // \" \\ \/
+        }
+    }
+    return QString::fromUtf8(out);
+}
+
+} // namespace
+
+// ═══════════════════════════════════════════════
+// FirmwareEventParser
+// ═══════════════════════════════════════════════
+
+bool FirmwareEventParser::parseJson(const char *begin, const char *end, FirmwareEvent *ev)
+{
+    JsonScanner scanner(begin, end);
+    FirmwareEvent out = *ev;
+
+    bool nestedOk = true;
+    const bool ok = scanner.members([&](const Token &key, const Token &val) {
+        if (key.is("t") && val.type == Token::Number) {
+            out.hasT = true;
+            out.t = toNumber(val);
+        } else if (key.is("event")) {
+            out.event = toText(val);
+        } else if (key.is("detail")) {
+            out.detail = toText(val);
+        } else if (key.is("wheelState")) {
+            out.wheelState = qint8(toNumber(val));
+        } else if (key.is("balancing")) {
+            out.balancing = truthy(val) ? 1 : 0;
+        } else if (key.is("targetRPM")) {
+            out.hasTargetRpm = true;
+            out.targetRpm = toNumber(val);
+        } else if (key.is("targetGimbal")) {
+            out.hasTargetGimbal = true;
+            out.targetGimbal = toNumber(val);
+        } else if (key.is("comm") && val.type == Token::Object) {
+            out.hasComm = true;
+            out.comm = 0;
+            JsonScanner nested(val.begin, val.begin + val.size);
+            nestedOk = nested.members([&](const Token &k, const Token &v) {
+                if (!truthy(v))
+                    return;
+                if (k.is("angleSensor"))      out.comm |= FirmwareEvent::AngleSensor;
+                else if (k.is("rpmSensor1"))  out.comm |= FirmwareEvent::RpmSensor1;
+                else if (k.is("rpmSensor2"))  out.comm |= FirmwareEvent::RpmSensor2;
+                else if (k.is("wheelMotor"))  out.comm |= FirmwareEvent::WheelMotor;
+                else if (k.is("gimbalMotor")) out.comm |= FirmwareEvent::GimbalMotor;
+                else if (k.is("mainLoop"))    out.comm |= FirmwareEvent::MainLoop;
+            });
+        }
+    });
+
+    if (!ok || !nestedOk || !scanner.atEnd())
+        return false;
+    out.kind = FirmwareEvent::Json;
+    *ev = out;
+    return true;
+}
+
+FirmwareEvent FirmwareEventParser::parse(const QByteArray &line)
+{
+    FirmwareEvent ev;
+    const char *begin = line.constData();
+    const char *end = begin + line.size();
+
+    // JSON 이벤트 (접두어 허용)
+    const char *brace = static_cast<const char *>(std::memchr(begin, '{', line.size()));
+    if (brace) {
+        FirmwareEvent json;
+        if (parseJson(brace, end, &json)) {
+            json.prefix = QString::fromUtf8(begin, int(brace - begin)).trimmed();
+            return json;
+        }
+    }
+
+    if (line.startsWith("STATUS:")) {
+        ev.kind = FirmwareEvent::Status;
+        ev.detail = QString::fromUtf8(begin + 7, line.size() - 7).trimmed();
+    } else if (line.startsWith("LOG:")) {
+        ev.kind = FirmwareEvent::Log;
+        ev.detail = QString::fromUtf8(begin + 4, line.size() - 4).trimmed();
+    } else {
+        ev.detail = QString::fromUtf8(line);
+    }
+    return ev;
+}
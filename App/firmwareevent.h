@@ -0,0 +1,69 @@
+#ifndef FIRMWAREEVENT_H
+#define FIRMWAREEVENT_H
+
+#include <QByteArray>
+#include <QString>
+#include <QtGlobal>
+
+/**
+ * FirmwareEvent
+ *
+ * 펌웨어 ASCII 라인 하나를 타입이 있는 레코드로 변환한 결과.
+ *
+ *   JSON   : {"t":..,"event":..,"detail":..,"wheelState":..,"balancing":..,
+ *             "targetRPM":..,"targetGimbal":..,"comm":{..}}   (앞에 접두어가 붙을 수 있음)
+ *   STATUS : "STATUS:" 이후 텍스트 → detail
+ *   LOG    : "LOG:" 이후 텍스트    → detail
+ *   TEXT   : 그 외
+ *
+ * 없는 필드는 has* 플래그 false (또는 -1).
+ */
+struct FirmwareEvent
+{
+    enum Kind : quint8 { Text, Log, Status, Json };
+
+    // comm{} 비트 (텔레메트리 commBits 와 같은 순서)
+    enum CommBit : quint8 {
+        AngleSensor = 0x01, RpmSensor1 = 0x02, RpmSensor2 = 0x04,
+        WheelMotor  = 0x08, GimbalMotor = 0x10, MainLoop  = 0x20,
+    };
+
+    Kind    kind = Text;
+    double  hostTime = 0;       // 호스트 타임라인 (s) — 파서 밖에서 채움
+    QString prefix;             // JSON 앞 접두어 (예: "LOG:")
+    QString event;
+    QString detail;
+
+    bool    hasT = false;
+    double  t = 0;              // 펌웨어 시각 (ms)
+    qint8   wheelState = -1;
+    qint8   balancing = -1;     // -1: 없음, 0/1
+    bool    hasTargetRpm = false;
+    double  targetRpm = 0;
+    bool    hasTargetGimbal = false;
+    double  targetGimbal = 0;
+    bool    hasComm = false;
+    quint8  comm = 0;           // CommBit 조합
+
+    static const char *kindName(Kind kind);
+};
+
+/**
+ * FirmwareEventParser
+ *
+ * 할당 없는 JSON 토크나이저로 알려진 작은 스키마만 읽는다.
+ *  - 토큰은 입력 버퍼 위의 (시작, 길이) 뷰, 중첩 객체/배열은 건너뛰기만 함
+ *  - 키 비교는 memcmp, 숫자는 strtod (QByteArray 는 항상 NUL 종료)
+ *  - QString 은 남길 필드(event/detail/prefix)에 대해서만 생성
+ * JSON 문법 오류면 false → 호출자는 TEXT/LOG 로 취급.
+ */
+class FirmwareEventParser
+{
+public:
+    static FirmwareEvent parse(const QByteArray &line);
+
+    // JSON 객체 부분만 파싱 (begin..end, '{' 로 시작).  성공 시 true
+    static bool parseJson(const char *begin, const char *end, FirmwareEvent *ev);
+};
+
+#endif // FIRMWAREEVENT_H
@@ -0,0 +1,62 @@
+#include "gaptracker.h"
+
+#include <cmath>
+
+void GapTracker::reset()
+{
+    m_hasLast = false;
+    m_lastMcuMs = 0;
+    m_received = 0;
+    m_lost = 0;
+    m_gapCount = 0;
+    m_longestGapMs = 0;
+    m_quality = 1.0;
+    for (qint64 &bin : m_histogram)
+        bin = 0;
+}
+
+void GapTracker::setNominalPeriodMs(double periodMs)
+{
+    if (periodMs > 0)
+        m_periodMs = periodMs;
+}
+
+int GapTracker::addTimestamp(qint64 mcuMs)
+{
+    int missed = 0;
+
+    if (m_hasLast) {
+        const qint64 delta = mcuMs - m_lastMcuMs;
+        if (delta >= qRound64(m_periodMs * 1.5)) {
+            missed = qMax(1, qRound(delta / m_periodMs) - 1);
+            m_lost += missed;
+            ++m_gapCount;
+            ++m_histogram[binFor(missed)];
+            m_longestGapMs = qMax(m_longestGapMs, delta);
+            // 손실 슬롯만큼 품질 감쇠: q *= (1-α)^missed
+            m_quality *= std::pow(1.0 - m_alpha, missed);
+        }
+    }
+
+    m_quality += m_alpha * (1.0 - m_quality);
+    ++m_received;
+    m_hasLast = true;
+    m_lastMcuMs = mcuMs;
+    return missed;
+}
+
+int GapTracker::binFor(int missed)
+{
+    if (missed <= 1)  return 0;
+    if (missed == 2)  return 1;
+    if (missed <= 4)  return 2;
+    if (missed <= 9)  return 3;
+    if (missed <= 99) return 4;
+    return 5;
+}
+
+const char *GapTracker::histogramLabel(int bin)
+{
+    static const char *labels[HISTOGRAM_BINS] = { "1", "2", "3-4", "5-9", "10-99", "100+" };
+    return (bin >= 0 && bin < HISTOGRAM_BINS) ? labels[bin] : "";
+}
@@ -0,0 +1,57 @@
+#ifndef GAPTRACKER_H
+#define GAPTRACKER_H
+
+#include <QtGlobal>
+
+/**
+ * GapTracker
+ *
+ * 텔레메트리 timestamp 델타로 패킷 손실(갭)을 검출.
+ * 입력은 ClockSync 가 wraparound 보정한 64비트 MCU 시각(ms).
+ * 주기는 LinkWatchdog 가 학습한 값을 패킷마다 setNominalPeriodMs() 로 받음.
+ *
+ *  - 델타 ≈ 주기            → 정상
+ *  - 델타 ≥ 1.5 × 주기      → round(델타 / 주기) - 1 개 손실
+ *  - 링크 품질(%)           → 기대 슬롯 단위 EWMA (약 1초 창)
+ *  - 히스토그램 (손실 개수) → 1 | 2 | 3-4 | 5-9 | 10-99 | 100+
+ */
+class GapTracker
+{
+public:
+    static constexpr int HISTOGRAM_BINS = 6;
+
+    void reset();
+    void setNominalPeriodMs(double periodMs);
+    double nominalPeriodMs() const { return m_periodMs; }
+
+    // 패킷 1개 반영, 반환값: 직전 패킷과의 사이에서 손실된 패킷 수
+    int addTimestamp(qint64 mcuMs);
+
+    qint64 received()     const { return m_received; }
+    qint64 expected()     const { return m_received + m_lost; }
+    qint64 lost()         const { return m_lost; }
+    qint64 gapCount()     const { return m_gapCount; }
+    qint64 longestGapMs() const { return m_longestGapMs; }
+    double linkQuality()  const { return m_quality * 100.0; }   // %
+    qint64 histogramBin(int bin) const { return m_histogram[bin]; }
+
+    static const char *histogramLabel(int bin);
+
+private:
+    static int binFor(int missed);
+
+    double m_periodMs = 10.0;       // 학습 전 기본값 (config.h TELEMETRY_CYCLE_MS)
+    double m_alpha    = 0.01;       // 기대 슬롯 100개 ≈ 1초
+
+    bool   m_hasLast = false;
+    qint64 m_lastMcuMs = 0;
+
+    qint64 m_received = 0;
+    qint64 m_lost = 0;
+    qint64 m_gapCount = 0;
+    qint64 m_longestGapMs = 0;
+    double m_quality = 1.0;
+    qint64 m_histogram[HISTOGRAM_BINS] = {};
+};
+
+#endif // GAPTRACKER_H
@@ -0,0 +1,143 @@
+#include "linkwatchdog.h"
+
+#include <algorithm>
+#include <cmath>
+
+static const double DEFAULT_PERIOD_MS = 10.0;   // config.h TELEMETRY_CYCLE_MS
+static const double PERIOD_ALPHA      = 0.05;
+static const double MIN_DEADLINE_MS   = 20.0;
+static const double MAX_DEADLINE_MS   = 250.0;
+
+void LinkWatchdog::open(double hostMs)
+{
+    *this = LinkWatchdog();
+    m_state = Waiting;
+    m_openMs = hostMs;
+}
+
+void LinkWatchdog::close()
+{
+    m_state = Closed;
+}
+
+void LinkWatchdog::bytesReceived(double hostMs)
+{
+    m_lastBytesMs = hostMs;
+}
+
+void LinkWatchdog::checksumFailed(double hostMs)
+{
+    m_lastFailMs = hostMs;
+    m_failsSincePacket++;
+    m_goodStreak = 0;
+}
+
+void LinkWatchdog::packetReceived(double hostMs, qint64 mcuMs)
+{
+    // 주기: 손실(≥ 1.5 주기)이나 MCU 재동기로 튄 델타는 학습에서 제외.
+    // 단, 대역 밖 델타가 RESEED_DELTAS 개 연속이면 손실이 아니라 MCU 주기 변경
+    // → 그 델타들의 중앙값으로 다시 시작 (안 그러면 데드라인이 옛 주기에 묶여 영구 Degraded)
+    if (m_lastMcuMs >= 0 && mcuMs > m_lastMcuMs) {
+        const double delta = double(mcuMs - m_lastMcuMs);
+        if (m_periodMs <= 0) {
+            m_periodMs = delta;
+        } else if (delta < 1.5 * m_periodMs) {
+            m_periodMs += PERIOD_ALPHA * (delta - m_periodMs);
+            m_outOfBandCount = 0;
+        } else {
+            m_outOfBand[m_outOfBandCount++] = delta;
+            if (m_outOfBandCount == RESEED_DELTAS) {
+                std::nth_element(m_outOfBand, m_outOfBand + RESEED_DELTAS / 2, m_outOfBand + RESEED_DELTAS);
+                m_periodMs = m_outOfBand[RESEED_DELTAS / 2];
+                m_outOfBandCount = 0;
+            }
+        }
+    }
+    m_lastMcuMs = mcuMs;
+
+    // 도착 지터: 한 번의 readyRead 에 여러 패킷이 오면 간격 0 → 편차에 반영됨
+    if (m_lastPacketMs >= 0) {
+        const double gap = hostMs - m_lastPacketMs;
+        if (!m_hasArrival) {
+            m_arrivalMean = gap;
+            m_arrivalDev = gap / 2;
+            m_hasArrival = true;
+        } else if (gap < MAX_DEADLINE_MS) {
+            m_arrivalDev += 0.25 * (std::fabs(gap - m_arrivalMean) - m_arrivalDev);
+            m_arrivalMean += 0.125 * (gap - m_arrivalMean);
+        }
+    }
+
+    const bool onTime = m_lastPacketMs >= 0 && hostMs - m_lastPacketMs <= deadlineMs();
+    m_goodStreak = onTime ? m_goodStreak + 1 : 1;
+    m_lastPacketMs = hostMs;
+    m_failsSincePacket = 0;
+}
+
+double LinkWatchdog::deadlineMs() const
+{
+    const double period = m_periodMs > 0 ? m_periodMs : DEFAULT_PERIOD_MS;
+    double deadline = 3.0 * period;
+    if (m_hasArrival)
+        deadline = qMax(deadline, m_arrivalMean + 4.0 * m_arrivalDev);
+    return qBound(MIN_DEADLINE_MS, deadline, MAX_DEADLINE_MS);
+}
+
+double LinkWatchdog::silenceMs(double hostMs) const
+{
+    return hostMs - (m_lastPacketMs >= 0 ? m_lastPacketMs : m_openMs);
+}
+
+LinkWatchdog::State LinkWatchdog::classify(double hostMs) const
+{
+    if (m_state == Closed)
+        return Closed;
+
+    const double bytesRef = m_lastBytesMs >= 0 ? m_lastBytesMs : m_openMs;
+    const bool   bytesQuiet = hostMs - bytesRef > SILENT_MS;
+    const bool   failing = m_failsSincePacket > 0 && hostMs - m_lastFailMs <= SILENT_MS;
+
+    // 첫 패킷 전: 한동안은 대기, 이후 원인 구분
+    if (m_lastPacketMs < 0) {
+        if (failing)
+            return Corrupt;
+        if (hostMs - m_openMs < WAIT_SILENT_MS)
+            return Waiting;
+        return bytesQuiet ? Silent : Corrupt;
+    }
+
+    if (hostMs - m_lastPacketMs <= deadlineMs()) {
+        // 회복 중에는 연속 정상 패킷이 쌓일 때까지 이전 상태 유지
+        if (m_state == Healthy || m_state == Waiting || m_goodStreak >= RECOVER_PACKETS)
+            return Healthy;
+        return m_state;
+    }
+
+    if (failing)
+        return Corrupt;
+    if (bytesQuiet)
+        return Silent;
+    return Degraded;
+}
+
+bool LinkWatchdog::update(double hostMs)
+{
+    const State next = classify(hostMs);
+    if (next == m_state)
+        return false;
+    m_state = next;
+    return true;
+}
+
+const char *LinkWatchdog::stateName(State state)
+{
+    switch (state) {
+    case Closed:   return "closed";
+    case Waiting:  return "waiting";
+    case Healthy:  return "healthy";
+    case Degraded: return "degraded";
+    case Silent:   return "silent";
+    case Corrupt:  return "corrupt";
+    }
+    return "?";
+}
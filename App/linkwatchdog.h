@@ -0,0 +1,75 @@
+#ifndef LINKWATCHDOG_H
+#define LINKWATCHDOG_H
+
+#include <QtGlobal>
+
+/**
+ * LinkWatchdog
+ *
+ * 수신 주기를 학습해 링크 상태를 판정 (고정 3초 타임아웃 대체).
+ *
+ *  - 주기      : MCU timestamp 델타의 EWMA (손실로 벌어진 델타는 제외,
+ *                단 RESEED_DELTAS 개 연속이면 주기 변경으로 보고 그 중앙값으로 재시작)
+ *  - 도착 지터 : 호스트 도착 간격의 평균/편차 EWMA (RFC 6298 RTO 방식)
+ *  - 데드라인  : max(3 × 주기, 평균 + 4 × 편차), 20 ~ 250 ms 로 제한
+ *                → 10 ms 주기면 보통 30 ~ 50 ms 안에 저하 판정
+ *
+ * 상태 (마지막 유효 패킷 이후 경과 시간 기준):
+ *  Waiting  : 포트 열림, 아직 유효 패킷 없음
+ *  Healthy  : 데드라인 안에 유효 패킷 도착 중
+ *  Degraded : 데드라인 초과 (몇 주기 누락)
+ *  Silent   : 바이트 자체가 SILENT_MS 이상 없음 (포트는 열렸지만 MCU 무응답)
+ *  Corrupt  : 바이트는 오는데 체크섬 실패만 있음 (보레이트/배선/노이즈)
+ *
+ * 회복: Healthy 복귀는 데드라인 안의 유효 패킷 RECOVER_PACKETS 개 연속 (깜빡임 방지).
+ */
+class LinkWatchdog
+{
+public:
+    enum State : quint8 { Closed, Waiting, Healthy, Degraded, Silent, Corrupt };
+
+    static constexpr double SILENT_MS       = 250.0;    // 바이트 무수신 → Silent
+    static constexpr double WAIT_SILENT_MS  = 3000.0;   // 연결 직후 첫 패킷 대기 한도
+    static constexpr int    RECOVER_PACKETS = 3;
+    static constexpr int    RESEED_DELTAS   = 8;        // 연속 대역 밖 델타 → 주기 재학습
+
+    void open(double hostMs);
+    void close();
+
+    void bytesReceived(double hostMs);
+    void packetReceived(double hostMs, qint64 mcuMs);
+    void checksumFailed(double hostMs);
+
+    // 주기 타이머에서 호출.  반환값: 상태가 바뀌었으면 true
+    bool update(double hostMs);
+
+    State  state() const { return m_state; }
+    double periodMs() const { return m_periodMs; }
+    double deadlineMs() const;
+    double silenceMs(double hostMs) const;      // 마지막 유효 패킷 (없으면 open) 이후
+    qint64 failsSincePacket() const { return m_failsSincePacket; }
+
+    static const char *stateName(State state);
+
+private:
+    State classify(double hostMs) const;
+
+    State  m_state = Closed;
+    double m_openMs = 0;
+    double m_lastPacketMs = -1;
+    double m_lastBytesMs = -1;
+    double m_lastFailMs = -1;
+    qint64 m_failsSincePacket = 0;
+    int    m_goodStreak = 0;
+
+    // 주기 학습
+    qint64 m_lastMcuMs = -1;
+    double m_periodMs = 0;          // 0 = 아직 모름 (기본 10 ms 가정)
+    double m_outOfBand[RESEED_DELTAS] = {};
+    int    m_outOfBandCount = 0;
+    double m_arrivalMean = 0;
+    double m_arrivalDev = 0;
+    bool   m_hasArrival = false;
+};
+
+#endif // LINKWATCHDOG_H
@@ -0,0 +1,320 @@
+#include "logfilemodel.h"
+
+#include <QDebug>
+#include <algorithm>
+#include <cstring>
+
+using namespace SessionLogFormat;
+
+// 본문 줄 머리 "yyyy-MM-dd hh:mm:ss.zzz CAT  " 에서 카테고리 태그 위치
+static const int TAG_OFFSET = 24;
+
+LogFileModel::LogFileModel(QObject *parent)
+    : QAbstractListModel(parent)
+{
+}
+
+LogFileModel::~LogFileModel()
+{
+    unmapFiles();
+}
+
+int LogFileModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid())
+        return 0;
+    return m_filtered ? m_rows.size() : totalCount();
+}
+
+QVariant LogFileModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= rowCount())
+        return QVariant();
+
+    const Entry &e = entry(m_filtered ? m_rows[index.row()] : index.row());
+    switch (role) {
+    case LineRole:
+        // 보이는 줄만 디코드 (매핑된 페이지는 OS 가 필요할 때 읽음)
+        return QString::fromUtf8(reinterpret_cast<const char *>(m_logData + e.offset), e.length);
+    case TimeRole:     return e.timeMs / 1000.0;
+    case CategoryRole: return int(e.category);
+    default:           return QVariant();
+    }
+}
+
+QHash<int, QByteArray> LogFileModel::roleNames() const
+{
+    return {
+        { LineRole,     "line" },
+        { TimeRole,     "time" },
+        { CategoryRole, "category" },
+    };
+}
+
+bool LogFileModel::open(const QString &logPath)
+{
+    beginResetModel();
+    unmapFiles();
+    m_filtered = false;
+    m_rows.clear();
+
+    const QString base = logPath.endsWith(".log") ? logPath.left(logPath.size() - 4) : logPath;
+    m_log.setFileName(base + ".log");
+    m_index.setFileName(base + ".idx");
+    m_bloom.setFileName(base + ".blm");
+    const bool ok = mapFiles();
+    endResetModel();
+
+    emit opened();
+    emit countChanged();
+    return ok;
+}
+
+void LogFileModel::close()
+{
+    beginResetModel();
+    unmapFiles();
+    m_log.setFileName(QString());
+    m_filtered = false;
+    m_rows.clear();
+    endResetModel();
+    emit opened();
+    emit countChanged();
+}
+
+bool LogFileModel::reload()
+{
+    if (m_log.fileName().isEmpty())
+        return false;
+    // 필터는 풀림 (행 번호가 바뀔 수 있음)
+    return open(m_log.fileName());
+}
+
+bool LogFileModel::mapFiles()
+{
+    if (!m_log.open(QIODevice::ReadOnly)) {
+        qWarning() << "LogFileModel: Failed to open" << m_log.fileName();
+        return false;
+    }
+    m_logSize = m_log.size();
+    if (m_logSize > 0) {
+        m_logData = m_log.map(0, m_logSize);
+        if (!m_logData) {
+            qWarning() << "LogFileModel: Failed to map" << m_log.fileName();
+            m_log.close();
+            m_logSize = 0;
+            return false;
+        }
+    }
+
+    // 인덱스: 헤더 확인 후 완전한 엔트리만 사용
+    if (m_index.open(QIODevice::ReadOnly)) {
+        const qint64 size = m_index.size();
+        if (size >= qint64(sizeof(IndexHeader))) {
+            const uchar *p = m_index.map(0, size);
+            const auto *header = reinterpret_cast<const IndexHeader *>(p);
+            if (p && std::memcmp(header->magic, INDEX_MAGIC, sizeof(header->magic)) == 0
+                && header->version == VERSION
+                && header->blockLines == BLOCK_LINES && header->bloomBytes == BLOOM_BYTES) {
+                m_entries = reinterpret_cast<const Entry *>(p + sizeof(IndexHeader));
+                m_indexed = int((size - qint64(sizeof(IndexHeader))) / qint64(sizeof(Entry)));
+                // 인덱스가 본문보다 앞서 flush 된 경우 잘라냄
+                while (m_indexed > 0 && qint64(m_entries[m_indexed - 1].offset) + m_entries[m_indexed - 1].length > m_logSize)
+                    --m_indexed;
+            }
+        }
+        if (!m_entries)
+            m_index.close();
+    }
+
+    if (m_entries && m_bloom.open(QIODevice::ReadOnly)) {
+        const qint64 size = m_bloom.size();
+        m_blockCount = int(size / BLOOM_BYTES);
+        if (m_blockCount > 0)
+            m_blocks = m_bloom.map(0, qint64(m_blockCount) * BLOOM_BYTES);
+        if (!m_blocks) {
+            m_blockCount = 0;
+            m_bloom.close();
+        }
+    }
+
+    scanTail();
+    return true;
+}
+
+void LogFileModel::unmapFiles()
+{
+    if (m_logData)
+        m_log.unmap(const_cast<uchar *>(m_logData));
+    if (m_entries)
+        m_index.unmap(const_cast<uchar *>(reinterpret_cast<const uchar *>(m_entries)) - sizeof(IndexHeader));
+    if (m_blocks)
+        m_bloom.unmap(const_cast<uchar *>(m_blocks));
+    m_log.close();
+    m_index.close();
+    m_bloom.close();
+
+    m_logData = nullptr;
+    m_logSize = 0;
+    m_entries = nullptr;
+    m_indexed = 0;
+    m_blocks = nullptr;
+    m_blockCount = 0;
+    m_tail.clear();
+}
+
+/**
+ * scanTail()
+ *
+ * 인덱스 끝 이후 본문을 개행 단위로 스캔해 메모리 엔트리 생성.
+ * 정상 종료된 파일은 스캔할 것이 없고, 인덱스가 없으면 파일 전체가 대상.
+ * 시각은 마지막 인덱스 시각을 이어 씀 (카테고리는 줄 머리 태그로 복원).
+ */
+void LogFileModel::scanTail()
+{
+    qint64 pos = 0;
+    quint32 timeMs = 0;
+    if (m_indexed > 0) {
+        const Entry &last = m_entries[m_indexed - 1];
+        pos = qint64(last.offset) + last.length + 1;
+        timeMs = last.timeMs;
+    }
+
+    while (pos < m_logSize) {
+        const void *nl = std::memchr(m_logData + pos, '\n', size_t(m_logSize - pos));
+        const qint64 end = nl ? static_cast<const uchar *>(nl) - m_logData : m_logSize;
+
+        Entry e;
+        e.offset = quint64(pos);
+        e.timeMs = timeMs;
+        e.length = quint16(qMin<qint64>(end - pos, MAX_LINE_BYTES));
+        e.category = 0xFF;
+        e.reserved = 0;
+        if (end - pos > TAG_OFFSET + 3) {
+            const char *tag = reinterpret_cast<const char *>(m_logData + pos + TAG_OFFSET);
+            for (int c = 0; c < 4; ++c) {
+                if (std::memcmp(tag, SessionLog::categoryTag(c), 3) == 0) {
+                    e.category = quint8(c);
+                    break;
+                }
+            }
+        }
+        m_tail.append(e);
+        pos = end + 1;
+    }
+}
+
+// ═══════════════════════════════════════════════
+// 필터 검색
+// ═══════════════════════════════════════════════
+
+bool LogFileModel::blockMayContain(int block, const QVector<int> &bits) const
+{
+    const uchar *b = m_blocks + qint64(block) * BLOOM_BYTES;
+    for (int bit : bits) {
+        if (!(b[bit >> 3] & (1u << (bit & 7))))
+            return false;
+    }
+    return true;
+}
+
+// ASCII 대소문자 무시 부분 문자열 검사 (needle 은 소문자)
+bool LogFileModel::lineContains(const Entry &e, const QByteArray &needle) const
+{
+    const uchar *line = m_logData + e.offset;
+    const int n = needle.size();
+    const uchar first = uchar(needle[0]);
+    for (int i = 0; i + n <= int(e.length); ++i) {
+        uchar c = line[i];
+        if (c >= 'A' && c <= 'Z') c += 32;
+        if (c != first)
+            continue;
+        int k = 1;
+        for (; k < n; ++k) {
+            uchar d = line[i + k];
+            if (d >= 'A' && d <= 'Z') d += 32;
+            if (d != uchar(needle[k]))
+                break;
+        }
+        if (k == n)
+            return true;
+    }
+    return false;
+}
+
+/**
+ * filter()
+ *
+ *  1) 시간 구간 → 인덱스 timeMs 이분 탐색으로 [first, last) 줄 범위
+ *  2) 블록 단위 순회: 텍스트 트라이그램 비트가 하나라도 빠진 블록은 통째로 건너뜀
+ *  3) 남은 줄만 카테고리 바이트 → 본문 비교
+ * 결과 줄 번호를 모델 행으로 사용.  반환값: 일치 줄 수
+ */
+int LogFileModel::filter(const QString &text, int categoryMask, double fromTime, double toTime)
+{
+    const QByteArray needle = text.toUtf8().toLower();
+    const int total = totalCount();
+
+    // 1) 시간 구간 (timeMs 는 기록 순서대로 증가)
+    auto timeOf = [this](int line) { return entry(line).timeMs; };
+    int first = 0, last = total;
+    if (fromTime >= 0) {
+        const quint32 t = quint32(fromTime * 1000.0);
+        int lo = 0, hi = total;
+        while (lo < hi) { const int mid = (lo + hi) / 2; if (timeOf(mid) < t) lo = mid + 1; else hi = mid; }
+        first = lo;
+    }
+    if (toTime >= 0) {
+        const quint32 t = quint32(toTime * 1000.0);
+        int lo = first, hi = total;
+        while (lo < hi) { const int mid = (lo + hi) / 2; if (timeOf(mid) <= t) lo = mid + 1; else hi = mid; }
+        last = lo;
+    }
+
+    // 2) 블룸 조회 비트 (3자 미만이면 블록 건너뛰기 없음)
+    QVector<int> bits;
+    const uchar *q = reinterpret_cast<const uchar *>(needle.constData());
+    for (int i = 0; i + 2 < needle.size(); ++i) {
+        int b[2];
+        trigramBits(q[i], q[i + 1], q[i + 2], b);
+        bits << b[0] << b[1];
+    }
+
+    QVector<int> rows;
+    int line = first;
+    while (line < last) {
+        const int block = line / BLOCK_LINES;
+        const int blockEnd = qMin(last, (block + 1) * BLOCK_LINES);
+        if (!bits.isEmpty() && block < m_blockCount && blockEnd <= m_indexed
+            && !blockMayContain(block, bits)) {
+            line = blockEnd;
+            continue;
+        }
+        for (; line < blockEnd; ++line) {
+            const Entry &e = entry(line);
+            if (categoryMask && (e.category >= 32 || !(categoryMask & (1 << e.category))))
+                continue;
+            if (!needle.isEmpty() && !lineContains(e, needle))
+                continue;
+            rows.append(line);
+        }
+    }
+
+    beginResetModel();
+    m_rows = rows;
+    m_filtered = true;
+    endResetModel();
+    emit countChanged();
+    return m_rows.size();
+}
+
+void LogFileModel::clearFilter()
+{
+    if (!m_filtered)
+        return;
+    beginResetModel();
+    m_filtered = false;
+    m_rows.clear();
+    endResetModel();
+    emit countChanged();
+}
@@ -0,0 +1,87 @@
+#ifndef LOGFILEMODEL_H
+#define LOGFILEMODEL_H
+
+#include <QAbstractListModel>
+#include <QFile>
+#include <QVector>
+
+#include "sessionlog.h"
+
+/**
+ * LogFileModel
+ *
+ * SessionLog 파일 뷰어.  .log/.idx/.blm 을 메모리 매핑하고
+ * data() 에서 보이는 줄만 그때그때 디코드 → 수백 MB 로그도 즉시 열림.
+ *  - 인덱스가 없거나 짧으면 (비정상 종료) 나머지 구간만 개행 스캔으로 보충
+ *  - filter(): 시간 구간은 인덱스 이분 탐색, 카테고리는 인덱스 바이트,
+ *              텍스트(3자 이상)는 블룸 블록으로 후보 블록만 본문 확인
+ *  - 기록 중인 파일은 reload() 로 늘어난 부분 반영
+ */
+class LogFileModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+    Q_PROPERTY(QString path       READ path       NOTIFY opened)
+    Q_PROPERTY(int     count      READ rowCount   NOTIFY countChanged)
+    Q_PROPERTY(int     totalCount READ totalCount NOTIFY countChanged)
+    Q_PROPERTY(bool    filtered   READ filtered   NOTIFY countChanged)
+
+public:
+    enum Roles {
+        LineRole = Qt::UserRole + 1,
+        TimeRole,           // 파일 시작 기준 (s)
+        CategoryRole,
+    };
+
+    explicit LogFileModel(QObject *parent = nullptr);
+    ~LogFileModel() override;
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    QString path() const { return m_log.fileName(); }
+    int     totalCount() const { return m_indexed + m_tail.size(); }
+    bool    filtered() const { return m_filtered; }
+
+    Q_INVOKABLE bool open(const QString &logPath);
+    Q_INVOKABLE void close();
+    Q_INVOKABLE bool reload();
+
+    // categoryMask: (1 << LogRouter::Category) 조합, 0 = 전체.  fromTime/toTime < 0 = 제한 없음
+    Q_INVOKABLE int  filter(const QString &text, int categoryMask, double fromTime, double toTime);
+    Q_INVOKABLE void clearFilter();
+
+signals:
+    void opened();
+    void countChanged();
+
+private:
+    using Entry = SessionLogFormat::IndexEntry;
+
+    const Entry &entry(int line) const
+    {
+        return line < m_indexed ? m_entries[line] : m_tail[line - m_indexed];
+    }
+    bool mapFiles();
+    void unmapFiles();
+    void scanTail();
+    bool blockMayContain(int block, const QVector<int> &bits) const;
+    bool lineContains(const Entry &e, const QByteArray &needle) const;
+
+    QFile m_log;
+    QFile m_index;
+    QFile m_bloom;
+    const uchar *m_logData = nullptr;
+    qint64       m_logSize = 0;
+    const Entry *m_entries = nullptr;    // .idx 매핑 (헤더 다음)
+    int          m_indexed = 0;
+    const uchar *m_blocks = nullptr;     // .blm 매핑
+    int          m_blockCount = 0;
+    QVector<Entry> m_tail;               // 인덱스에 없는 끝부분 (스캔으로 생성)
+
+    bool         m_filtered = false;
+    QVector<int> m_rows;                 // 필터 결과 (줄 번호)
+};
+
+#endif // LOGFILEMODEL_H
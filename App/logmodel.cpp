@@ -0,0 +1,222 @@
+#include "logmodel.h"
+#include "firmwareevent.h"
+
+#include <QTimer>
+#include <cmath>
+
+// ═══════════════════════════════════════════════
+// LogModel
+// ═══════════════════════════════════════════════
+
+LogModel::LogModel(int capacity, QObject *parent)
+    : QAbstractListModel(parent)
+    , m_capacity(qMax(1, capacity))
+    , m_ring(m_capacity)
+{
+}
+
+int LogModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_count;
+}
+
+QVariant LogModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_count || role != Qt::DisplayRole)
+        return QVariant();
+    return at(index.row());
+}
+
+QHash<int, QByteArray> LogModel::roleNames() const
+{
+    return { { Qt::DisplayRole, "line" } };
+}
+
+void LogModel::appendBatch(const QStringList &lines)
+{
+    if (lines.isEmpty())
+        return;
+
+    // 배치가 용량 이상 → 마지막 capacity 줄로 통째 교체
+    if (lines.size() >= m_capacity) {
+        beginResetModel();
+        m_head = 0;
+        m_count = m_capacity;
+        const int first = lines.size() - m_capacity;
+        for (int i = 0; i < m_capacity; ++i)
+            m_ring[i] = lines[first + i];
+        endResetModel();
+        emit batchAppended();
+        return;
+    }
+
+    // 넘치는 만큼 앞에서 제거 (링 head 이동만)
+    const int overflow = m_count + lines.size() - m_capacity;
+    if (overflow > 0) {
+        beginRemoveRows(QModelIndex(), 0, overflow - 1);
+        m_head = (m_head + overflow) % m_capacity;
+        m_count -= overflow;
+        endRemoveRows();
+    }
+
+    beginInsertRows(QModelIndex(), m_count, m_count + lines.size() - 1);
+    for (const QString &line : lines) {
+        m_ring[(m_head + m_count) % m_capacity] = line;
+        ++m_count;
+    }
+    endInsertRows();
+    emit batchAppended();
+}
+
+void LogModel::clear()
+{
+    beginResetModel();
+    m_head = 0;
+    m_count = 0;
+    endResetModel();
+    emit batchAppended();
+}
+
+// ═══════════════════════════════════════════════
+// LogRouter
+// ═══════════════════════════════════════════════
+
+LogRouter::LogRouter(QObject *parent)
+    : QObject(parent)
+    , m_flushTimer(new QTimer(this))
+{
+    for (LogModel *&model : m_models)
+        model = new LogModel(CAPACITY, this);
+
+    m_flushTimer->setInterval(FLUSH_INTERVAL_MS);
+    m_flushTimer->setSingleShot(true);
+    connect(m_flushTimer, &QTimer::timeout, this, &LogRouter::flush);
+}
+
+void LogRouter::setTimeOrigin(double origin)
+{
+    if (m_timeOrigin == origin)
+        return;
+    m_timeOrigin = origin;
+    emit timeOriginChanged();
+}
+
+void LogRouter::ingest(const QString &message)
+{
+    // JSON 이벤트는 한 번만 파싱해 분류와 포맷에 같이 사용
+    FirmwareEvent json;
+    bool hasJson = false;
+    const int brace = message.indexOf('{');
+    if (brace >= 0 && !message.startsWith("PKT #")) {
+        const QByteArray utf8 = message.mid(brace).toUtf8();
+        hasJson = FirmwareEventParser::parseJson(utf8.constData(), utf8.constData() + utf8.size(), &json);
+    }
+
+    const FirmwareEvent *ev = hasJson ? &json : nullptr;
+    const Category category = classify(message, ev);
+    emit routed(category, message);
+    enqueue(category, category == Pkt ? message : format(message, ev));
+}
+
+void LogRouter::ingestCommand(const QString &command, double hostTimeSec)
+{
+    // 휠 명령(R/S/E/X) → RPM 칼럼, 나머지(K/B/W/A...) → PID 칼럼
+    const QChar c = command.isEmpty() ? QChar() : command[0];
+    const Category category = (c == 'R' || c == 'S' || c == 'E' || c == 'X') ? RpmTx : PidTx;
+    const QString stamp = QString("[%1] ").arg(hostTimeSec - m_timeOrigin, 0, 'f', 2);
+    emit routed(category, "TX: " + command);
+    enqueue(category, stamp + "TX: " + command);
+}
+
+void LogRouter::enqueue(Category category, const QString &line)
+{
+    m_pending[category].append(line);
+    if (!m_flushTimer->isActive())
+        m_flushTimer->start();
+}
+
+void LogRouter::flush()
+{
+    for (int c = 0; c < CategoryCount; ++c) {
+        if (m_pending[c].isEmpty())
+            continue;
+        m_models[c]->appendBatch(m_pending[c]);
+        m_pending[c].clear();
+    }
+}
+
+/**
+ * classify()
+ *
+ *  PKT #...                         → PKT
+ *  JSON detail 에 CMD:R / RPM        → RPM TX 칼럼 (펌웨어 응답)
+ *  JSON detail 에 CMD:K/B/W, BALANCING, PID → PID TX 칼럼
+ *  나머지 (RX bytes, CHECKSUM FAIL, ASCII 등) → RX
+ */
+LogRouter::Category LogRouter::classify(const QString &message, const FirmwareEvent *json)
+{
+    if (message.startsWith("PKT #"))
+        return Pkt;
+
+    if (json) {
+        const QString d = json->detail.toUpper();
+        if (d.contains("CMD:R") || d.contains("RPM"))
+            return RpmTx;
+        if (d.contains("CMD:K") || d.contains("CMD:B") || d.contains("CMD:W")
+            || d.contains("BALANCING") || d.contains("PID"))
+            return PidTx;
+    }
+    return Rx;
+}
+
+// JS 와 같은 표기 (정수면 소수점 없이)
+static QString numberText(double d)
+{
+    if (d == std::floor(d) && std::fabs(d) < 1e15)
+        return QString::number(qint64(d));
+    return QString::number(d, 'g', 15);
+}
+
+/**
+ * format()
+ *
+ * JSON 이벤트:  [t] event: detail
+ *                 wheel=.. bal=.. RPM=.. gimbal=..
+ *                 comm: angle !rpm1 ...   (comm/init 이벤트만)
+ * JSON 이 아니면 원본 그대로.
+ */
+QString LogRouter::format(const QString &message, const FirmwareEvent *json)
+{
+    if (!json)
+        return message;
+
+    const FirmwareEvent &ev = *json;
+    const QString prefix = message.left(message.indexOf('{')).trimmed();
+
+    QString lines = "[" + (ev.hasT ? numberText(ev.t) : QString("?")) + "] "
+                    + (ev.event.isEmpty() ? QString("?") : ev.event) + ": " + ev.detail;
+
+    // 주요 상태
+    QStringList state;
+    if (ev.wheelState >= 0)  state << "wheel=" + QString::number(ev.wheelState);
+    if (ev.balancing >= 0)   state << QString("bal=") + (ev.balancing ? "ON" : "OFF");
+    if (ev.hasTargetRpm)     state << "RPM=" + numberText(ev.targetRpm);
+    if (ev.hasTargetGimbal)  state << "gimbal=" + numberText(ev.targetGimbal);
+    if (!state.isEmpty())
+        lines += "\n  " + state.join("  ");
+
+    // 통신 상태 (변경 이벤트일 때만)
+    if ((ev.event == "comm" || ev.event == "init") && ev.hasComm) {
+        static const struct { quint8 bit; const char *name; } sensors[] = {
+            { FirmwareEvent::AngleSensor, "angle" }, { FirmwareEvent::RpmSensor1, "rpm1" },
+            { FirmwareEvent::RpmSensor2, "rpm2" },   { FirmwareEvent::WheelMotor, "wheel" },
+            { FirmwareEvent::GimbalMotor, "gimbal" }, { FirmwareEvent::MainLoop, "main" },
+        };
+        QStringList list;
+        for (const auto &s : sensors)
+            list << ((ev.comm & s.bit) ? QString(s.name) : "!" + QString(s.name));
+        lines += "\n  comm: " + list.join(" ");
+    }
+
+    return prefix.isEmpty() ? lines : prefix + "\n" + lines;
+}
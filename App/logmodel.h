@@ -0,0 +1,110 @@
+#ifndef LOGMODEL_H
+#define LOGMODEL_H
+
+#include <QAbstractListModel>
+#include <QHash>
+#include <QStringList>
+#include <QVector>
+
+struct FirmwareEvent;
+class QTimer;
+
+/**
+ * LogModel
+ *
+ * 고정 용량 링버퍼 로그 모델.  가득 차면 앞쪽 행을 제거하고 뒤에 추가하지만
+ * 저장소는 링이라 문자열 이동이 없다.  행은 appendBatch() 로 묶어서 추가
+ * (begin/endRemoveRows + begin/endInsertRows 한 쌍씩).
+ *
+ * 역할: "line" (포맷된 로그 한 줄, 여러 줄일 수 있음)
+ */
+class LogModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+    Q_PROPERTY(int count READ rowCount NOTIFY batchAppended)
+
+public:
+    explicit LogModel(int capacity, QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    void appendBatch(const QStringList &lines);
+    Q_INVOKABLE void clear();
+
+signals:
+    void batchAppended();
+
+private:
+    const QString &at(int row) const { return m_ring[(m_head + row) % m_capacity]; }
+
+    int m_capacity;
+    int m_head = 0;
+    int m_count = 0;
+    QVector<QString> m_ring;
+};
+
+/**
+ * LogRouter
+ *
+ * logReceived / commandSent 메시지를 분류·포맷해 4개 로그 모델(RPM TX, PID TX, RX, PKT)에
+ * 넣는다.  분류/포맷은 수신 스레드(C++)에서 한 번만 수행 (JSON 도 1회 파싱),
+ * 모델 반영은 FLUSH_INTERVAL_MS 마다 카테고리별 일괄 추가 → 로그 폭주 중에도
+ * 모델 시그널은 초당 최대 20회.
+ */
+class LogRouter : public QObject
+{
+    Q_OBJECT
+
+    Q_PROPERTY(LogModel *rpmTx READ rpmTx CONSTANT)
+    Q_PROPERTY(LogModel *pidTx READ pidTx CONSTANT)
+    Q_PROPERTY(LogModel *rx    READ rx    CONSTANT)
+    Q_PROPERTY(LogModel *pkt   READ pkt   CONSTANT)
+    // TX 로그 시각 기준 (차트 t=0 에 해당하는 호스트 타임라인 시각, s)
+    Q_PROPERTY(double timeOrigin READ timeOrigin WRITE setTimeOrigin NOTIFY timeOriginChanged)
+
+public:
+    enum Category { RpmTx, PidTx, Rx, Pkt, CategoryCount };
+
+    explicit LogRouter(QObject *parent = nullptr);
+
+    LogModel *rpmTx() const { return m_models[RpmTx]; }
+    LogModel *pidTx() const { return m_models[PidTx]; }
+    LogModel *rx()    const { return m_models[Rx]; }
+    LogModel *pkt()   const { return m_models[Pkt]; }
+
+    double timeOrigin() const { return m_timeOrigin; }
+    void   setTimeOrigin(double origin);
+
+    // 수신/상태 메시지 (logReceived)
+    void ingest(const QString &message);
+    // 실제 송신된 명령 (hostTimeSec: 호스트 타임라인 시각)
+    void ingestCommand(const QString &command, double hostTimeSec);
+
+    // 분류/포맷 (테스트·재사용용 정적 함수)
+    static Category classify(const QString &message, const FirmwareEvent *json);
+    static QString  format(const QString &message, const FirmwareEvent *json);
+
+signals:
+    void timeOriginChanged();
+    // 분류된 원본 메시지 (포맷 전) — 세션 로그 파일 기록용
+    void routed(int category, const QString &message);
+
+private slots:
+    void flush();
+
+private:
+    static constexpr int CAPACITY = 100;
+    static constexpr int FLUSH_INTERVAL_MS = 50;
+
+    void enqueue(Category category, const QString &line);
+
+    LogModel   *m_models[CategoryCount];
+    QStringList m_pending[CategoryCount];
+    QTimer     *m_flushTimer;
+    double      m_timeOrigin = 0;
+};
+
+#endif // LOGMODEL_H
@@ -0,0 +1,211 @@
+#include "portopener.h"
+#include "serialreader.h"
+
+#include <QTimer>
+
+#if defined(Q_OS_LINUX)
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+// ═══════════════════════════════════════════════
+// PortOpenWorker (I/O 스레드)
+// ═══════════════════════════════════════════════
+
+#if defined(Q_OS_LINUX)
+
+static QString errorText(int err)
+{
+    return QString::fromLocal8Bit(std::strerror(err));
+}
+
+// 표준 보레이트 상수, 없으면 0 (비표준 값은 QSerialPort::open() 이 설정)
+static speed_t speedConstant(int baudRate)
+{
+    switch (baudRate) {
+    case 9600:    return B9600;
+    case 19200:   return B19200;
+    case 38400:   return B38400;
+    case 57600:   return B57600;
+    case 115200:  return B115200;
+    case 230400:  return B230400;
+    case 460800:  return B460800;
+    case 500000:  return B500000;
+    case 921600:  return B921600;
+    case 1000000: return B1000000;
+    case 1500000: return B1500000;
+    case 2000000: return B2000000;
+    default:      return 0;
+    }
+}
+
+// QSerialPort::open() 이 Data8/NoParity/OneStop/NoFlowControl 로 설정하는 것과 같은 raw termios
+static QString configure(int fd, int baudRate)
+{
+    termios tio;
+    if (::tcgetattr(fd, &tio) < 0)
+        return errorText(errno);
+    ::cfmakeraw(&tio);
+    tio.c_cflag |= CLOCAL | CREAD;
+    tio.c_cflag &= ~(CSTOPB | PARENB | CRTSCTS);
+    tio.c_iflag &= ~(IXON | IXOFF | IXANY);
+    tio.c_cc[VMIN] = 0;
+    tio.c_cc[VTIME] = 0;
+    if (const speed_t speed = speedConstant(baudRate))
+        ::cfsetspeed(&tio, speed);
+    if (::tcsetattr(fd, TCSANOW, &tio) < 0)
+        return errorText(errno);
+    return QString();
+}
+
+void PortOpenWorker::open(quint64 request, const QString &portName, int baudRate, bool lowLatency)
+{
+    // 멈춘 open 뒤에 쌓였다가 이미 취소/대체된 요청
+    if (request != m_latest->load())
+        return;
+
+    PortOpenResult result;
+    result.request = request;
+    result.portName = portName;
+    result.baudRate = baudRate;
+    result.lowLatency = lowLatency;
+
+    const QString path = SerialReader::systemLocation(portName);
+    const int fd = ::open(path.toLocal8Bit().constData(), O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) {
+        result.error = errorText(errno);
+        emit opened(result);
+        return;
+    }
+    result.error = configure(fd, baudRate);
+    if (!result.ok()) {
+        ::close(fd);
+        emit opened(result);
+        return;
+    }
+
+    result.fd = fd;
+    if (lowLatency)
+        result.tuning = SerialTuning::applyDevice(fd, portName, &result.saved);
+    emit opened(result);
+}
+
+void PortOpenWorker::release(const PortOpenResult &result)
+{
+    if (result.fd < 0)
+        return;
+    SerialTuning::PortSaved saved = result.saved;
+    SerialTuning::restore(result.fd, -1, &saved);
+    ::close(result.fd);
+}
+
+#else
+
+void PortOpenWorker::open(quint64 request, const QString &portName, int baudRate, bool lowLatency)
+{
+    if (request != m_latest->load())
+        return;
+
+    PortOpenResult result;
+    result.request = request;
+    result.portName = portName;
+    result.baudRate = baudRate;
+    result.lowLatency = lowLatency;
+    if (lowLatency)
+        result.tuning = SerialTuning::applyDevice(-1, portName, &result.saved);
+    emit opened(result);
+}
+
+void PortOpenWorker::release(const PortOpenResult &result)
+{
+    Q_UNUSED(result);
+}
+
+#endif
+
+// ═══════════════════════════════════════════════
+// PortOpener
+// ═══════════════════════════════════════════════
+
+PortOpener::PortOpener(QObject *parent)
+    : QObject(parent)
+    , m_worker(new PortOpenWorker(&m_request))
+    , m_timeoutTimer(new QTimer(this))
+{
+    qRegisterMetaType<PortOpenResult>();
+
+    m_thread.setObjectName("PortOpener");
+    m_worker->moveToThread(&m_thread);
+    connect(&m_thread, &QThread::finished, m_worker, &QObject::deleteLater);
+    connect(this, &PortOpener::requestOpen, m_worker, &PortOpenWorker::open);
+    connect(this, &PortOpener::requestRelease, m_worker, &PortOpenWorker::release);
+    connect(m_worker, &PortOpenWorker::opened, this, &PortOpener::onOpened);
+    m_thread.start();
+
+    m_timeoutTimer->setSingleShot(true);
+    m_timeoutTimer->setInterval(OPEN_TIMEOUT_MS);
+    connect(m_timeoutTimer, &QTimer::timeout, this, &PortOpener::onTimeout);
+}
+
+PortOpener::~PortOpener()
+{
+    cancel();
+    // 멈춘 open 이 있으면 돌아올 때까지 기다림 (종료 시에만)
+    m_thread.quit();
+    m_thread.wait();
+}
+
+void PortOpener::open(const QString &portName, int baudRate, bool lowLatency)
+{
+    m_portName = portName;
+    m_baudRate = baudRate;
+    m_lowLatency = lowLatency;
+    m_pending = true;
+    m_timeoutTimer->start();
+    emit requestOpen(++m_request, portName, baudRate, lowLatency);
+}
+
+void PortOpener::cancel()
+{
+    if (!m_pending)
+        return;
+    // 번호를 넘겨 두면 늦게 도착한 결과는 onOpened 에서 release
+    ++m_request;
+    m_pending = false;
+    m_timeoutTimer->stop();
+}
+
+void PortOpener::release(const PortOpenResult &result)
+{
+    if (result.fd >= 0)
+        emit requestRelease(result);
+}
+
+void PortOpener::onOpened(const PortOpenResult &result)
+{
+    if (!m_pending || result.request != m_request.load()) {
+        release(result);
+        return;
+    }
+    m_pending = false;
+    m_timeoutTimer->stop();
+    emit finished(result);
+}
+
+// 워커는 아직 open(2) 안에 있음 — 실패로 보고하고, 나중에 돌아오면 onOpened 에서 release
+void PortOpener::onTimeout()
+{
+    if (!m_pending)
+        return;
+    PortOpenResult result;
+    result.request = m_request.load();
+    result.portName = m_portName;
+    result.baudRate = m_baudRate;
+    result.lowLatency = m_lowLatency;
+    result.error = QString("open timed out (%1 ms)").arg(OPEN_TIMEOUT_MS);
+    cancel();
+    emit finished(result);
+}
@@ -0,0 +1,112 @@
+#ifndef PORTOPENER_H
+#define PORTOPENER_H
+
+#include <QMetaType>
+#include <QObject>
+#include <QString>
+#include <QThread>
+#include <QVariantMap>
+#include <atomic>
+
+#include "serialtuning.h"
+
+class QTimer;
+
+/**
+ * PortOpenResult
+ *
+ * I/O 스레드의 장치 열기 결과.  fd 는 받는 쪽 소유 — 쓰지 않으면 PortOpener::release().
+ */
+struct PortOpenResult
+{
+    quint64 request = 0;
+    QString portName;
+    int     baudRate = 0;
+    bool    lowLatency = false;     // 요청 당시 저지연 모드 (장치 설정 적용 여부)
+    int     fd = -1;                // 열린 장치 (-1 = 실패, 또는 미리 열기를 지원하지 않는 플랫폼)
+    QString error;                  // 비어 있으면 성공
+    QVariantMap tuning;             // lowLatency: SerialTuning::applyDevice 결과
+    SerialTuning::PortSaved saved;  // lowLatency: 적용 전 장치 설정
+
+    bool ok() const { return error.isEmpty(); }
+};
+Q_DECLARE_METATYPE(PortOpenResult)
+
+/**
+ * PortOpenWorker
+ *
+ * 장치 open(2) + termios (raw, 보레이트, 8N1) + 저지연 장치 설정.
+ * USB-serial 드라이버는 첫 open 에서 포트 활성화(제어 전송, DTR/RTS)를, 보레이트 변경과
+ * latency_timer 쓰기에서도 제어 전송을 하므로 응답 없는 장치면 수 초까지 막힘
+ * → 전용 I/O 스레드에서.  장치의 마지막 close 와 설정 복원(release)도 같은 이유로 여기서.
+ * 멈춘 open 뒤에 쌓인 요청 중 이미 지난 것(latest 와 번호가 다름)은 열지 않고 건너뜀.
+ */
+class PortOpenWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit PortOpenWorker(const std::atomic<quint64> *latest) : m_latest(latest) {}
+
+public slots:
+    void open(quint64 request, const QString &portName, int baudRate, bool lowLatency);
+    void release(const PortOpenResult &result);
+
+signals:
+    void opened(const PortOpenResult &result);
+
+private:
+    const std::atomic<quint64> *m_latest;
+};
+
+/**
+ * PortOpener
+ *
+ * 비동기 포트 열기.  open() 은 바로 반환하고 결과는 finished() (GUI 스레드, 큐잉).
+ *
+ * 성공하면 장치는 이미 활성화되고 QSerialPort 와 같은 termios 로 설정된 fd 를 쥔 상태 —
+ * 이어지는 QSerialPort::open() 은 열린 tty 의 재열기라 드라이버 활성화가 없고
+ * termios 도 바뀌지 않아 (드라이버가 같은 설정은 건너뜀) GUI 스레드를 막지 않음.
+ * TIOCEXCL 은 걸지 않음 (QSerialPort::open() 이 EBUSY 로 실패).
+ *
+ * 요청마다 번호를 매겨 새 open() / cancel() / OPEN_TIMEOUT_MS 초과 뒤에 도착한
+ * 이전 요청의 결과는 버리고 fd 를 release() (멈춘 open 이 나중에 돌아와도 누수 없음).
+ * Linux 외 플랫폼은 미리 열지 않고 fd = -1 로 바로 성공 (QSerialPort::open() 이 직접 엶).
+ */
+class PortOpener : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int OPEN_TIMEOUT_MS = 3000;
+
+    explicit PortOpener(QObject *parent = nullptr);
+    ~PortOpener() override;
+
+    // 이전 요청은 취소
+    void open(const QString &portName, int baudRate, bool lowLatency);
+    void cancel();
+    bool isPending() const { return m_pending; }
+    // 결과의 fd 닫기 + 저지연 장치 설정 복원 (I/O 스레드)
+    void release(const PortOpenResult &result);
+
+signals:
+    void finished(const PortOpenResult &result);
+    void requestOpen(quint64 request, const QString &portName, int baudRate, bool lowLatency);   // 내부: 워커로
+    void requestRelease(const PortOpenResult &result);                                            // 내부: 워커로
+
+private:
+    void onOpened(const PortOpenResult &result);
+    void onTimeout();
+
+    QThread         m_thread;
+    PortOpenWorker *m_worker;
+    QTimer         *m_timeoutTimer;
+    std::atomic<quint64> m_request { 0 };   // 현재 요청 번호 (워커가 지난 요청을 건너뛰는 데 사용)
+    bool            m_pending = false;
+    QString         m_portName;             // 대기 중인 요청 (타임아웃 보고용)
+    int             m_baudRate = 0;
+    bool            m_lowLatency = false;
+};
+
+#endif // PORTOPENER_H
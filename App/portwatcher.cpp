@@ -0,0 +1,285 @@
+#include "portwatcher.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QSerialPortInfo>
+#include <QSocketNotifier>
+#include <QTimer>
+#include <algorithm>
+#include <cstring>
+
+#if defined(Q_OS_LINUX)
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <fcntl.h>
+#elif defined(Q_OS_WIN)
+#include <windows.h>
+#include <dbt.h>
+#endif
+
+// ═══════════════════════════════════════════════
+// SerialDeviceInfo
+// ═══════════════════════════════════════════════
+
+int SerialDeviceInfo::matchScore(const SerialDeviceInfo &other) const
+{
+    if (hasUsbIds && other.hasUsbIds
+        && vendorId == other.vendorId && productId == other.productId) {
+        if (!serialNumber.isEmpty() && serialNumber == other.serialNumber)
+            return 3;
+        // 시리얼 번호가 양쪽 다 있는데 다르면 다른 장치 (같은 보드 두 대)
+        if (!serialNumber.isEmpty() && !other.serialNumber.isEmpty())
+            return 0;
+        return 2;
+    }
+    return portName == other.portName ? 1 : 0;
+}
+
+QString SerialDeviceInfo::describe() const
+{
+    if (!hasUsbIds)
+        return portName;
+    QString s = QString("%1 [%2:%3")
+                    .arg(portName)
+                    .arg(vendorId, 4, 16, QChar('0'))
+                    .arg(productId, 4, 16, QChar('0'));
+    if (!serialNumber.isEmpty())
+        s += " " + serialNumber;
+    return s + "]";
+}
+
+static QVector<SerialDeviceInfo> enumeratePorts()
+{
+    QVector<SerialDeviceInfo> devices;
+    const auto infos = QSerialPortInfo::availablePorts();
+    devices.reserve(infos.size());
+    for (const QSerialPortInfo &info : infos) {
+        SerialDeviceInfo d;
+        d.portName     = info.portName();
+        d.description  = info.description();
+        d.serialNumber = info.serialNumber();
+        d.hasUsbIds    = info.hasVendorIdentifier() && info.hasProductIdentifier();
+        d.vendorId     = info.vendorIdentifier();
+        d.productId    = info.productIdentifier();
+        devices << d;
+    }
+    std::sort(devices.begin(), devices.end(), [](const SerialDeviceInfo &a, const SerialDeviceInfo &b) {
+        return a.portName < b.portName;
+    });
+    return devices;
+}
+
+static bool sameDevices(const QVector<SerialDeviceInfo> &a, const QVector<SerialDeviceInfo> &b)
+{
+    if (a.size() != b.size())
+        return false;
+    for (int i = 0; i < a.size(); ++i) {
+        if (a[i].portName != b[i].portName || a[i].serialNumber != b[i].serialNumber
+            || a[i].vendorId != b[i].vendorId || a[i].productId != b[i].productId)
+            return false;
+    }
+    return true;
+}
+
+// ═══════════════════════════════════════════════
+// PortScanWorker (열거 스레드)
+// ═══════════════════════════════════════════════
+
+void PortScanWorker::scan()
+{
+    emit scanned(enumeratePorts());
+}
+
+// ═══════════════════════════════════════════════
+// PortWatcher
+// ═══════════════════════════════════════════════
+
+PortWatcher::PortWatcher(QObject *parent)
+    : QObject(parent)
+    , m_worker(new PortScanWorker)
+    , m_debounceTimer(new QTimer(this))
+    , m_pollTimer(new QTimer(this))
+{
+    qRegisterMetaType<QVector<SerialDeviceInfo>>();
+
+    m_thread.setObjectName("PortWatcher");
+    m_worker->moveToThread(&m_thread);
+    connect(&m_thread, &QThread::finished, m_worker, &QObject::deleteLater);
+    connect(this, &PortWatcher::requestScan, m_worker, &PortScanWorker::scan);
+    connect(m_worker, &PortScanWorker::scanned, this, &PortWatcher::onScanned);
+    m_thread.start(QThread::LowPriority);
+
+    m_debounceTimer->setSingleShot(true);
+    m_debounceTimer->setInterval(DEBOUNCE_MS);
+    connect(m_debounceTimer, &QTimer::timeout, this, &PortWatcher::rescan);
+
+#if defined(Q_OS_LINUX)
+    setupInotify();
+#elif defined(Q_OS_WIN)
+    QCoreApplication::instance()->installNativeEventFilter(this);
+    m_hotplug = true;
+#endif
+
+    // 핫플러그 알림이 없으면 주기 열거로 대체
+    m_pollTimer->setInterval(POLL_INTERVAL_MS);
+    connect(m_pollTimer, &QTimer::timeout, this, &PortWatcher::rescan);
+    if (!m_hotplug)
+        m_pollTimer->start();
+
+    qWarning() << "PortWatcher: hotplug" << (m_hotplug ? "notifications" : "polling");
+}
+
+PortWatcher::~PortWatcher()
+{
+#if defined(Q_OS_WIN)
+    if (QCoreApplication::instance())
+        QCoreApplication::instance()->removeNativeEventFilter(this);
+#endif
+#if defined(Q_OS_LINUX)
+    // 알림기를 먼저 지워야 닫힌(재사용될 수 있는) fd 를 감시하지 않음
+    delete m_inotifyNotifier;
+    m_inotifyNotifier = nullptr;
+    if (m_inotifyFd >= 0)
+        ::close(m_inotifyFd);
+#endif
+    m_thread.quit();
+    m_thread.wait();
+}
+
+QStringList PortWatcher::portNames() const
+{
+    QStringList names;
+    for (const SerialDeviceInfo &d : m_devices)
+        names << d.portName;
+    return names;
+}
+
+SerialDeviceInfo PortWatcher::device(const QString &portName) const
+{
+    for (const SerialDeviceInfo &d : m_devices) {
+        if (d.portName == portName)
+            return d;
+    }
+    SerialDeviceInfo unknown;
+    unknown.portName = portName;
+    return unknown;
+}
+
+SerialDeviceInfo PortWatcher::bestMatch(const SerialDeviceInfo &target) const
+{
+    SerialDeviceInfo best;
+    int bestScore = 0;
+    for (const SerialDeviceInfo &d : m_devices) {
+        int score = target.matchScore(d);
+        // 같은 점수면 이전 포트 이름 우선 (VID/PID 만 같은 보드가 여러 개일 때)
+        if (score > 0 && d.portName == target.portName)
+            score = score * 2 + 1;
+        else
+            score *= 2;
+        if (score > bestScore) {
+            bestScore = score;
+            best = d;
+        }
+    }
+    return best;
+}
+
+void PortWatcher::rescan()
+{
+    if (m_scanning) {
+        m_rescanPending = true;
+        return;
+    }
+    m_scanning = true;
+    emit requestScan();
+}
+
+void PortWatcher::scanNow()
+{
+    applyDevices(enumeratePorts());
+}
+
+void PortWatcher::hotplugNotified()
+{
+    m_debounceTimer->start();
+}
+
+void PortWatcher::onScanned(const QVector<SerialDeviceInfo> &devices)
+{
+    m_scanning = false;
+    if (m_rescanPending) {
+        m_rescanPending = false;
+        rescan();
+    }
+    applyDevices(devices);
+}
+
+void PortWatcher::applyDevices(const QVector<SerialDeviceInfo> &devices)
+{
+    if (sameDevices(m_devices, devices))
+        return;
+    m_devices = devices;
+    emit devicesChanged();
+}
+
+// ── 플랫폼별 알림 ──
+
+void PortWatcher::setupInotify()
+{
+#if defined(Q_OS_LINUX)
+    m_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_inotifyFd < 0) {
+        qWarning() << "PortWatcher: inotify_init1 failed";
+        return;
+    }
+    // IN_ATTRIB: udev 가 노드를 만든 뒤 권한/그룹을 바꾸는 시점 (그 전에는 open 이 EACCES)
+    if (inotify_add_watch(m_inotifyFd, "/dev", IN_CREATE | IN_DELETE | IN_ATTRIB) < 0) {
+        qWarning() << "PortWatcher: inotify watch on /dev failed";
+        ::close(m_inotifyFd);
+        m_inotifyFd = -1;
+        return;
+    }
+    m_inotifyNotifier = new QSocketNotifier(m_inotifyFd, QSocketNotifier::Read, this);
+    connect(m_inotifyNotifier, &QSocketNotifier::activated, this, &PortWatcher::readInotify);
+    m_hotplug = true;
+#endif
+}
+
+void PortWatcher::readInotify()
+{
+#if defined(Q_OS_LINUX)
+    alignas(inotify_event) char buf[4096];
+    bool relevant = false;
+    for (;;) {
+        const ssize_t n = ::read(m_inotifyFd, buf, sizeof(buf));
+        if (n <= 0)
+            break;
+        for (ssize_t off = 0; off < n;) {
+            const auto *ev = reinterpret_cast<const inotify_event *>(buf + off);
+            if (ev->len > 0 && std::strncmp(ev->name, "tty", 3) == 0)
+                relevant = true;
+            off += ssize_t(sizeof(inotify_event)) + ev->len;
+        }
+    }
+    if (relevant)
+        hotplugNotified();
+#endif
+}
+
+bool PortWatcher::nativeEventFilter(const QByteArray &eventType, void *message, qintptr *result)
+{
+    Q_UNUSED(result);
+#if defined(Q_OS_WIN)
+    if (eventType == "windows_generic_MSG") {
+        const MSG *msg = static_cast<const MSG *>(message);
+        if (msg->message == WM_DEVICECHANGE
+            && (msg->wParam == DBT_DEVICEARRIVAL || msg->wParam == DBT_DEVICEREMOVECOMPLETE
+                || msg->wParam == DBT_DEVNODES_CHANGED))
+            hotplugNotified();
+    }
+#else
+    Q_UNUSED(eventType);
+    Q_UNUSED(message);
+#endif
+    return false;
+}
@@ -0,0 +1,116 @@
+#ifndef PORTWATCHER_H
+#define PORTWATCHER_H
+
+#include <QAbstractNativeEventFilter>
+#include <QMetaType>
+#include <QObject>
+#include <QStringList>
+#include <QThread>
+#include <QVector>
+
+class QSocketNotifier;
+class QTimer;
+
+/**
+ * SerialDeviceInfo
+ *
+ * 포트 하나의 식별 정보.  재열거(케이블 재연결)로 포트 이름이 바뀌어도
+ * USB VID/PID/시리얼 번호로 같은 장치를 다시 찾기 위해 사용.
+ */
+struct SerialDeviceInfo
+{
+    QString portName;
+    QString description;
+    QString serialNumber;
+    quint16 vendorId = 0;
+    quint16 productId = 0;
+    bool    hasUsbIds = false;
+
+    bool isValid() const { return !portName.isEmpty(); }
+    // 장치 식별 점수: 3 = VID/PID/시리얼 일치, 2 = VID/PID 일치, 1 = 포트 이름만 일치, 0 = 다름
+    int matchScore(const SerialDeviceInfo &other) const;
+    QString describe() const;
+};
+Q_DECLARE_METATYPE(SerialDeviceInfo)
+
+/**
+ * PortScanWorker
+ *
+ * QSerialPortInfo::availablePorts() 는 Windows 에서 SetupAPI 열거로 수십~수백 ms
+ * 걸릴 수 있어 GUI 스레드 밖(전용 스레드)에서 실행.
+ */
+class PortScanWorker : public QObject
+{
+    Q_OBJECT
+
+public slots:
+    void scan();
+
+signals:
+    void scanned(const QVector<SerialDeviceInfo> &devices);
+};
+
+/**
+ * PortWatcher
+ *
+ * 시리얼 장치 핫플러그 감시 + 비동기 포트 열거.
+ *
+ *  - Linux   : inotify 로 /dev 의 tty* 생성/삭제/권한 변경 감시
+ *  - Windows : 최상위 창으로 브로드캐스트되는 WM_DEVICECHANGE (네이티브 이벤트 필터)
+ *  - 그 외   : 핫플러그 알림이 없으므로 POLL_INTERVAL_MS 주기 열거
+ *
+ * 알림은 DEBOUNCE_MS 동안 모아서 한 번만 열거 (udev 가 노드 생성 후 권한을 바꾸는 등
+ * 알림이 연달아 옴).  열거 중 다시 요청되면 끝난 뒤 한 번 더 열거.
+ * 결과가 이전과 다를 때만 devicesChanged().
+ */
+class PortWatcher : public QObject, public QAbstractNativeEventFilter
+{
+    Q_OBJECT
+
+public:
+    static constexpr int DEBOUNCE_MS      = 50;
+    static constexpr int POLL_INTERVAL_MS = 2000;
+
+    explicit PortWatcher(QObject *parent = nullptr);
+    ~PortWatcher() override;
+
+    // 비동기 재열거 요청 (결과는 devicesChanged)
+    void rescan();
+    // 동기 열거 (시작 시 1회 등 호출 스레드에서 바로 목록이 필요할 때)
+    void scanNow();
+
+    const QVector<SerialDeviceInfo> &devices() const { return m_devices; }
+    QStringList portNames() const;
+    SerialDeviceInfo device(const QString &portName) const;
+    // target 과 가장 잘 맞는 장치 (점수 0 이면 무효 반환)
+    SerialDeviceInfo bestMatch(const SerialDeviceInfo &target) const;
+
+    bool hotplugSupported() const { return m_hotplug; }
+
+    bool nativeEventFilter(const QByteArray &eventType, void *message, qintptr *result) override;
+
+signals:
+    void devicesChanged();
+    void requestScan();     // 내부: 워커 스레드로 열거 요청
+
+private:
+    void hotplugNotified();
+    void onScanned(const QVector<SerialDeviceInfo> &devices);
+    void applyDevices(const QVector<SerialDeviceInfo> &devices);
+    void setupInotify();
+    void readInotify();
+
+    QVector<SerialDeviceInfo> m_devices;
+    QThread         m_thread;
+    PortScanWorker *m_worker;
+    QTimer         *m_debounceTimer;
+    QTimer         *m_pollTimer;
+    bool            m_scanning = false;
+    bool            m_rescanPending = false;
+    bool            m_hotplug = false;
+
+    int              m_inotifyFd = -1;
+    QSocketNotifier *m_inotifyNotifier = nullptr;
+};
+
+#endif // PORTWATCHER_H
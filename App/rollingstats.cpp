@@ -0,0 +1,108 @@
+#include "rollingstats.h"
+
+#include <cmath>
+
+SlidingStats::SlidingStats(double windowSec, int capacity)
+    : m_windowSec(windowSec)
+    , m_capacity(qMax(1, capacity))
+    , m_ring(m_capacity)
+{
+    m_minQ.items.resize(m_capacity);
+    m_maxQ.items.resize(m_capacity);
+}
+
+void SlidingStats::clear()
+{
+    m_head = 0;
+    m_count = 0;
+    m_mean = 0;
+    m_m2 = 0;
+    m_sinceRecompute = 0;
+    m_minQ.head = m_minQ.size = 0;
+    m_maxQ.head = m_maxQ.size = 0;
+}
+
+void SlidingStats::add(double timeSec, double value)
+{
+    // ── 창 밖 / 용량 초과 샘플 제거 ──
+    while (m_count > 0 && timeSec - m_ring[m_head].time > m_windowSec)
+        popOldest();
+    if (m_count == m_capacity)
+        popOldest();
+
+    // ── 추가 ──
+    m_ring[(m_head + m_count) % m_capacity] = { timeSec, value };
+    ++m_count;
+
+    const double delta = value - m_mean;
+    m_mean += delta / m_count;
+    m_m2 += delta * (value - m_mean);
+
+    const qint64 seq = m_nextSeq++;
+    while (m_minQ.size > 0 && m_minQ.back().value >= value)
+        m_minQ.popBack();
+    m_minQ.pushBack({ seq, value });
+    while (m_maxQ.size > 0 && m_maxQ.back().value <= value)
+        m_maxQ.popBack();
+    m_maxQ.pushBack({ seq, value });
+
+    if (++m_sinceRecompute >= m_capacity)
+        recompute();
+}
+
+void SlidingStats::popOldest()
+{
+    const double value = m_ring[m_head].value;
+    const qint64 seq = m_nextSeq - m_count;
+    m_head = (m_head + 1) % m_capacity;
+    --m_count;
+
+    if (m_count == 0) {
+        m_mean = 0;
+        m_m2 = 0;
+    } else {
+        // Welford 역갱신
+        const double delta = value - m_mean;
+        m_mean -= delta / m_count;
+        m_m2 -= delta * (value - m_mean);
+    }
+
+    if (m_minQ.size > 0 && m_minQ.front().seq == seq)
+        m_minQ.popFront();
+    if (m_maxQ.size > 0 && m_maxQ.front().seq == seq)
+        m_maxQ.popFront();
+}
+
+void SlidingStats::recompute()
+{
+    m_sinceRecompute = 0;
+    double mean = 0, m2 = 0;
+    for (int k = 0; k < m_count; ++k) {
+        const double x = m_ring[(m_head + k) % m_capacity].value;
+        const double delta = x - mean;
+        mean += delta / (k + 1);
+        m2 += delta * (x - mean);
+    }
+    m_mean = mean;
+    m_m2 = m2;
+}
+
+double SlidingStats::stddev() const
+{
+    return std::sqrt(variance());
+}
+
+double SlidingStats::rms() const
+{
+    return std::sqrt(variance() + m_mean * m_mean);
+}
+
+double SlidingStats::min() const
+{
+    return m_minQ.size > 0 ? m_minQ.front().value : 0.0;
+}
+
+double SlidingStats::max() const
+{
+    return m_maxQ.size > 0 ? m_maxQ.front().value : 0.0;
+}
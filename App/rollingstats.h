@@ -0,0 +1,72 @@
+#ifndef ROLLINGSTATS_H
+#define ROLLINGSTATS_H
+
+#include <QtGlobal>
+#include <QVector>
+
+/**
+ * SlidingStats
+ *
+ * 시간 창(초) 기반 슬라이딩 통계.  샘플 추가/제거 모두 O(1) (분할 상환).
+ *
+ *  - 평균/분산: 슬라이딩 Welford (추가·제거 양방향 갱신),
+ *               창 크기만큼 진행할 때마다 재계산해 누적 오차 제거
+ *  - RMS      : sqrt(분산 + 평균²)
+ *  - min/max  : 단조 덱 (monotonic deque)
+ *
+ * 링버퍼 용량을 넘으면 시간과 무관하게 가장 오래된 샘플부터 밀어낸다.
+ */
+class SlidingStats
+{
+public:
+    explicit SlidingStats(double windowSec = 1.0, int capacity = 128);
+
+    void add(double timeSec, double value);
+    void clear();
+
+    double windowSec() const { return m_windowSec; }
+    int    count()     const { return m_count; }
+    double mean()      const { return m_mean; }
+    double variance()  const { return m_count > 0 ? qMax(0.0, m_m2 / m_count) : 0.0; }
+    double stddev()    const;
+    double rms()       const;
+    double min()       const;
+    double max()       const;
+    double peakToPeak() const { return max() - min(); }
+
+private:
+    struct Sample { double time; double value; };
+    struct Extremum { qint64 seq; double value; };
+
+    // 고정 용량 덱 (링)
+    struct Deque {
+        QVector<Extremum> items;
+        int head = 0;
+        int size = 0;
+        const Extremum &front() const { return items[head]; }
+        const Extremum &back()  const { return items[(head + size - 1) % items.size()]; }
+        void popFront() { head = (head + 1) % items.size(); --size; }
+        void popBack()  { --size; }
+        void pushBack(const Extremum &e) { items[(head + size) % items.size()] = e; ++size; }
+    };
+
+    void popOldest();
+    void recompute();
+
+    double m_windowSec;
+    int    m_capacity;
+
+    QVector<Sample> m_ring;
+    int    m_head = 0;          // 가장 오래된 샘플
+    int    m_count = 0;
+    qint64 m_nextSeq = 0;       // 다음 샘플 순번 (가장 오래된 샘플 = m_nextSeq - m_count)
+
+    double m_mean = 0;
+    double m_m2 = 0;
+    int    m_sinceRecompute = 0;
+
+    Deque  m_minQ;              // 값 오름차순
+    Deque  m_maxQ;              // 값 내림차순
+};
+
+#endif // ROLLINGSTATS_H
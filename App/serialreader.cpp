@@ -0,0 +1,243 @@
+#include "serialreader.h"
+
+#include <QThread>
+
+#if defined(Q_OS_LINUX)
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+SerialReader::SerialReader(QObject *parent)
+    : QObject(parent)
+{
+}
+
+SerialReader::~SerialReader()
+{
+    close();
+}
+
+QString SerialReader::systemLocation(const QString &portName)
+{
+    return portName.startsWith('/') ? portName : "/dev/" + portName;
+}
+
+#if defined(Q_OS_LINUX)
+
+static QString errorText(int err)
+{
+    return QString::fromLocal8Bit(std::strerror(err));
+}
+
+bool SerialReader::open(const QString &path, const QElapsedTimer &clock)
+{
+    close();
+    const int fd = ::open(path.toLocal8Bit().constData(), O_RDONLY | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) {
+        m_error = errorText(errno);
+        return false;
+    }
+    if (!adopt(fd, clock)) {
+        ::close(fd);
+        return false;
+    }
+    return true;
+}
+
+bool SerialReader::adopt(int fd, const QElapsedTimer &clock)
+{
+    close();
+    m_wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_wakeFd < 0) {
+        m_error = errorText(errno);
+        return false;
+    }
+    // 읽기는 poll 로 기다리므로 비차단 (I/O 스레드가 연 fd 도 O_NONBLOCK 이지만 보장)
+    ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+    m_fd = fd;
+    m_clock = clock;
+    m_error.clear();
+    return true;
+}
+
+void SerialReader::start(const SerialTuning::Options &options)
+{
+    if (m_fd < 0 || m_thread)
+        return;
+    {
+        QMutexLocker lock(&m_optionsMutex);
+        m_options = options;
+        m_optionsPending = true;
+    }
+    m_stop = false;
+    const quint64 session = m_session;
+    m_thread = QThread::create([this, session]() { run(session); });
+    m_thread->setObjectName("SerialReader");
+    m_thread->start();
+}
+
+void SerialReader::close()
+{
+    if (m_thread) {
+        m_stop = true;
+        wake();
+        m_thread->wait();
+        delete m_thread;
+        m_thread = nullptr;
+    }
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+    if (m_wakeFd >= 0) {
+        ::close(m_wakeFd);
+        m_wakeFd = -1;
+    }
+    ++m_session;
+}
+
+void SerialReader::setThreadOptions(const SerialTuning::Options &options)
+{
+    {
+        QMutexLocker lock(&m_optionsMutex);
+        m_options = options;
+        m_optionsPending = true;
+    }
+    wake();
+}
+
+void SerialReader::wake()
+{
+    if (m_wakeFd < 0)
+        return;
+    const quint64 one = 1;
+    const ssize_t written = ::write(m_wakeFd, &one, sizeof(one));
+    Q_UNUSED(written);
+}
+
+/**
+ * run()
+ *
+ * 수신 스레드 본체.  poll 복귀 시각을 수신 시각으로 (read 복사 시간 제외).
+ * 결과는 GUI 스레드로 큐잉 — 그 사이 close() 되면 세션 번호가 달라져 버려짐.
+ */
+void SerialReader::run(quint64 session)
+{
+    SerialTuning::ThreadSaved saved;
+    pollfd fds[2];
+    fds[0] = { m_fd, POLLIN, 0 };
+    fds[1] = { m_wakeFd, POLLIN, 0 };
+
+    auto fail = [this, session](const QString &reason) {
+        QMetaObject::invokeMethod(this, [this, session, reason]() {
+            if (session == m_session)
+                emit readFailed(reason);
+        }, Qt::QueuedConnection);
+    };
+
+    while (!m_stop.load()) {
+        SerialTuning::Options options;
+        bool tune = false;
+        {
+            QMutexLocker lock(&m_optionsMutex);
+            if (m_optionsPending) {
+                options = m_options;
+                m_optionsPending = false;
+                tune = true;
+            }
+        }
+        if (tune) {
+            const QVariantMap report = SerialTuning::applyThread(options, &saved);
+            QMetaObject::invokeMethod(this, [this, session, report]() {
+                if (session == m_session)
+                    emit threadTuned(report);
+            }, Qt::QueuedConnection);
+        }
+
+        if (::poll(fds, 2, -1) < 0) {
+            if (errno == EINTR)
+                continue;
+            fail(errorText(errno));
+            return;
+        }
+        const double rxHostMs = m_clock.nsecsElapsed() / 1.0e6;
+
+        if (fds[1].revents & POLLIN) {
+            quint64 count;
+            const ssize_t drained = ::read(m_wakeFd, &count, sizeof(count));
+            Q_UNUSED(drained);
+        }
+
+        const short revents = fds[0].revents;
+        if (revents & POLLIN) {
+            QByteArray chunk(READ_BYTES, Qt::Uninitialized);
+            const ssize_t got = ::read(m_fd, chunk.data(), READ_BYTES);
+            if (got > 0) {
+                chunk.truncate(int(got));
+                QMetaObject::invokeMethod(this, [this, session, chunk, rxHostMs]() {
+                    if (session == m_session)
+                        emit dataRead(chunk, rxHostMs);
+                }, Qt::QueuedConnection);
+                continue;
+            }
+            // 0 / EIO = 장치 제거 (USB 분리, pty 마스터 닫힘)
+            if (got == 0 || (errno != EAGAIN && errno != EINTR)) {
+                fail(got == 0 ? QString("device closed") : errorText(errno));
+                return;
+            }
+        } else if (revents & (POLLHUP | POLLERR | POLLNVAL)) {
+            fail(revents & POLLNVAL ? QString("invalid descriptor") : QString("device closed"));
+            return;
+        }
+    }
+
+    // 스레드가 끝나므로 원래 스케줄링 복원은 필요 없음 (GUI 스레드는 건드린 적 없음)
+}
+
+#else
+
+bool SerialReader::open(const QString &path, const QElapsedTimer &clock)
+{
+    Q_UNUSED(path);
+    Q_UNUSED(clock);
+    m_error = "unsupported on this platform";
+    return false;
+}
+
+bool SerialReader::adopt(int fd, const QElapsedTimer &clock)
+{
+    Q_UNUSED(fd);
+    Q_UNUSED(clock);
+    m_error = "unsupported on this platform";
+    return false;
+}
+
+void SerialReader::start(const SerialTuning::Options &options)
+{
+    Q_UNUSED(options);
+}
+
+void SerialReader::close()
+{
+    ++m_session;
+}
+
+void SerialReader::setThreadOptions(const SerialTuning::Options &options)
+{
+    Q_UNUSED(options);
+}
+
+void SerialReader::wake()
+{
+}
+
+void SerialReader::run(quint64 session)
+{
+    Q_UNUSED(session);
+}
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef SERIALREADER_H
+#define SERIALREADER_H
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QObject>
+#include <QVariantMap>
+#include <atomic>
+
+#include "serialtuning.h"
+
+class QThread;
+
+/**
+ * SerialReader
+ *
+ * 저지연 모드 수신 스레드 (Linux).  장치를 자체 fd 로 읽고 전용 스레드에서
+ * poll()/read() — GUI 스레드가 그리기/레이아웃 중이어도 커널 버퍼를 바로 비우고
+ * 준비 시각(poll 복귀)을 정확히 기록.  SCHED_FIFO / affinity 는 이 스레드에만 적용.
+ *
+ * QSerialPort 는 open() 에서 TIOCEXCL 을 걸기 때문에 이 fd 는 그보다 먼저 열려 있어야 함
+ * (앱에서는 PortOpenWorker 가 I/O 스레드에서 연 fd 를 adopt()).
+ * 포트는 WriteOnly 로 연다 (QSerialPort 가 읽기 알림을 만들지 않음 → 송신 전용).
+ *
+ * 읽은 조각은 GUI 스레드로 넘겨 dataRead() (close() 이전 세션의 조각은 버림).
+ * 한 번에 READ_BYTES (110 바이트 패킷 32개) 까지 — 커널 tty 버퍼가 쌓였을 때
+ * 이벤트 하나로 비우면서 파서 버퍼 예약(패킷 32개분)을 넘지 않는 크기.
+ */
+class SerialReader : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int FRAME_BYTES = 110;              // 텔레메트리 패킷 크기
+    static constexpr int READ_FRAMES = 32;
+    static constexpr int READ_BYTES  = FRAME_BYTES * READ_FRAMES;
+
+    explicit SerialReader(QObject *parent = nullptr);
+    ~SerialReader() override;
+
+    // QSerialPort 포트 이름 → 장치 경로 (ttyUSB0 → /dev/ttyUSB0)
+    static QString systemLocation(const QString &portName);
+
+    // 장치 열기 (스레드는 아직 시작 안 함).  clock: 수신 시각 기준 (호스트 타임라인)
+    bool open(const QString &path, const QElapsedTimer &clock);
+    // 이미 열린 fd 를 넘겨받음 (성공하면 close() 에서 닫음, 실패하면 호출자 소유)
+    bool adopt(int fd, const QElapsedTimer &clock);
+    // 수신 스레드 시작.  options 의 우선순위/affinity 는 스레드 안에서 적용 → threadTuned
+    void start(const SerialTuning::Options &options);
+    void close();
+    bool isOpen() const { return m_fd >= 0; }
+    int  handle() const { return m_fd; }   // 읽기 fd (VMIN/VTIME 적용/복원용)
+    QString errorString() const { return m_error; }
+
+    // 실행 중인 수신 스레드에 우선순위/affinity 변경 요청
+    void setThreadOptions(const SerialTuning::Options &options);
+
+signals:
+    void dataRead(const QByteArray &data, double rxHostMs);
+    void readFailed(const QString &reason);
+    void threadTuned(const QVariantMap &report);
+
+private:
+    void run(quint64 session);
+    void wake();
+
+    int           m_fd = -1;
+    int           m_wakeFd = -1;      // eventfd: close()/옵션 변경 시 poll 깨우기
+    QThread      *m_thread = nullptr;
+    QElapsedTimer m_clock;
+    quint64       m_session = 0;      // close() 마다 증가, 이전 세션의 대기 중 조각 무시
+    std::atomic_bool m_stop { false };
+    QString       m_error;
+
+    QMutex                m_optionsMutex;
+    SerialTuning::Options m_options;
+    bool                  m_optionsPending = false;
+};
+
+#endif // SERIALREADER_H
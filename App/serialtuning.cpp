@@ -0,0 +1,256 @@
+#include "serialtuning.h"
+
+#include <QFile>
+
+#if defined(Q_OS_LINUX)
+#include <linux/serial.h>
+#include <sys/ioctl.h>
+#include <termios.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace SerialTuning {
+
+#if defined(Q_OS_LINUX)
+
+static QString failure(int err)
+{
+    return QString("failed: %1").arg(QString::fromLocal8Bit(std::strerror(err)));
+}
+
+static QString latencyTimerPath(const QString &portName)
+{
+    return "/sys/bus/usb-serial/devices/" + portName + "/latency_timer";
+}
+
+// 현재 플래그 (0/1), 실패 시 -1 + err
+static int readAsyncLowLatency(int fd, int *err)
+{
+    serial_struct ss;
+    if (::ioctl(fd, TIOCGSERIAL, &ss) < 0) {
+        *err = errno;    // CDC ACM 등 TIOCGSERIAL 미지원 드라이버
+        return -1;
+    }
+    return (ss.flags & ASYNC_LOW_LATENCY) ? 1 : 0;
+}
+
+static QString setAsyncLowLatency(int fd, bool on)
+{
+    serial_struct ss;
+    if (::ioctl(fd, TIOCGSERIAL, &ss) < 0)
+        return failure(errno);
+    if (on)
+        ss.flags |= ASYNC_LOW_LATENCY;
+    else
+        ss.flags &= ~ASYNC_LOW_LATENCY;
+    if (::ioctl(fd, TIOCSSERIAL, &ss) < 0)
+        return failure(errno);
+    if (::ioctl(fd, TIOCGSERIAL, &ss) < 0)
+        return failure(errno);
+    return (ss.flags & ASYNC_LOW_LATENCY) ? "on" : "off";
+}
+
+// 현재 값 (ms), 없거나 읽을 수 없으면 -1
+static int readLatencyTimer(const QString &portName)
+{
+    QFile file(latencyTimerPath(portName));
+    if (!file.open(QIODevice::ReadOnly))
+        return -1;
+    bool ok = false;
+    const int ms = file.readAll().trimmed().toInt(&ok);
+    return ok ? ms : -1;
+}
+
+static QString setLatencyTimer(const QString &portName, int ms)
+{
+    QFile file(latencyTimerPath(portName));
+    if (!file.exists())
+        return "n/a (not usb-serial)";
+    if (file.open(QIODevice::WriteOnly)) {
+        file.write(QByteArray::number(ms));
+        file.close();
+    }
+    // 쓰기 권한이 없어도 현재 값은 보고
+    const int current = readLatencyTimer(portName);
+    if (current < 0)
+        return failure(EACCES);
+    if (current != ms)
+        return QString("%1 ms (failed to set %2 ms)").arg(current).arg(ms);
+    return QString("%1 ms").arg(current);
+}
+
+static QString setTermiosTiming(int fd, int vmin, int vtime)
+{
+    termios tio;
+    if (::tcgetattr(fd, &tio) < 0)
+        return failure(errno);
+    tio.c_cc[VMIN] = cc_t(vmin);
+    tio.c_cc[VTIME] = cc_t(vtime);
+    if (::tcsetattr(fd, TCSANOW, &tio) < 0)
+        return failure(errno);
+    ::tcgetattr(fd, &tio);
+    return QString("VMIN=%1 VTIME=%2").arg(int(tio.c_cc[VMIN])).arg(int(tio.c_cc[VTIME]));
+}
+
+QVariantMap applyDevice(int fd, const QString &portName, PortSaved *saved)
+{
+    QVariantMap report;
+    report["enabled"] = true;
+    if (fd < 0) {
+        report["error"] = "port not open";
+        return report;
+    }
+
+    int err = 0;
+    saved->valid = true;
+    saved->portName = portName;
+    saved->asyncLowLatency = readAsyncLowLatency(fd, &err);
+    saved->latencyTimerMs = readLatencyTimer(portName);
+
+    report["asyncLowLatency"] = saved->asyncLowLatency < 0 ? failure(err) : setAsyncLowLatency(fd, true);
+    report["latencyTimer"]    = saved->latencyTimerMs < 0 ? QString("n/a (not usb-serial)")
+                                                          : setLatencyTimer(portName, 1);
+    return report;
+}
+
+QString applyTermios(int readFd, PortSaved *saved)
+{
+    termios tio;
+    if (readFd < 0 || ::tcgetattr(readFd, &tio) < 0)
+        return failure(readFd < 0 ? EBADF : errno);
+    saved->valid = true;
+    saved->vmin = tio.c_cc[VMIN];
+    saved->vtime = tio.c_cc[VTIME];
+    return setTermiosTiming(readFd, 0, 0);
+}
+
+void restore(int fd, int readFd, PortSaved *saved)
+{
+    if (!saved->valid)
+        return;
+    // 장치가 이미 사라졌으면 ioctl/sysfs 모두 실패 — 되돌릴 대상도 없음
+    if (fd >= 0 && saved->asyncLowLatency >= 0)
+        setAsyncLowLatency(fd, saved->asyncLowLatency == 1);
+    const int termiosFd = readFd >= 0 ? readFd : fd;
+    if (termiosFd >= 0 && saved->vmin >= 0)
+        setTermiosTiming(termiosFd, saved->vmin, saved->vtime);
+    if (saved->latencyTimerMs >= 0)
+        setLatencyTimer(saved->portName, saved->latencyTimerMs);
+    *saved = PortSaved();
+}
+
+static QString describePolicy(int policy, int priority)
+{
+    switch (policy) {
+    case SCHED_FIFO:  return QString("SCHED_FIFO %1").arg(priority);
+    case SCHED_RR:    return QString("SCHED_RR %1").arg(priority);
+    case SCHED_OTHER: return "SCHED_OTHER";
+    default:          return QString("policy %1").arg(policy);
+    }
+}
+
+static QString setSchedule(int policy, int priority)
+{
+    sched_param param;
+    std::memset(&param, 0, sizeof(param));
+    param.sched_priority = priority;
+    const int err = pthread_setschedparam(pthread_self(), policy, &param);
+    if (err != 0)
+        return failure(err);
+    return describePolicy(policy, priority);
+}
+
+static QString setCpuAffinity(const QList<int> &cpus)
+{
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus) {
+        if (cpu < 0 || cpu >= CPU_SETSIZE)
+            return failure(EINVAL);
+        CPU_SET(cpu, &set);
+    }
+    // pid 0 = 호출 스레드
+    if (::sched_setaffinity(0, sizeof(set), &set) < 0)
+        return failure(errno);
+    if (cpus.size() == 1)
+        return QString("cpu %1").arg(cpus.first());
+    return QString("%1 cpus").arg(cpus.size());
+}
+
+QVariantMap applyThread(const Options &options, ThreadSaved *saved)
+{
+    if (!saved->valid) {
+        sched_param param;
+        if (pthread_getschedparam(pthread_self(), &saved->policy, &param) == 0)
+            saved->priority = param.sched_priority;
+        else
+            saved->policy = SCHED_OTHER;
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (::sched_getaffinity(0, sizeof(set), &set) == 0) {
+            for (int i = 0; i < CPU_SETSIZE; ++i) {
+                if (CPU_ISSET(i, &set))
+                    saved->cpus << i;
+            }
+        }
+        saved->valid = true;
+    }
+
+    QVariantMap report;
+    if (options.rtPriority > 0)
+        report["rtPriority"] = setSchedule(SCHED_FIFO, qBound(1, options.rtPriority, 99));
+    else
+        report["rtPriority"] = setSchedule(saved->policy, saved->priority);
+
+    if (options.cpu >= 0) {
+        if (options.cpu >= ::sysconf(_SC_NPROCESSORS_ONLN))
+            report["cpuAffinity"] = failure(EINVAL);
+        else
+            report["cpuAffinity"] = setCpuAffinity({ options.cpu });
+    } else if (!saved->cpus.isEmpty()) {
+        report["cpuAffinity"] = setCpuAffinity(saved->cpus);
+    }
+    return report;
+}
+
+#else
+
+QVariantMap applyDevice(int fd, const QString &portName, PortSaved *saved)
+{
+    Q_UNUSED(fd);
+    Q_UNUSED(portName);
+    Q_UNUSED(saved);
+    QVariantMap report;
+    report["enabled"] = true;
+    report["error"] = "unsupported on this platform";
+    return report;
+}
+
+QString applyTermios(int readFd, PortSaved *saved)
+{
+    Q_UNUSED(readFd);
+    Q_UNUSED(saved);
+    return "unsupported on this platform";
+}
+
+void restore(int fd, int readFd, PortSaved *saved)
+{
+    Q_UNUSED(fd);
+    Q_UNUSED(readFd);
+    *saved = PortSaved();
+}
+
+QVariantMap applyThread(const Options &options, ThreadSaved *saved)
+{
+    Q_UNUSED(options);
+    Q_UNUSED(saved);
+    return QVariantMap();
+}
+
+#endif
+
+} // namespace SerialTuning
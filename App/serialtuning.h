@@ -0,0 +1,72 @@
+#ifndef SERIALTUNING_H
+#define SERIALTUNING_H
+
+#include <QList>
+#include <QString>
+#include <QVariantMap>
+
+/**
+ * SerialTuning
+ *
+ * QSerialPort 가 노출하지 않는 저지연 설정 (Linux 전용, 그 외 플랫폼은 "unsupported" 보고).
+ *
+ *  장치 (applyDevice, 포트 열기 I/O 스레드 PortOpenWorker 안에서 — USB 제어 전송으로 막힐 수 있음):
+ *  - ASYNC_LOW_LATENCY    : TIOCSSERIAL.  ftdi_sio 는 이 플래그로 latency_timer 를 1 ms 로 낮춤
+ *  - latency_timer        : /sys/bus/usb-serial/devices/<tty>/latency_timer (FTDI 기본 16 ms)
+ *
+ *  termios (applyTermios, QSerialPort::open() 뒤 GUI 스레드 — open 이 termios 를 다시 쓰므로):
+ *  - VMIN/VTIME           : 0/0, 수신 스레드의 읽기 fd 에.  n_tty 는 비정규 모드 poll 을
+ *                           VMIN 바이트가 모여야 깨우므로 1 바이트부터 깨어나게 함
+ *                           (termios 는 tty 단위라 QSerialPort 쪽 fd 에도 같이 적용됨)
+ *
+ *  스레드 (applyThread, 수신 스레드 SerialReader 안에서만 호출):
+ *  - 실시간 우선순위/CPU  : 호출 스레드에 SCHED_FIFO / affinity.
+ *                           권한(CAP_SYS_NICE) 없으면 실패로 보고
+ *
+ * 켜기 직전 값은 PortSaved / ThreadSaved 에 저장해 두고 끌 때 그 값으로 되돌림
+ * (기본값을 강제하지 않음 — udev 규칙 등으로 미리 낮춰 둔 latency_timer 보존).
+ * 모든 항목은 결과 맵에 { 항목 → "적용 값" 또는 "failed: 이유" } 로 보고.
+ */
+namespace SerialTuning {
+
+struct Options
+{
+    bool enabled = false;
+    int  rtPriority = 0;    // 0 = 원래 값, 1~99 = SCHED_FIFO 우선순위
+    int  cpu = -1;          // -1 = 원래 값
+};
+
+// 켜기 직전 포트 설정
+struct PortSaved
+{
+    bool    valid = false;
+    QString portName;
+    int     asyncLowLatency = -1;   // -1 = 읽지 못함 (TIOCGSERIAL 미지원), 0/1
+    int     latencyTimerMs = -1;    // -1 = 해당 없음 (usb-serial 아님)
+    int     vmin = -1;              // -1 = 읽지 못함
+    int     vtime = -1;
+};
+
+// 수신 스레드의 원래 스케줄링 (첫 applyThread 에서 저장)
+struct ThreadSaved
+{
+    bool       valid = false;
+    int        policy = 0;
+    int        priority = 0;
+    QList<int> cpus;
+};
+
+// 열린 장치 fd 에 ASYNC_LOW_LATENCY / latency_timer 적용.  원래 값은 saved 에
+QVariantMap applyDevice(int fd, const QString &portName, PortSaved *saved);
+// 읽기 fd 에 VMIN/VTIME 적용 (원래 값은 saved 에).  결과는 "termios" 항목 값
+QString applyTermios(int readFd, PortSaved *saved);
+// saved 로 되돌림 (fd 가 닫히기 전에 호출).  fd: 장치 fd (-1 = 이미 닫힘),
+// readFd: VMIN/VTIME 을 적용한 fd (-1 이면 fd).  saved 는 무효화
+void restore(int fd, int readFd, PortSaved *saved);
+
+// 호출 스레드에 우선순위/affinity 적용.  0 / -1 항목은 저장된 원래 값으로
+QVariantMap applyThread(const Options &options, ThreadSaved *saved);
+
+} // namespace SerialTuning
+
+#endif // SERIALTUNING_H
@@ -0,0 +1,183 @@
+#include "sessionlog.h"
+#include "logmodel.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QTimer>
+#include <algorithm>
+#include <cstring>
+
+using namespace SessionLogFormat;
+
+SessionLog::SessionLog(const QString &directory, QObject *parent)
+    : QObject(parent)
+    , m_dir(directory)
+    , m_flushTimer(new QTimer(this))
+    , m_block(BLOOM_BYTES, 0)
+{
+    m_flushTimer->setInterval(FLUSH_INTERVAL_MS);
+    m_flushTimer->setSingleShot(true);
+    connect(m_flushTimer, &QTimer::timeout, this, &SessionLog::flush);
+}
+
+SessionLog::~SessionLog()
+{
+    closeFile();
+}
+
+const char *SessionLog::categoryTag(int category)
+{
+    switch (category) {
+    case LogRouter::RpmTx: return "RPM";
+    case LogRouter::PidTx: return "PID";
+    case LogRouter::Rx:    return "RX ";
+    case LogRouter::Pkt:   return "PKT";
+    default:               return "???";
+    }
+}
+
+void SessionLog::append(int category, double hostTime, const QString &message)
+{
+    if (!m_log.isOpen()) {
+        if (m_failed || !openFile(hostTime))
+            return;
+    } else if (m_offset >= MAX_FILE_BYTES) {
+        closeFile();
+        if (!openFile(hostTime))
+            return;
+    }
+
+    // 본문: 벽시계 + 카테고리 + 메시지 (한 줄로)
+    const qint64 wallMs = m_wallStartMs + qint64((hostTime - m_hostStart) * 1000.0);
+    QByteArray line = QDateTime::fromMSecsSinceEpoch(wallMs).toString("yyyy-MM-dd hh:mm:ss.zzz ").toUtf8();
+    line += categoryTag(category);
+    line += "  ";
+    line += message.toUtf8();
+    line.replace('\n', ' ');
+    if (line.size() > MAX_LINE_BYTES)
+        line.truncate(MAX_LINE_BYTES);
+
+    IndexEntry entry;
+    entry.offset = quint64(m_offset);
+    entry.timeMs = quint32(qMax(0.0, (hostTime - m_hostStart) * 1000.0));
+    entry.length = quint16(line.size());
+    entry.category = quint8(category);
+    entry.reserved = 0;
+
+    // 블룸: 줄의 모든 트라이그램
+    const uchar *p = reinterpret_cast<const uchar *>(line.constData());
+    for (int i = 0; i + 2 < line.size(); ++i) {
+        int bits[2];
+        trigramBits(p[i], p[i + 1], p[i + 2], bits);
+        m_block[bits[0] >> 3] |= quint8(1u << (bits[0] & 7));
+        m_block[bits[1] >> 3] |= quint8(1u << (bits[1] & 7));
+    }
+
+    line += '\n';
+    m_log.write(line);
+    m_index.write(reinterpret_cast<const char *>(&entry), sizeof(entry));
+    m_offset += line.size();
+
+    if (++m_lines % BLOCK_LINES == 0)
+        writeBloomBlock();
+
+    if (!m_flushTimer->isActive())
+        m_flushTimer->start();
+}
+
+void SessionLog::flush()
+{
+    if (!m_log.isOpen())
+        return;
+    m_log.flush();
+    m_index.flush();
+    m_bloom.flush();
+}
+
+QStringList SessionLog::files() const
+{
+    QStringList out;
+    const QFileInfoList list = QDir(m_dir).entryInfoList({ "session_*.log" }, QDir::Files, QDir::Name | QDir::Reversed);
+    for (const QFileInfo &fi : list)
+        out << fi.absoluteFilePath();
+    return out;
+}
+
+bool SessionLog::openFile(double hostTime)
+{
+    if (!QDir().mkpath(m_dir)) {
+        qWarning() << "SessionLog: Failed to create folder -" << m_dir;
+        m_failed = true;
+        return false;
+    }
+
+    // 같은 초에 회전하면 _2, _3 ...
+    const QString stamp = QDateTime::currentDateTime().toString("yyyyMMdd_hhmmss");
+    QString base = m_dir + "/session_" + stamp;
+    for (int n = 2; QFile::exists(base + ".log"); ++n)
+        base = m_dir + "/session_" + stamp + "_" + QString::number(n);
+
+    m_log.setFileName(base + ".log");
+    m_index.setFileName(base + ".idx");
+    m_bloom.setFileName(base + ".blm");
+    if (!m_log.open(QIODevice::WriteOnly) || !m_index.open(QIODevice::WriteOnly)
+        || !m_bloom.open(QIODevice::WriteOnly)) {
+        qWarning() << "SessionLog: Failed to open log file -" << base;
+        m_log.close();
+        m_index.close();
+        m_bloom.close();
+        m_failed = true;
+        return false;
+    }
+
+    m_offset = 0;
+    m_lines = 0;
+    m_wallStartMs = QDateTime::currentMSecsSinceEpoch();
+    m_hostStart = hostTime;
+    std::fill(m_block.begin(), m_block.end(), quint8(0));
+
+    IndexHeader header;
+    std::memcpy(header.magic, INDEX_MAGIC, sizeof(header.magic));
+    header.version = VERSION;
+    header.wallStartMs = m_wallStartMs;
+    header.hostStart = m_hostStart;
+    header.blockLines = BLOCK_LINES;
+    header.bloomBytes = BLOOM_BYTES;
+    header.reserved = 0;
+    m_index.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    prune();
+    emit filesChanged();
+    return true;
+}
+
+void SessionLog::closeFile()
+{
+    if (!m_log.isOpen())
+        return;
+    // 마지막 미완성 블록도 기록 (뷰어는 블록 수로 판단)
+    if (m_lines % BLOCK_LINES != 0)
+        writeBloomBlock();
+    m_log.close();
+    m_index.close();
+    m_bloom.close();
+}
+
+void SessionLog::writeBloomBlock()
+{
+    m_bloom.write(reinterpret_cast<const char *>(m_block.constData()), m_block.size());
+    std::fill(m_block.begin(), m_block.end(), quint8(0));
+}
+
+void SessionLog::prune()
+{
+    const QStringList list = files();
+    for (int i = MAX_FILES; i < list.size(); ++i) {
+        const QString base = list[i].left(list[i].size() - 4);
+        QFile::remove(base + ".log");
+        QFile::remove(base + ".idx");
+        QFile::remove(base + ".blm");
+    }
+}
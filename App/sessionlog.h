@@ -0,0 +1,116 @@
+#ifndef SESSIONLOG_H
+#define SESSIONLOG_H
+
+#include <QFile>
+#include <QObject>
+#include <QStringList>
+#include <QVector>
+
+class QTimer;
+
+/**
+ * 세션 로그 파일 형식 (SessionLog 쓰기 / LogFileModel 읽기 공용)
+ *
+ *   session_yyyyMMdd_hhmmss.log : "yyyy-MM-dd hh:mm:ss.zzz CAT  message\n" (UTF-8)
+ *   session_yyyyMMdd_hhmmss.idx : IndexHeader + IndexEntry × 줄 수 (고정 크기, mmap 으로 바로 접근)
+ *   session_yyyyMMdd_hhmmss.blm : BLOCK_LINES 줄마다 BLOOM_BYTES 트라이그램 블룸 필터
+ *
+ * 인덱스는 줄 시작 위치/길이/시각/카테고리를 담아 줄 단위 임의 접근과
+ * 시간·카테고리 필터를 본문 스캔 없이 처리하고, 블룸 블록은 텍스트 검색에서
+ * 확실히 없는 블록을 건너뛴다.  (리틀 엔디언, 네이티브 구조체 그대로 기록)
+ */
+namespace SessionLogFormat {
+
+constexpr char    INDEX_MAGIC[4] = { 'C', 'M', 'G', 'I' };
+constexpr quint32 VERSION = 1;
+constexpr int     BLOCK_LINES = 64;
+constexpr int     BLOOM_BYTES = 512;     // 4096 비트
+constexpr int     MAX_LINE_BYTES = 0xFFFF;
+
+struct IndexHeader {
+    char    magic[4];
+    quint32 version;
+    qint64  wallStartMs;    // 파일 시작 시 벽시계 (epoch ms)
+    double  hostStart;      // 파일 시작 시 호스트 타임라인 (s)
+    quint16 blockLines;
+    quint16 bloomBytes;
+    quint32 reserved;
+};
+static_assert(sizeof(IndexHeader) == 32, "IndexHeader layout");
+
+struct IndexEntry {
+    quint64 offset;         // .log 안 줄 시작 위치
+    quint32 timeMs;         // hostStart 기준 경과 (ms)
+    quint16 length;         // 개행 제외 길이
+    quint8  category;       // LogRouter::Category
+    quint8  reserved;
+};
+static_assert(sizeof(IndexEntry) == 16, "IndexEntry layout");
+
+// 영문 대소문자 무시 트라이그램 → 블룸 비트 2개
+inline void trigramBits(uchar a, uchar b, uchar c, int bits[2])
+{
+    auto lower = [](uchar x) { return uchar((x >= 'A' && x <= 'Z') ? x + 32 : x); };
+    const quint32 h = (quint32(lower(a)) << 16) | (quint32(lower(b)) << 8) | lower(c);
+    bits[0] = int((h * 0x9E3779B1u) >> 20);   // 상위 12비트 (0..4095)
+    bits[1] = int((h * 0x85EBCA6Bu) >> 20);
+}
+
+} // namespace SessionLogFormat
+
+/**
+ * SessionLog
+ *
+ * RX/TX/이벤트 로그 한 줄씩을 회전 로그 파일 + 바이너리 인덱스로 영구 저장.
+ *  - 파일당 MAX_FILE_BYTES 넘으면 새 파일, 최근 MAX_FILES 개만 보관
+ *  - QFile 버퍼에 쌓고 FLUSH_INTERVAL_MS 마다 flush (줄마다 시스템 콜 없음)
+ *  - 화면 로그(100줄)에서 밀려난 내용도 여기서 LogFileModel 로 다시 볼 수 있음
+ */
+class SessionLog : public QObject
+{
+    Q_OBJECT
+
+    Q_PROPERTY(QString     currentFile READ currentFile NOTIFY filesChanged)
+    Q_PROPERTY(QStringList files       READ files       NOTIFY filesChanged)
+
+public:
+    static constexpr qint64 MAX_FILE_BYTES    = 64 * 1024 * 1024;
+    static constexpr int    MAX_FILES         = 20;
+    static constexpr int    FLUSH_INTERVAL_MS = 1000;
+
+    SessionLog(const QString &directory, QObject *parent = nullptr);
+    ~SessionLog() override;
+
+    // category: LogRouter::Category,  hostTime: 호스트 타임라인 (s)
+    void append(int category, double hostTime, const QString &message);
+    Q_INVOKABLE void flush();
+
+    QString     currentFile() const { return m_log.fileName(); }
+    QStringList files() const;      // 최신 순 .log 경로
+
+    static const char *categoryTag(int category);
+
+signals:
+    void filesChanged();
+
+private:
+    bool openFile(double hostTime);
+    void closeFile();
+    void writeBloomBlock();
+    void prune();
+
+    QString m_dir;
+    QFile   m_log;
+    QFile   m_index;
+    QFile   m_bloom;
+    QTimer *m_flushTimer;
+
+    qint64  m_offset = 0;
+    quint32 m_lines = 0;
+    qint64  m_wallStartMs = 0;
+    double  m_hostStart = 0;
+    QVector<quint8> m_block;        // 현재 블록 블룸 (BLOOM_BYTES)
+    bool    m_failed = false;       // 폴더 생성/열기 실패 → 재시도 안 함
+};
+
+#endif // SESSIONLOG_H
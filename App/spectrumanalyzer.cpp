@@ -0,0 +1,306 @@
+#include "spectrumanalyzer.h"
+#include "telemetryhistory.h"
+#include "tracebuffer.h"
+
+#include <QPointF>
+#include <QTimer>
+#include <QtCharts/QXYSeries>
+#include <cmath>
+
+// ═══════════════════════════════════════════════
+// SpectrumWorker (분석 스레드)
+// ═══════════════════════════════════════════════
+
+void SpectrumWorker::process(const SpectrumJob &job)
+{
+    TRACE_SCOPE(TraceBuffer::Spectrum, job.fftSize);
+
+    const int n = job.fftSize;
+    const int hop = n / 2;
+    const int bins = n / 2 + 1;
+
+    if (m_fft.size() != n || m_window.size() != n) {
+        m_fft = RealFft(n);
+        m_window.resize(n);
+        m_segment.resize(n);
+        m_power.resize(bins);
+        m_accum.resize(bins);
+        // periodic Hann
+        m_windowPower = 0;
+        for (int i = 0; i < n; ++i) {
+            m_window[i] = float(0.5 - 0.5 * std::cos(2.0 * M_PI * i / n));
+            m_windowPower += double(m_window[i]) * m_window[i];
+        }
+    }
+
+    SpectrumResult result;
+    result.channels = job.channels;
+    result.sampleRate = job.sampleRate;
+    result.fftSize = n;
+    result.wheelRpm[0] = job.wheelRpm[0];
+    result.wheelRpm[1] = job.wheelRpm[1];
+
+    // 갭 누적합: 세그먼트 (s, s+n) 안에 손실이 있으면 제외
+    const int total = job.missed.size();
+    QVector<int> gapPrefix(total + 1, 0);
+    for (int i = 0; i < total; ++i)
+        gapPrefix[i + 1] = gapPrefix[i] + (job.missed[i] > 0 ? 1 : 0);
+
+    for (const QVector<float> &samples : job.data) {
+        std::fill(m_accum.begin(), m_accum.end(), 0.0);
+        int segments = 0;
+
+        for (int s = 0; s + n <= samples.size() && s + n <= total; s += hop) {
+            if (gapPrefix[s + n] - gapPrefix[s + 1] > 0)
+                continue;
+
+            // 평균 제거 (자세각 오프셋이 DC 누설로 저주파를 덮지 않도록) + 창 적용
+            double mean = 0;
+            for (int i = 0; i < n; ++i)
+                mean += samples[s + i];
+            mean /= n;
+            for (int i = 0; i < n; ++i)
+                m_segment[i] = float(samples[s + i] - mean) * m_window[i];
+
+            m_fft.powerSpectrum(m_segment.constData(), m_power.data());
+            for (int k = 0; k < bins; ++k)
+                m_accum[k] += m_power[k];
+            ++segments;
+        }
+
+        QVector<float> psd;
+        if (segments > 0 && job.sampleRate > 0) {
+            psd.resize(bins);
+            const double scale = 1.0 / (job.sampleRate * m_windowPower * segments);
+            for (int k = 0; k < bins; ++k) {
+                const double oneSided = (k == 0 || k == bins - 1) ? 1.0 : 2.0;
+                psd[k] = float(10.0 * std::log10(m_accum[k] * scale * oneSided + 1e-20));
+            }
+        }
+        result.psdDb.append(psd);
+        result.segments.append(segments);
+    }
+
+    emit finished(result);
+}
+
+// ═══════════════════════════════════════════════
+// SpectrumAnalyzer (GUI 스레드)
+// ═══════════════════════════════════════════════
+
+SpectrumAnalyzer::SpectrumAnalyzer(TelemetryHistory *history, QObject *parent)
+    : QObject(parent)
+    , m_history(history)
+    , m_captureTimer(new QTimer(this))
+    , m_worker(new SpectrumWorker)
+{
+    qRegisterMetaType<SpectrumResult>();
+
+    m_thread.setObjectName("SpectrumAnalyzer");
+    m_worker->moveToThread(&m_thread);
+    connect(&m_thread, &QThread::finished, m_worker, &QObject::deleteLater);
+    connect(m_worker, &SpectrumWorker::finished, this, &SpectrumAnalyzer::onFinished);
+    m_thread.start(QThread::LowPriority);
+
+    m_captureTimer->setInterval(CAPTURE_INTERVAL_MS);
+    connect(m_captureTimer, &QTimer::timeout, this, &SpectrumAnalyzer::capture);
+}
+
+SpectrumAnalyzer::~SpectrumAnalyzer()
+{
+    m_thread.quit();
+    m_thread.wait();
+}
+
+void SpectrumAnalyzer::setEnabled(bool enabled)
+{
+    if (m_enabled == enabled)
+        return;
+    m_enabled = enabled;
+    if (enabled)
+        m_captureTimer->start();
+    else
+        m_captureTimer->stop();
+    emit configChanged();
+}
+
+void SpectrumAnalyzer::setChannels(const QStringList &channels)
+{
+    if (m_channels == channels)
+        return;
+    m_channels = channels;
+    emit configChanged();
+}
+
+void SpectrumAnalyzer::setFftSize(int n)
+{
+    if (!RealFft::isPowerOfTwo(n) || n < 64 || n > 4096 || n == m_fftSize)
+        return;
+    m_fftSize = n;
+    emit configChanged();
+}
+
+void SpectrumAnalyzer::setWindowSec(double sec)
+{
+    sec = qBound(1.0, sec, 120.0);
+    if (qFuzzyCompare(sec, m_windowSec))
+        return;
+    m_windowSec = sec;
+    emit configChanged();
+}
+
+double SpectrumAnalyzer::resolutionHz() const
+{
+    return m_result.fftSize > 0 ? m_result.sampleRate / m_result.fftSize : 0.0;
+}
+
+/**
+ * capture()
+ *
+ * GUI 스레드에서는 구간 복사만 한다 (20초 × 채널 4개 ≈ 8000 float).
+ * 샘플레이트는 구간 길이와 (샘플 수 + 손실 수) 로 추정.
+ */
+void SpectrumAnalyzer::capture()
+{
+    if (!m_enabled || m_busy)
+        return;
+
+    const int size = m_history->size();
+    if (size < m_fftSize)
+        return;
+
+    const int first = m_history->lowerBound(m_history->latestTime() - m_windowSec);
+    const int last = size - 1;
+    const int count = size - first;
+    if (count < m_fftSize)
+        return;
+
+    SpectrumJob job;
+    job.fftSize = m_fftSize;
+    job.channels = m_channels;
+    job.missed.resize(count);
+    int lost = 0;
+    for (int i = 0; i < count; ++i) {
+        job.missed[i] = m_history->missedAt(first + i);
+        if (i > 0)
+            lost += job.missed[i];
+    }
+
+    const double span = m_history->timeAt(last) - m_history->timeAt(first);
+    if (span <= 0)
+        return;
+    job.sampleRate = (count - 1 + lost) / span;
+
+    for (const QString &name : m_channels) {
+        QVector<float> samples;
+        const int c = m_history->channelIndex(name);
+        if (c >= 0) {
+            samples.resize(count);
+            for (int i = 0; i < count; ++i)
+                samples[i] = m_history->valueAt(c, first + i);
+        }
+        job.data.append(samples);
+    }
+
+    const int w1 = m_history->channelIndex("wheel1Rpm");
+    const int w2 = m_history->channelIndex("wheel2Rpm");
+    job.wheelRpm[0] = w1 >= 0 ? m_history->valueAt(w1, last) : 0.0;
+    job.wheelRpm[1] = w2 >= 0 ? m_history->valueAt(w2, last) : 0.0;
+
+    m_busy = true;
+    SpectrumWorker *worker = m_worker;
+    QMetaObject::invokeMethod(worker, [worker, job]() { worker->process(job); },
+                              Qt::QueuedConnection);
+}
+
+void SpectrumAnalyzer::onFinished(const SpectrumResult &result)
+{
+    m_busy = false;
+    m_result = result;
+
+    const double res = resolutionHz();
+
+    // ── 채널별 피크 (DC 빈 제외) ──
+    m_peaks.clear();
+    for (int c = 0; c < result.channels.size(); ++c) {
+        const QVector<float> &psd = result.psdDb[c];
+        if (psd.size() < 3)
+            continue;
+        int best = 1;
+        for (int k = 2; k < psd.size(); ++k)
+            if (psd[k] > psd[best])
+                best = k;
+        QVariantMap peak;
+        peak["freq"] = best * res;
+        peak["db"] = psd[best];
+        peak["segments"] = result.segments[c];
+        m_peaks[result.channels[c]] = peak;
+    }
+
+    // ── 휠 RPM 고조파 (나이퀴스트 초과분은 접힌 위치) ──
+    m_harmonics.clear();
+    const double fs = result.sampleRate;
+    for (int w = 0; w < 2 && fs > 0; ++w) {
+        const double rpm = qAbs(result.wheelRpm[w]);
+        if (rpm < 60.0)
+            continue;   // 1Hz 미만은 표시하지 않음
+        if (w == 1 && qAbs(rpm - qAbs(result.wheelRpm[0])) / 60.0 < res)
+            continue;   // 두 휠이 같은 속도면 한 번만
+        for (int order = 1; order <= HARMONIC_ORDERS; ++order) {
+            const double f = order * rpm / 60.0;
+            double folded = std::fmod(f, fs);
+            if (folded > fs / 2)
+                folded = fs - folded;
+            QVariantMap h;
+            h["wheel"] = w + 1;
+            h["order"] = order;
+            h["freq"] = folded;
+            h["trueFreq"] = f;
+            h["aliased"] = f > fs / 2;
+            m_harmonics << h;
+        }
+    }
+
+    emit spectrumChanged();
+}
+
+int SpectrumAnalyzer::updateSeries(QAbstractSeries *series, const QString &channel) const
+{
+    auto *xySeries = qobject_cast<QXYSeries *>(series);
+    const int c = m_result.channels.indexOf(channel);
+    if (!xySeries)
+        return 0;
+
+    QList<QPointF> points;
+    if (c >= 0) {
+        const QVector<float> &psd = m_result.psdDb[c];
+        const double res = resolutionHz();
+        points.reserve(psd.size());
+        for (int k = 1; k < psd.size(); ++k)
+            points.append(QPointF(k * res, psd[k]));
+    }
+    xySeries->replace(points);
+    return points.size();
+}
+
+int SpectrumAnalyzer::updateHarmonicSeries(QAbstractSeries *series, const QString &channel) const
+{
+    auto *xySeries = qobject_cast<QXYSeries *>(series);
+    const int c = m_result.channels.indexOf(channel);
+    if (!xySeries)
+        return 0;
+
+    QList<QPointF> points;
+    const double res = resolutionHz();
+    if (c >= 0 && res > 0) {
+        const QVector<float> &psd = m_result.psdDb[c];
+        for (const QVariant &v : m_harmonics) {
+            const double f = v.toMap().value("freq").toDouble();
+            const int k = qRound(f / res);
+            if (k >= 1 && k < psd.size())
+                points.append(QPointF(f, psd[k]));
+        }
+    }
+    xySeries->replace(points);
+    return points.size();
+}
@@ -0,0 +1,145 @@
+#ifndef SPECTRUMANALYZER_H
+#define SPECTRUMANALYZER_H
+
+#include <QObject>
+#include <QList>
+#include <QStringList>
+#include <QThread>
+#include <QVariantList>
+#include <QVariantMap>
+#include <QVector>
+#include <QtCharts/QAbstractSeries>
+
+#include "fft.h"
+
+class QTimer;
+class TelemetryHistory;
+
+// 워커에 넘기는 분석 입력 (히스토리 구간 복사본)
+struct SpectrumJob {
+    QStringList           channels;
+    QList<QVector<float>> data;        // [채널][샘플]
+    QVector<int>          missed;      // 샘플별 직전 손실 수 (갭 포함 세그먼트 제외용)
+    double                sampleRate = 0;
+    int                   fftSize = 256;
+    double                wheelRpm[2] = { 0, 0 };
+};
+
+// 워커 결과 (채널별 Welch PSD, dB)
+struct SpectrumResult {
+    QStringList           channels;
+    QList<QVector<float>> psdDb;       // [채널][빈], 빈 k 주파수 = k · sampleRate / fftSize
+    QVector<int>          segments;    // 채널별 평균한 세그먼트 수
+    double                sampleRate = 0;
+    int                   fftSize = 256;
+    double                wheelRpm[2] = { 0, 0 };
+};
+
+Q_DECLARE_METATYPE(SpectrumResult)
+
+/**
+ * SpectrumWorker
+ *
+ * 분석 스레드에서 동작.  Hann 창, 50% 겹침, 세그먼트 평균 제거 후
+ * Welch 평균 → 단측 PSD (단위²/Hz) 를 dB 로 변환해 돌려준다.
+ */
+class SpectrumWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    void process(const SpectrumJob &job);
+
+signals:
+    void finished(const SpectrumResult &result);
+
+private:
+    // FFT 크기가 바뀔 때만 재구성 (작업 버퍼 재사용)
+    RealFft        m_fft;
+    QVector<float> m_window;
+    QVector<float> m_segment;
+    QVector<float> m_power;
+    QVector<double> m_accum;
+    double         m_windowPower = 0;   // Σw²
+};
+
+/**
+ * SpectrumAnalyzer
+ *
+ * 플라이휠 진동(휠 RPM 고조파) 확인용 백그라운드 스펙트럼 분석.
+ *
+ *  - GUI 스레드: 250ms 마다 히스토리 최근 windowSec 구간을 복사해 워커에 전달
+ *                (이전 작업이 끝나지 않았으면 건너뜀 → 큐 누적 없음)
+ *  - 분석 스레드: FFT/Welch 계산
+ *  - QML: updateSeries() 로 스펙트럼, updateHarmonicSeries() 로 RPM 고조파 마커
+ *
+ * 고조파 주파수 = 차수 × rpm / 60.  텔레메트리 레이트(100Hz) 의 나이퀴스트를
+ * 넘는 성분은 샘플링에서 접혀(alias) 보이므로 마커도 접힌 위치에 표시한다.
+ *
+ * enabled 가 false 면 캡처/계산을 하지 않는다 (팝업이 열려 있을 때만 켬).
+ */
+class SpectrumAnalyzer : public QObject
+{
+    Q_OBJECT
+
+    Q_PROPERTY(bool        enabled      READ enabled    WRITE setEnabled    NOTIFY configChanged)
+    Q_PROPERTY(QStringList channels     READ channels   WRITE setChannels   NOTIFY configChanged)
+    Q_PROPERTY(int         fftSize      READ fftSize    WRITE setFftSize    NOTIFY configChanged)
+    Q_PROPERTY(double      windowSec    READ windowSec  WRITE setWindowSec  NOTIFY configChanged)
+    Q_PROPERTY(double      sampleRate   READ sampleRate   NOTIFY spectrumChanged)
+    Q_PROPERTY(double      resolutionHz READ resolutionHz NOTIFY spectrumChanged)
+    Q_PROPERTY(QVariantMap peaks        READ peaks        NOTIFY spectrumChanged)   // 채널 → { freq, db }
+    Q_PROPERTY(QVariantList harmonics   READ harmonics    NOTIFY spectrumChanged)   // { wheel, order, freq, trueFreq, aliased }
+
+public:
+    explicit SpectrumAnalyzer(TelemetryHistory *history, QObject *parent = nullptr);
+    ~SpectrumAnalyzer();
+
+    bool        enabled()   const { return m_enabled; }
+    QStringList channels()  const { return m_channels; }
+    int         fftSize()   const { return m_fftSize; }
+    double      windowSec() const { return m_windowSec; }
+    void setEnabled(bool enabled);
+    void setChannels(const QStringList &channels);
+    void setFftSize(int n);
+    void setWindowSec(double sec);
+
+    double       sampleRate()   const { return m_result.sampleRate; }
+    double       resolutionHz() const;
+    QVariantMap  peaks()        const { return m_peaks; }
+    QVariantList harmonics()    const { return m_harmonics; }
+
+    // 스펙트럼 (x = Hz, y = dB).  반환값: 채운 점 수
+    Q_INVOKABLE int updateSeries(QAbstractSeries *series, const QString &channel) const;
+    // 해당 채널 스펙트럼 위에 RPM 고조파 마커
+    Q_INVOKABLE int updateHarmonicSeries(QAbstractSeries *series, const QString &channel) const;
+
+signals:
+    void configChanged();
+    void spectrumChanged();
+
+private slots:
+    void capture();
+    void onFinished(const SpectrumResult &result);
+
+private:
+    static constexpr int    CAPTURE_INTERVAL_MS = 250;
+    static constexpr int    HARMONIC_ORDERS = 4;
+
+    TelemetryHistory *m_history;
+    QTimer           *m_captureTimer;
+    QThread           m_thread;
+    SpectrumWorker   *m_worker;
+    bool              m_busy = false;
+
+    bool        m_enabled = false;
+    QStringList m_channels { "gyroX", "roll", "gyroZ", "wheel1Rpm" };
+    int         m_fftSize = 256;       // 100Hz 기준 2.56초, 분해능 0.39Hz
+    double      m_windowSec = 20.0;    // 차트 표시 구간과 동일
+
+    SpectrumResult m_result;
+    QVariantMap    m_peaks;
+    QVariantList   m_harmonics;
+};
+
+#endif // SPECTRUMANALYZER_H
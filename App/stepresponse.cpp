@@ -0,0 +1,118 @@
+#include "stepresponse.h"
+
+#include <cmath>
+
+StepResponseAnalyzer::StepResponseAnalyzer(double stepThreshold)
+    : m_threshold(stepThreshold)
+{
+}
+
+void StepResponseAnalyzer::reset()
+{
+    m_hasPrev = false;
+    m_armed = false;
+    m_active = false;
+}
+
+void StepResponseAnalyzer::arm(double setpoint)
+{
+    m_armed = true;
+    m_armedSetpoint = setpoint;
+}
+
+bool StepResponseAnalyzer::addSample(double timeSec, double setpoint, double measured, Result *result)
+{
+    bool finished = false;
+
+    // ── 계단 검출 ──
+    const bool telemetryStep = m_hasPrev && qAbs(setpoint - m_prevSetpoint) >= m_threshold;
+    if (telemetryStep || m_armed) {
+        if (m_active) {
+            finish(timeSec, result);   // 이전 분석은 새 계단에서 끊는다
+            finished = true;
+        }
+        begin(timeSec, m_armed ? m_armedSetpoint : setpoint, measured);
+        m_armed = false;
+    }
+
+    // ── 누적 ──
+    if (m_active) {
+        const double t     = timeSec - m_cur.startTime;
+        const double err   = m_cur.target - measured;
+        const double absE  = qAbs(err);
+        const double dt    = timeSec - m_prevTime;
+        const double norm  = (measured - m_cur.initial) / m_amplitude;
+
+        // 사다리꼴 적분
+        if (dt > 0) {
+            m_cur.iae  += 0.5 * (absE + m_prevAbsError) * dt;
+            m_cur.itae += 0.5 * (t * absE + (t - dt) * m_prevAbsError) * dt;
+        }
+        m_prevAbsError = absE;
+        m_lastError = err;
+
+        if (m_t10 < 0 && norm >= 0.1) m_t10 = t;
+        if (m_t90 < 0 && norm >= 0.9) m_t90 = t;
+        m_maxNorm = qMax(m_maxNorm, norm);
+
+        if (absE > BAND * qAbs(m_amplitude)) {
+            m_lastOutside = t;
+            m_insideErrSum = 0;
+            m_insideCount = 0;
+        } else {
+            m_insideErrSum += err;
+            ++m_insideCount;
+        }
+
+        const bool dwellDone = m_t90 >= 0 && (t - m_lastOutside) >= SETTLE_DWELL_S;
+        if (!finished && (dwellDone || t >= MAX_WINDOW_S)) {
+            finish(timeSec, result);
+            finished = true;
+        }
+    }
+
+    m_hasPrev = true;
+    m_prevSetpoint = setpoint;
+    m_prevTime = timeSec;
+    return finished;
+}
+
+void StepResponseAnalyzer::begin(double timeSec, double setpoint, double measured)
+{
+    m_cur = Result();
+    m_cur.startTime = timeSec;
+    m_cur.initial = measured;
+    m_cur.target = setpoint;
+
+    // 작은 스텝은 크기만 하한으로 올리고 방향은 유지 (음의 스텝, 균형 분석의 목표 0)
+    m_amplitude = setpoint - measured;
+    if (qAbs(m_amplitude) < MIN_AMPLITUDE)
+        m_amplitude = std::copysign(MIN_AMPLITUDE, m_amplitude);
+
+    m_t10 = m_t90 = -1;
+    m_maxNorm = 0;
+    m_lastOutside = 0;
+    m_insideErrSum = 0;
+    m_insideCount = 0;
+    // 스텝 이전 구간이 IAE/ITAE 에 적분되지 않도록 적분 시작점을 스텝 시각으로
+    m_prevTime = timeSec;
+    m_prevAbsError = qAbs(setpoint - measured);
+    m_lastError = setpoint - measured;
+    m_active = true;
+}
+
+void StepResponseAnalyzer::finish(double timeSec, Result *result)
+{
+    m_active = false;
+
+    Result r = m_cur;
+    r.duration = timeSec - r.startTime;
+    r.riseTime = (m_t10 >= 0 && m_t90 >= 0) ? m_t90 - m_t10 : -1;
+    r.overshootPct = qMax(0.0, m_maxNorm - 1.0) * 100.0;
+    r.settled = m_t90 >= 0 && (r.duration - m_lastOutside) >= SETTLE_DWELL_S;
+    r.settlingTime = r.settled ? m_lastOutside : -1;
+    r.steadyStateError = m_insideCount > 0 ? m_insideErrSum / m_insideCount : m_lastError;
+
+    if (result)
+        *result = r;
+}
@@ -0,0 +1,79 @@
+#ifndef STEPRESPONSE_H
+#define STEPRESPONSE_H
+
+#include <QtGlobal>
+
+/**
+ * StepResponseAnalyzer
+ *
+ * 세트포인트 계단 변화 후 응답 지표를 샘플당 O(1) 로 누적 계산.
+ *
+ *  - 계단 검출: 세트포인트 변화량 ≥ threshold  (또는 arm() 으로 외부 트리거)
+ *  - 상승 시간: 정규화 응답 10% → 90% 도달 시간
+ *  - 오버슈트: 정규화 응답 최대값 - 1  (%)
+ *  - 정착 시간: |r - y| ≤ 2% |A| 를 마지막으로 벗어난 시각 기준
+ *  - 정상 상태 오차: 정착 구간(밴드 안) 평균 오차
+ *  - IAE = ∫|e|dt,  ITAE = ∫t|e|dt   (e = r - y, t 는 계단 이후 경과)
+ *
+ * 분석 종료: 밴드 안에서 SETTLE_DWELL_S 유지, 새 계단, 또는 MAX_WINDOW_S 경과.
+ */
+class StepResponseAnalyzer
+{
+public:
+    struct Result {
+        double startTime = 0;        // 계단 시각 (호스트 타임라인 s)
+        double initial = 0;          // 계단 직전 측정값
+        double target = 0;           // 새 세트포인트
+        double riseTime = -1;        // s, 미도달 시 -1
+        double overshootPct = 0;
+        double settlingTime = -1;    // s, 미정착 시 -1
+        double steadyStateError = 0;
+        double iae = 0;
+        double itae = 0;
+        double duration = 0;         // 분석 구간 길이 (s)
+        bool   settled = false;
+    };
+
+    explicit StepResponseAnalyzer(double stepThreshold = 0.5);
+
+    // 샘플 1개 반영.  분석이 끝났으면 true 와 함께 result 채움.
+    bool addSample(double timeSec, double setpoint, double measured, Result *result);
+
+    // 외부 트리거 계단 (예: 밸런싱 시작 → 목표 roll 0)
+    void arm(double setpoint);
+
+    void reset();
+    bool isActive() const { return m_active; }
+
+private:
+    void begin(double timeSec, double setpoint, double measured);
+    void finish(double timeSec, Result *result);
+
+    static constexpr double BAND          = 0.02;   // 정착 밴드 (±2%)
+    static constexpr double SETTLE_DWELL_S = 1.0;
+    static constexpr double MAX_WINDOW_S  = 10.0;
+    static constexpr double MIN_AMPLITUDE = 1e-6;
+
+    double m_threshold;
+
+    bool   m_hasPrev = false;
+    double m_prevSetpoint = 0;
+    double m_prevTime = 0;
+    double m_prevAbsError = 0;
+    double m_lastError = 0;
+
+    bool   m_armed = false;
+    double m_armedSetpoint = 0;
+
+    // ── 진행 중 분석 ──
+    bool   m_active = false;
+    Result m_cur;
+    double m_amplitude = 0;
+    double m_t10 = -1, m_t90 = -1;
+    double m_maxNorm = 0;
+    double m_lastOutside = 0;      // 밴드를 마지막으로 벗어난 시각
+    double m_insideErrSum = 0;
+    int    m_insideCount = 0;
+};
+
+#endif // STEPRESPONSE_H
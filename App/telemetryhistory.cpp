@@ -0,0 +1,224 @@
+#include "telemetryhistory.h"
+#include "tracebuffer.h"
+
+#include <QPointF>
+#include <QtCharts/QChart>
+#include <QtCharts/QLegend>
+#include <QtCharts/QLegendMarker>
+#include <QtCharts/QLineSeries>
+
+// 한 차트에 쓰는 보조 시리즈 상한.  갭이 더 많으면 나머지는 마지막 구간에 이어 그림
+static constexpr int MAX_SEGMENTS = 32;
+
+TelemetryHistory::TelemetryHistory(int capacity, QObject *parent)
+    : QObject(parent)
+    , m_capacity(qMax(1, capacity))
+    , m_time(m_capacity, 0.0)
+    , m_missed(m_capacity, 0)
+{
+}
+
+int TelemetryHistory::addChannel(const QString &name)
+{
+    const int existing = channelIndex(name);
+    if (existing >= 0)
+        return existing;
+
+    m_channelNames.append(name);
+    m_values.append(QVector<float>(m_capacity, 0.0f));
+    emit channelsChanged();
+    return m_channelNames.size() - 1;
+}
+
+int TelemetryHistory::channelIndex(const QString &name) const
+{
+    return m_channelNames.indexOf(name);
+}
+
+void TelemetryHistory::append(double timeSec, const float *values, int missedBefore)
+{
+    int slot;
+    if (m_count < m_capacity) {
+        slot = physical(m_count);
+        ++m_count;
+    } else {
+        // 가득 참 → 가장 오래된 샘플 덮어쓰기
+        slot = m_head;
+        m_head = (m_head + 1) % m_capacity;
+    }
+
+    m_time[slot] = timeSec;
+    m_missed[slot] = missedBefore;
+    for (int c = 0; c < m_values.size(); ++c)
+        m_values[c][slot] = values[c];
+}
+
+void TelemetryHistory::clear()
+{
+    m_head = 0;
+    m_count = 0;
+}
+
+/**
+ * lowerBound()
+ *
+ * timeSec 이상인 첫 샘플의 논리 인덱스 (시각은 단조 증가).
+ */
+int TelemetryHistory::lowerBound(double timeSec) const
+{
+    int lo = 0, hi = m_count;
+    while (lo < hi) {
+        const int mid = (lo + hi) / 2;
+        if (timeAt(mid) < timeSec)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+double TelemetryHistory::latestTime() const
+{
+    return m_count > 0 ? timeAt(m_count - 1) : 0.0;
+}
+
+/**
+ * updateSeries()
+ *
+ * 갭(missedAt > 0 인 재개 샘플) 마다 구간을 나눠 첫 구간은 series 에, 이후 구간은
+ * 보조 시리즈에 채운다.  QLineSeries 는 NaN 점을 무시할 뿐 선을 끊지 않으므로
+ * 끊긴 선은 시리즈를 나눠서 그린다.  쓰지 않는 보조 시리즈는 비워 둔다.
+ */
+int TelemetryHistory::updateSeries(QAbstractSeries *series, const QString &channel,
+                                   double origin, double fromTime, double toTime,
+                                   int maxPoints)
+{
+    auto *xySeries = qobject_cast<QXYSeries *>(series);
+    const int c = channelIndex(channel);
+    if (!xySeries || c < 0)
+        return 0;
+    TRACE_SCOPE(TraceBuffer::Chart, c, maxPoints);
+
+    const int first = lowerBound(fromTime);
+    const int last  = lowerBound(toTime + 1e-9);   // exclusive
+    const int n = last - first;
+
+    // 버킷별 min/max (시간 순서 유지) → 피크 손실 없이 점 수 제한.  버킷 1 = 전체 점
+    const int bucket = (maxPoints <= 0 || n <= maxPoints * 2) ? 1 : (n + maxPoints - 1) / maxPoints;
+
+    // 갭 직전까지가 한 구간.  차트 밖이거나 보조 시리즈 상한을 넘으면 이어 그림
+    const bool split = xySeries->chart() != nullptr;
+    QList<QPointF> points;
+    int filled = 0;             // 채운 시리즈 수 (0 = series, 1.. = 보조)
+    int total = 0;
+    int runStart = first;
+    for (int i = first + 1; i <= last; ++i) {
+        if (i < last && (!split || missedAt(i) <= 0 || filled >= MAX_SEGMENTS))
+            continue;
+
+        QXYSeries *target = filled == 0 ? xySeries : segmentSeries(xySeries, filled - 1);
+        points.clear();
+        appendPoints(points, c, runStart, i, bucket, origin);
+        target->replace(points);
+        total += points.size();
+        ++filled;
+        runStart = i;
+    }
+    if (filled == 0)
+        xySeries->clear();
+
+    // 이전 갱신에서 쓰였던 나머지 보조 시리즈 비우기
+    const QList<QPointer<QXYSeries>> segments = m_segments.value(xySeries);
+    for (int s = qMax(0, filled - 1); s < segments.size(); ++s) {
+        if (segments.at(s) && segments.at(s)->count() > 0)
+            segments.at(s)->clear();
+    }
+    return total;
+}
+
+void TelemetryHistory::clearSeries(QAbstractSeries *series)
+{
+    auto *xySeries = qobject_cast<QXYSeries *>(series);
+    if (!xySeries)
+        return;
+
+    xySeries->clear();
+    const QList<QPointer<QXYSeries>> segments = m_segments.value(xySeries);
+    for (const QPointer<QXYSeries> &segment : segments) {
+        if (segment)
+            segment->clear();
+    }
+}
+
+// 샘플 [begin, end) 를 버킷별 min/max 로 points 에 추가
+void TelemetryHistory::appendPoints(QList<QPointF> &points, int channel, int begin, int end,
+                                    int bucket, double origin) const
+{
+    for (int b = begin; b < end; b += bucket) {
+        const int bucketEnd = qMin(end, b + bucket);
+        int iMin = b, iMax = b;
+        for (int i = b + 1; i < bucketEnd; ++i) {
+            if (valueAt(channel, i) < valueAt(channel, iMin)) iMin = i;
+            if (valueAt(channel, i) > valueAt(channel, iMax)) iMax = i;
+        }
+        const int i1 = qMin(iMin, iMax), i2 = qMax(iMin, iMax);
+        points.append(QPointF(timeAt(i1) - origin, valueAt(channel, i1)));
+        if (i2 != i1)
+            points.append(QPointF(timeAt(i2) - origin, valueAt(channel, i2)));
+    }
+}
+
+/**
+ * segmentSeries()
+ *
+ * series 의 index 번째 보조 시리즈.  처음 쓰일 때 같은 차트에 추가하고 축·펜을
+ * 그대로 붙이며 범례에서는 숨긴다.  series 가 삭제되면 목록도 정리.
+ * series 는 차트에 붙어 있어야 함.
+ */
+QXYSeries *TelemetryHistory::segmentSeries(QXYSeries *series, int index)
+{
+    QChart *chart = series->chart();
+
+    if (!m_segments.contains(series)) {
+        connect(series, &QObject::destroyed, this, [this, series]() {
+            m_segments.remove(series);
+        });
+    }
+
+    QList<QPointer<QXYSeries>> &segments = m_segments[series];
+    if (segments.size() <= index)
+        segments.resize(index + 1);
+    if (!segments.at(index)) {
+        auto *segment = new QLineSeries();
+        chart->addSeries(segment);
+        const QList<QAbstractAxis *> axes = series->attachedAxes();
+        for (QAbstractAxis *axis : axes)
+            segment->attachAxis(axis);
+        segment->setPen(series->pen());
+        const QList<QLegendMarker *> markers = chart->legend()->markers(segment);
+        for (QLegendMarker *marker : markers)
+            marker->setVisible(false);
+        segments[index] = segment;
+    }
+    return segments.at(index);
+}
+
+int TelemetryHistory::updateGapSeries(QAbstractSeries *series, const QString &channel,
+                                      double origin, double fromTime, double toTime) const
+{
+    auto *xySeries = qobject_cast<QXYSeries *>(series);
+    const int c = channelIndex(channel);
+    if (!xySeries || c < 0)
+        return 0;
+
+    // 갭 직후(재개) 샘플 위치에 마커
+    QList<QPointF> points;
+    const int last = lowerBound(toTime + 1e-9);
+    for (int i = lowerBound(fromTime); i < last; ++i) {
+        if (missedAt(i) > 0)
+            points.append(QPointF(timeAt(i) - origin, valueAt(c, i)));
+    }
+
+    xySeries->replace(points);
+    return points.size();
+}
@@ -0,0 +1,85 @@
+#ifndef TELEMETRYHISTORY_H
+#define TELEMETRYHISTORY_H
+
+#include <QObject>
+#include <QHash>
+#include <QList>
+#include <QPointer>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QtCharts/QAbstractSeries>
+#include <QtCharts/QXYSeries>
+
+/**
+ * TelemetryHistory
+ *
+ * 풀레이트(100Hz) 텔레메트리 링버퍼.  채널은 이름으로 등록 (float 배열 1개씩),
+ * 샘플마다 호스트 타임라인 시각(s)과 "직전 갭에서 손실된 패킷 수"를 함께 저장.
+ *
+ * 차트는 디스플레이 주기마다 updateSeries() 로 구간을 통째로 교체(QXYSeries::replace)
+ * 하므로 QML 에서 append/remove(0) 를 반복할 필요가 없다.
+ * 갭에서는 선을 끊고 (보조 시리즈로 분할), 재개 지점은 updateGapSeries() 로 별도 마커 시리즈에 표시.
+ */
+class TelemetryHistory : public QObject
+{
+    Q_OBJECT
+
+    Q_PROPERTY(QStringList channels READ channelNames NOTIFY channelsChanged)
+
+public:
+    explicit TelemetryHistory(int capacity, QObject *parent = nullptr);
+
+    // ── 채널 등록 ──
+    int addChannel(const QString &name);
+    int channelIndex(const QString &name) const;
+    int channelCount() const { return m_channelNames.size(); }
+    QStringList channelNames() const { return m_channelNames; }
+
+    // ── 수집 (values 는 channelCount() 개) ──
+    void append(double timeSec, const float *values, int missedBefore);
+    void clear();
+
+    // ── 조회 (i = 0 이 가장 오래된 샘플) ──
+    int    size() const { return m_count; }
+    double timeAt(int i) const { return m_time[physical(i)]; }
+    float  valueAt(int channel, int i) const { return m_values[channel][physical(i)]; }
+    int    missedAt(int i) const { return m_missed[physical(i)]; }
+    int    lowerBound(double timeSec) const;
+
+    // ── QML: 차트 갱신 ──
+    // [fromTime, toTime] 구간을 x = t - origin 으로 시리즈에 채운다.
+    // maxPoints > 0 이면 버킷별 min/max 로 솎아낸다. 반환값: 채운 점 수
+    // 갭 뒤 구간은 같은 차트·축·펜의 보조 시리즈에 채워 갭을 가로지르는 직선이 없다.
+    Q_INVOKABLE int updateSeries(QAbstractSeries *series, const QString &channel,
+                                 double origin, double fromTime, double toTime,
+                                 int maxPoints = 0);
+    // series 와 그 보조 시리즈를 모두 비운다 (초기화용)
+    Q_INVOKABLE void clearSeries(QAbstractSeries *series);
+    Q_INVOKABLE int updateGapSeries(QAbstractSeries *series, const QString &channel,
+                                    double origin, double fromTime, double toTime) const;
+    Q_INVOKABLE double latestTime() const;
+
+signals:
+    void channelsChanged();
+
+private:
+    int physical(int i) const { return (m_head + i) % m_capacity; }
+    void appendPoints(QList<QPointF> &points, int channel, int begin, int end,
+                      int bucket, double origin) const;
+    QXYSeries *segmentSeries(QXYSeries *series, int index);
+
+    int m_capacity;
+    int m_head = 0;      // 가장 오래된 샘플의 물리 인덱스
+    int m_count = 0;
+
+    QStringList            m_channelNames;
+    QVector<double>        m_time;
+    QVector<qint32>        m_missed;
+    QList<QVector<float>>  m_values;
+
+    // 차트 시리즈 → 갭 뒤 구간용 보조 시리즈 (필요할 때 생성, 재사용)
+    QHash<QXYSeries *, QList<QPointer<QXYSeries>>> m_segments;
+};
+
+#endif // TELEMETRYHISTORY_H
@@ -0,0 +1,107 @@
+#include "telemetrystats.h"
+#include "telemetryhistory.h"
+
+#include <QTimer>
+
+TelemetryStats::TelemetryStats(TelemetryHistory *history, const QStringList &channels,
+                               const QList<double> &windowsSec, QObject *parent)
+    : QObject(parent)
+    , m_history(history)
+    , m_channels(channels)
+    , m_windows(windowsSec)
+    , m_publishTimer(new QTimer(this))
+{
+    for (const QString &name : channels) {
+        m_sourceIndex.append(history->channelIndex(name));
+
+        QList<SlidingStats> perWindow;
+        for (double w : windowsSec) {
+            // 공칭 레이트 기준 용량 + 25% 여유 (지터/버스트)
+            const int capacity = int(w * NOMINAL_RATE_HZ * 1.25) + 16;
+            perWindow.append(SlidingStats(w, capacity));
+        }
+        m_stats.append(perWindow);
+    }
+
+    m_publishTimer->setInterval(PUBLISH_INTERVAL_MS);
+    connect(m_publishTimer, &QTimer::timeout, this, &TelemetryStats::publish);
+    m_publishTimer->start();
+}
+
+void TelemetryStats::update()
+{
+    const int last = m_history->size() - 1;
+    if (last < 0)
+        return;
+
+    const double t = m_history->timeAt(last);
+    for (int c = 0; c < m_channels.size(); ++c) {
+        const int src = m_sourceIndex[c];
+        if (src < 0)
+            continue;
+        const double value = m_history->valueAt(src, last);
+        for (SlidingStats &s : m_stats[c])
+            s.add(t, value);
+    }
+    m_dirty = true;
+}
+
+void TelemetryStats::clear()
+{
+    for (QList<SlidingStats> &perWindow : m_stats)
+        for (SlidingStats &s : perWindow)
+            s.clear();
+    m_dirty = true;
+}
+
+QVariantList TelemetryStats::windows() const
+{
+    QVariantList list;
+    for (double w : m_windows)
+        list << w;
+    return list;
+}
+
+QVariantMap TelemetryStats::channel(const QString &name, double windowSec) const
+{
+    const int c = m_channels.indexOf(name);
+    const int w = m_windows.indexOf(windowSec);
+    if (c < 0 || w < 0)
+        return {};
+    return toMap(m_stats[c][w]);
+}
+
+void TelemetryStats::publish()
+{
+    if (!m_dirty)
+        return;
+    m_dirty = false;
+
+    QVariantMap snapshot;
+    for (int c = 0; c < m_channels.size(); ++c) {
+        QVariantMap perWindow;
+        for (int w = 0; w < m_windows.size(); ++w)
+            perWindow[windowKey(m_windows[w])] = toMap(m_stats[c][w]);
+        snapshot[m_channels[c]] = perWindow;
+    }
+    m_snapshot = snapshot;
+    emit snapshotChanged();
+}
+
+QVariantMap TelemetryStats::toMap(const SlidingStats &s)
+{
+    QVariantMap m;
+    m["count"] = s.count();
+    m["mean"]  = s.mean();
+    m["rms"]   = s.rms();
+    m["std"]   = s.stddev();
+    m["min"]   = s.min();
+    m["max"]   = s.max();
+    m["p2p"]   = s.peakToPeak();
+    return m;
+}
+
+QString TelemetryStats::windowKey(double windowSec)
+{
+    return QString::number(windowSec, 'g', 6);
+}
@@ -0,0 +1,71 @@
+#ifndef TELEMETRYSTATS_H
+#define TELEMETRYSTATS_H
+
+#include <QObject>
+#include <QList>
+#include <QStringList>
+#include <QVariantList>
+#include <QVariantMap>
+#include <QVector>
+
+#include "rollingstats.h"
+
+class QTimer;
+class TelemetryHistory;
+
+/**
+ * TelemetryStats
+ *
+ * 채널 × 시간 창(1/5/20/30초) 슬라이딩 통계 엔진.
+ * 풀레이트로 update() (히스토리 최신 샘플 1개 반영, 샘플당 O(1)),
+ * QML 에는 디스플레이 주기(100ms)로 snapshot 만 갱신해서 알린다.
+ *
+ * snapshot 구조:  { "<채널>": { "<창 초>": { count, mean, rms, std, min, max, p2p } } }
+ * 20초 창은 차트 표시 구간과 같아서 Y축 자동 스케일(확대·축소)에 사용.
+ */
+class TelemetryStats : public QObject
+{
+    Q_OBJECT
+
+    Q_PROPERTY(QVariantMap  snapshot READ snapshot NOTIFY snapshotChanged)
+    Q_PROPERTY(QStringList  channels READ channels CONSTANT)
+    Q_PROPERTY(QVariantList windows  READ windows  CONSTANT)
+
+public:
+    TelemetryStats(TelemetryHistory *history, const QStringList &channels,
+                   const QList<double> &windowsSec, QObject *parent = nullptr);
+
+    void update();      // 히스토리에 방금 추가된 샘플 반영
+    void clear();
+
+    QVariantMap  snapshot() const { return m_snapshot; }
+    QStringList  channels() const { return m_channels; }
+    QVariantList windows()  const;
+
+    Q_INVOKABLE QVariantMap channel(const QString &name, double windowSec) const;
+
+signals:
+    void snapshotChanged();
+
+private slots:
+    void publish();
+
+private:
+    static QVariantMap toMap(const SlidingStats &s);
+    static QString windowKey(double windowSec);
+
+    static constexpr double NOMINAL_RATE_HZ = 100.0;
+    static constexpr int    PUBLISH_INTERVAL_MS = 100;
+
+    TelemetryHistory *m_history;
+    QStringList       m_channels;
+    QList<double>     m_windows;
+    QVector<int>      m_sourceIndex;     // 채널 → 히스토리 채널 인덱스
+    QList<QList<SlidingStats>> m_stats;  // [채널][창]
+
+    QTimer     *m_publishTimer;
+    bool        m_dirty = false;
+    QVariantMap m_snapshot;
+};
+
+#endif // TELEMETRYSTATS_H
@@ -0,0 +1,117 @@
+#include "portopener.h"
+
+#include <QSignalSpy>
+#include <QtTest>
+
+#include <fcntl.h>
+#include <pty.h>
+#include <termios.h>
+#include <unistd.h>
+
+/**
+ * tst_PortOpener
+ *
+ * pty 슬레이브를 I/O 스레드에서 열기.  결과는 호출 스레드로 큐잉되고,
+ * 취소/대체된 요청의 결과는 전달되지 않음.
+ */
+class tst_PortOpener : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+    void opensOnWorkerThread();
+    void missingDeviceReportsError();
+    void cancelledRequestIsDropped();
+    void newerRequestWins();
+
+private:
+    int     m_master = -1;
+    QString m_path;
+};
+
+void tst_PortOpener::init()
+{
+    int slave = -1;
+    char name[128] = {};
+    QVERIFY(::openpty(&m_master, &slave, name, nullptr, nullptr) == 0);
+    ::close(slave);
+    m_path = QString::fromLocal8Bit(name);
+}
+
+void tst_PortOpener::cleanup()
+{
+    if (m_master >= 0)
+        ::close(m_master);
+    m_master = -1;
+}
+
+void tst_PortOpener::opensOnWorkerThread()
+{
+    PortOpener opener;
+    QSignalSpy finished(&opener, &PortOpener::finished);
+    opener.open(m_path, 115200, false);
+    QVERIFY(opener.isPending());
+    QVERIFY(finished.wait(1000));
+    QVERIFY(!opener.isPending());
+
+    const PortOpenResult result = finished.first().at(0).value<PortOpenResult>();
+    QVERIFY2(result.ok(), qPrintable(result.error));
+    QCOMPARE(result.portName, m_path);
+    QVERIFY(result.fd >= 0);
+
+    // QSerialPort::open() 과 같은 설정 → 이어지는 open 의 tcsetattr 가 바꿀 것이 없음
+    termios tio;
+    QVERIFY(::tcgetattr(result.fd, &tio) == 0);
+    QCOMPARE(::cfgetospeed(&tio), speed_t(B115200));
+    QCOMPARE(tio.c_cflag & CSIZE, tcflag_t(CS8));
+    QVERIFY(!(tio.c_lflag & ICANON));
+    QVERIFY(!(tio.c_cflag & (PARENB | CSTOPB | CRTSCTS)));
+    QVERIFY(::fcntl(result.fd, F_GETFL) & O_NONBLOCK);
+
+    opener.release(result);
+}
+
+void tst_PortOpener::missingDeviceReportsError()
+{
+    PortOpener opener;
+    QSignalSpy finished(&opener, &PortOpener::finished);
+    opener.open("/dev/no-such-tty", 115200, false);
+    QVERIFY(finished.wait(1000));
+
+    const PortOpenResult result = finished.first().at(0).value<PortOpenResult>();
+    QVERIFY(!result.ok());
+    QCOMPARE(result.fd, -1);
+}
+
+void tst_PortOpener::cancelledRequestIsDropped()
+{
+    PortOpener opener;
+    QSignalSpy finished(&opener, &PortOpener::finished);
+    opener.open(m_path, 115200, false);
+    opener.cancel();
+    QVERIFY(!opener.isPending());
+    QTest::qWait(100);
+    QCOMPARE(finished.count(), 0);
+}
+
+void tst_PortOpener::newerRequestWins()
+{
+    PortOpener opener;
+    QSignalSpy finished(&opener, &PortOpener::finished);
+    opener.open("/dev/no-such-tty", 115200, false);
+    opener.open(m_path, 921600, false);
+    QVERIFY(finished.wait(1000));
+    QTest::qWait(50);
+    QCOMPARE(finished.count(), 1);
+
+    const PortOpenResult result = finished.first().at(0).value<PortOpenResult>();
+    QVERIFY2(result.ok(), qPrintable(result.error));
+    QCOMPARE(result.baudRate, 921600);
+    opener.release(result);
+}
+
+QTEST_GUILESS_MAIN(tst_PortOpener)
+
+#include "tst_portopener.moc"
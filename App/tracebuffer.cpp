@@ -0,0 +1,183 @@
+#include "tracebuffer.h"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QMutex>
+#include <QThread>
+#include <QVector>
+#include <chrono>
+#include <vector>
+
+std::atomic<bool> TraceBuffer::s_enabled { false };
+
+namespace {
+
+// 스레드 하나의 링.  스레드가 끝나도 해제하지 않음 (내보내기에서 계속 읽을 수 있도록, 스레드 수만큼만 존재)
+struct ThreadRing {
+    TraceBuffer::Record  *records = nullptr;
+    std::atomic<quint64>  head { 0 };      // 다음에 쓸 위치 (누적)
+    std::atomic<quint64>  base { 0 };      // clear() 시점의 head
+    int                   tid = 0;
+    QString               name;
+};
+
+QMutex                   g_registryMutex;    // 링 등록/내보내기에서만 사용
+std::vector<ThreadRing *> g_rings;
+thread_local ThreadRing  *t_ring = nullptr;
+
+const auto g_epoch = std::chrono::steady_clock::now();
+
+quint64 nowNs()
+{
+    return quint64(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::steady_clock::now() - g_epoch).count());
+}
+
+ThreadRing *registerThread()
+{
+    auto *ring = new ThreadRing;
+    ring->records = new TraceBuffer::Record[TraceBuffer::CAPACITY];
+
+    QThread *thread = QThread::currentThread();
+    const bool isMain = QCoreApplication::instance() && thread == QCoreApplication::instance()->thread();
+    ring->name = isMain ? QStringLiteral("main") : thread->objectName();
+
+    QMutexLocker lock(&g_registryMutex);
+    ring->tid = int(g_rings.size()) + 1;
+    if (ring->name.isEmpty())
+        ring->name = QString("thread %1").arg(ring->tid);
+    g_rings.push_back(ring);
+    return ring;
+}
+
+} // namespace
+
+void TraceBuffer::setEnabled(bool on)
+{
+    s_enabled.store(on, std::memory_order_relaxed);
+}
+
+void TraceBuffer::record(Event event, Phase phase, qint64 arg0, qint64 arg1)
+{
+    if (!enabled())
+        return;
+
+    ThreadRing *ring = t_ring;
+    if (!ring)
+        ring = t_ring = registerThread();
+
+    const quint64 h = ring->head.load(std::memory_order_relaxed);
+    Record &r = ring->records[h & (CAPACITY - 1)];
+    r.ns = nowNs();
+    r.arg0 = arg0;
+    r.arg1 = arg1;
+    r.event = event;
+    r.phase = phase;
+    ring->head.store(h + 1, std::memory_order_release);
+}
+
+void TraceBuffer::clear()
+{
+    QMutexLocker lock(&g_registryMutex);
+    for (ThreadRing *ring : g_rings)
+        ring->base.store(ring->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+}
+
+qint64 TraceBuffer::recordCount()
+{
+    QMutexLocker lock(&g_registryMutex);
+    qint64 total = 0;
+    for (ThreadRing *ring : g_rings) {
+        const quint64 h = ring->head.load(std::memory_order_acquire);
+        const quint64 b = ring->base.load(std::memory_order_relaxed);
+        total += qint64(qMin<quint64>(h - b, CAPACITY));
+    }
+    return total;
+}
+
+const char *TraceBuffer::eventName(quint16 event)
+{
+    static const char *const names[EventCount] = {
+        "read", "frame", "parse", "notify", "record", "chart", "spectrum", "ascii",
+    };
+    return event < EventCount ? names[event] : "?";
+}
+
+/**
+ * exportChromeJson()
+ *
+ * {"traceEvents":[...]} — ph B/E/i, ts 는 µs (소수점 아래 ns).
+ * 스레드마다 현재 링을 복사한 뒤 head 를 다시 읽어, 복사 중 덮어쓰였을 수 있는
+ * 가장 오래된 구간은 버림.  앞쪽이 잘려 짝이 없는 E 도 버림.
+ */
+bool TraceBuffer::exportChromeJson(const QString &filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+
+    const qint64 pid = QCoreApplication::applicationPid();
+    QByteArray out;
+    out.reserve(1 << 20);
+    out += "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true;
+    auto separator = [&]() {
+        if (!first)
+            out += ",\n";
+        first = false;
+    };
+
+    QMutexLocker lock(&g_registryMutex);
+    QVector<Record> copy;
+    for (ThreadRing *ring : g_rings) {
+        separator();
+        out += "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":" + QByteArray::number(pid)
+             + ",\"tid\":" + QByteArray::number(ring->tid)
+             + ",\"args\":{\"name\":\"" + ring->name.toUtf8() + "\"}}";
+
+        const quint64 h = ring->head.load(std::memory_order_acquire);
+        const quint64 b = ring->base.load(std::memory_order_relaxed);
+        quint64 start = qMax(b, h > quint64(CAPACITY) ? h - CAPACITY : 0);
+        copy.resize(int(h - start));
+        for (quint64 i = start; i < h; ++i)
+            copy[int(i - start)] = ring->records[i & (CAPACITY - 1)];
+
+        const quint64 h2 = ring->head.load(std::memory_order_acquire);
+        const quint64 safe = h2 > quint64(CAPACITY) ? h2 - CAPACITY : 0;
+        const int skip = start < safe ? int(qMin(safe, h) - start) : 0;
+
+        int depth = 0;
+        for (int i = skip; i < copy.size(); ++i) {
+            const Record &r = copy[i];
+            if (r.phase == End) {
+                if (depth == 0)
+                    continue;
+                --depth;
+            } else if (r.phase == Begin) {
+                ++depth;
+            }
+
+            separator();
+            out += "{\"ph\":\"";
+            out += char(r.phase);
+            out += "\",\"name\":\"";
+            out += eventName(r.event);
+            out += "\",\"pid\":" + QByteArray::number(pid)
+                 + ",\"tid\":" + QByteArray::number(ring->tid)
+                 + ",\"ts\":" + QByteArray::number(r.ns / 1000) + "."
+                 + QByteArray::number(r.ns % 1000).rightJustified(3, '0');
+            if (r.phase == Begin || r.phase == Instant)
+                out += ",\"args\":{\"a0\":" + QByteArray::number(r.arg0)
+                     + ",\"a1\":" + QByteArray::number(r.arg1) + "}";
+            out += "}";
+
+            if (out.size() > (1 << 20) - 256) {
+                file.write(out);
+                out.clear();
+            }
+        }
+    }
+    out += "]}\n";
+    file.write(out);
+    return file.error() == QFileDevice::NoError;
+}
@@ -0,0 +1,97 @@
+#ifndef TRACEBUFFER_H
+#define TRACEBUFFER_H
+
+#include <QString>
+#include <QtGlobal>
+#include <atomic>
+
+/**
+ * TraceBuffer
+ *
+ * 스레드별 lock-free 바이너리 트레이스 링 (프로파일링용, qWarning 대체).
+ *  - 레코드: 32바이트 고정 { ns 타임스탬프, 이벤트 ID, 단계(B/E/I), 인자 2개 }
+ *  - 각 스레드는 자기 링에만 쓰고 (단일 생산자) head 를 release 로 공개
+ *  - 링은 스레드의 첫 기록 때 한 번 할당, 이후 할당 없음 (꺼져 있으면 할당 자체가 없음)
+ *  - 꺼져 있을 때 비용: relaxed atomic load 1회 + 분기
+ *  - exportChromeJson(): 모든 스레드 링을 Chrome trace JSON 으로 (Perfetto / chrome://tracing)
+ *
+ * 사용: TRACE_SCOPE(TraceBuffer::Parse, arg0, arg1);
+ */
+class TraceBuffer
+{
+public:
+    enum Event : quint16 {
+        Read,           // onReadyRead           (arg0: 읽은 바이트, arg1: 버퍼 크기)
+        Frame,          // processBuffer          (arg0: 버퍼 크기)
+        Parse,          // parseTelemetryPacket   (arg0: 패킷 번호)
+        Notify,         // telemetryUpdated 발행
+        Record,         // CSV 한 줄 기록
+        Chart,          // 차트 시리즈 교체       (arg0: 채널, arg1: 점 수)
+        Spectrum,       // 스펙트럼 분석 (분석 스레드)
+        Ascii,          // ASCII 라인 처리        (arg0: 바이트)
+        EventCount
+    };
+
+    enum Phase : quint8 { Begin = 'B', End = 'E', Instant = 'i' };
+
+    struct Record {
+        quint64 ns;
+        qint64  arg0;
+        qint64  arg1;
+        quint16 event;
+        quint8  phase;
+        quint8  reserved[5];
+    };
+    static_assert(sizeof(Record) == 32, "TraceBuffer::Record layout");
+
+    static constexpr int CAPACITY = 1 << 15;   // 스레드당 32768 레코드 (1 MB)
+
+    static bool enabled() { return s_enabled.load(std::memory_order_relaxed); }
+    static void setEnabled(bool on);
+
+    static void record(Event event, Phase phase, qint64 arg0 = 0, qint64 arg1 = 0);
+    static void clear();
+
+    // 기록된 레코드 수 (전 스레드 합, 링 용량으로 잘림)
+    static qint64 recordCount();
+    static bool exportChromeJson(const QString &filePath);
+
+    static const char *eventName(quint16 event);
+
+private:
+    static std::atomic<bool> s_enabled;
+};
+
+/**
+ * TraceScope
+ *
+ * 생성 시 Begin, 소멸 시 End.  생성 시점에 꺼져 있으면 End 도 기록하지 않음
+ * (중간에 켜져도 B/E 짝이 깨지지 않도록).
+ */
+class TraceScope
+{
+public:
+    TraceScope(TraceBuffer::Event event, qint64 arg0 = 0, qint64 arg1 = 0)
+        : m_event(event), m_active(TraceBuffer::enabled())
+    {
+        if (m_active)
+            TraceBuffer::record(event, TraceBuffer::Begin, arg0, arg1);
+    }
+    ~TraceScope()
+    {
+        if (m_active)
+            TraceBuffer::record(m_event, TraceBuffer::End);
+    }
+    TraceScope(const TraceScope &) = delete;
+    TraceScope &operator=(const TraceScope &) = delete;
+
+private:
+    TraceBuffer::Event m_event;
+    bool m_active;
+};
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b)  TRACE_CONCAT_(a, b)
+#define TRACE_SCOPE(...)    TraceScope TRACE_CONCAT(traceScope_, __LINE__)(__VA_ARGS__)
+
+#endif // TRACEBUFFER_H
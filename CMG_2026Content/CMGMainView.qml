@@ -35,8 +35,11 @@ Rectangle {
     property real gimbalVelocityValue: 0.0
     property real torqueValue: 0.0
     property int timeIndex: 0
+    property real timeOrigin: -1     // 차트 t=0 에 해당하는 호스트 타임라인 시각 (s)
+    property real lastPlotTime: -1
     property bool isRunning: false
     property int maxPoints: 200
+    property string spectrumChannel: "gyroX"
 
     property bool lampGimbalMotor: false
     property bool lampAngleSensor: false
@@ -57,7 +60,7 @@ Rectangle {
                 portField.text = ports[ports.length - 1]
             }
             console.log("Auto-connect:", portField.text, baudField.text)
-            serialManager.connectPort(portField.text, Number(baudField.text))
+            serialManager.connectPort(portField.text, Number(baudField.text) || 0)
         }
     }
 
@@ -69,87 +72,88 @@ Rectangle {
             root.gimbalAngleValue = serialManager.gimbalAngle
             root.rollVelocityValue = serialManager.gyroX
             root.gimbalVelocityValue = serialManager.gimbalVelocity
-            root.torqueValue = (serialManager.wheel1Rpm / 1000.0) * serialManager.gimbalVelocity
+            root.torqueValue = serialManager.torque   // 파생 채널 (C++ 에서 평가)
             root.lampAngleSensor = (serialManager.commBits & 0x01) !== 0
             root.lampRPM1Sensor  = (serialManager.commBits & 0x02) !== 0
             root.lampRPM2Sensor  = (serialManager.commBits & 0x04) !== 0
             root.lampWheelMotor  = (serialManager.commBits & 0x08) !== 0
             root.lampGimbalMotor = (serialManager.commBits & 0x10) !== 0
             root.lampMainLoop    = (serialManager.commBits & 0x20) !== 0
-            root.lampStable      = Math.abs(serialManager.roll) < 2.0
+            root.lampStable      = !serialManager.alarms.isActive("roll_unstable")   // C++ 알람 (히스테리시스)
             root.lampStandard    = serialManager.balancing
             root.lampPerformance = serialManager.wheelState === 1
         }
-        function onLogReceived(message) {
-            var formatted = formatLog(message)
-            console.log("SerialLog:", formatted)
-            classifyAndAppend(message)
-        }
     }
 
-    // ── RPM 명령 디바운스 (R 명령) ──
-    Timer {
-        id: rpmSendTimer; interval: 300
-        onTriggered: {
-            if (serialManager && serialManager.connected) {
-                var rpm = Number(rpmField.text)
-                serialManager.sendRPM(rpm)
-                appendToLog(rpmLogModel, "TX: R" + rpm)
-            }
-        }
-    }
+    // TX 로그 시각 기준 = 차트 t=0 (로그 분류/포맷은 C++ LogRouter)
+    onTimeOriginChanged: if (serialManager) serialManager.logs.timeOrigin = Math.max(0, timeOrigin)
 
-    // ── PID 명령 디바운스 (K 명령) ──
-    Timer {
-        id: pidSendTimer; interval: 500
-        onTriggered: {
-            if (serialManager && serialManager.connected) {
-                var kp = Number(kpField.text), ki = Number(kiField.text)
-                var kd = Number(kdField.text), g = Number(gainField.text)
-                serialManager.setBalancingPID(kp, ki, kd, g)
-                appendToLog(pidLogModel, "TX: K" + kp + "," + ki + "," + kd + "," + g)
-            }
-        }
+    // ── RPM/PID 세트포인트 송신 (병합/속도 제한은 C++ 송신 큐가 담당) ──
+    function sendRpm() {
+        if (serialManager && serialManager.connected)
+            serialManager.sendRPM(Number(rpmField.text))
+    }
+    function sendPid() {
+        if (serialManager && serialManager.connected)
+            serialManager.setBalancingPID(Number(kpField.text), Number(kiField.text),
+                                          Number(kdField.text), Number(gainField.text))
     }
 
-    // Y축 자동 스케일
-    function autoScaleY(axis, value) {
-        var margin = Math.max(Math.abs(axis.max - axis.min) * 0.1, 0.1)
-        if (value > axis.max) axis.max = value + margin
-        if (value < axis.min) axis.min = value - margin
+    // Y축 자동 스케일: 표시 구간(20초 창) min/max 에 맞춰 확대·축소
+    function fitAxis(axis, channel, minSpan) {
+        if (!serialManager) return
+        var ch = serialManager.stats.snapshot[channel]
+        if (!ch || ch["20"].count === 0) return
+        var lo = ch["20"].min, hi = ch["20"].max
+        var span = Math.max(hi - lo, minSpan)
+        var mid = (hi + lo) / 2
+        axis.min = mid - span * 0.55
+        axis.max = mid + span * 0.55
     }
 
     Timer {
         id: dataTimer
         interval: 100; running: root.isRunning; repeat: true
         onTriggered: {
-            var t = timeIndex * 0.1
-            rollAngleSeries.append(t, rollAngleValue)
-            gimbalAngleSeries.append(t, gimbalAngleValue)
-            rollVelocitySeries.append(t, rollVelocityValue)
-            gimbalVelocitySeries.append(t, gimbalVelocityValue)
-            torqueSeries.append(t, torqueValue)
-            autoScaleY(rollAngleAxisY, rollAngleValue)
-            autoScaleY(gimbalAngleAxisY, gimbalAngleValue)
-            autoScaleY(rollVelAxisY, rollVelocityValue)
-            autoScaleY(gimbalVelAxisY, gimbalVelocityValue)
-            autoScaleY(torqueAxisY, torqueValue)
-            if (rollAngleSeries.count > maxPoints) {
-                rollAngleSeries.remove(0); gimbalAngleSeries.remove(0)
-                rollVelocitySeries.remove(0); gimbalVelocitySeries.remove(0)
-                torqueSeries.remove(0)
+            // 호스트 타임라인 기준 시각: 연결 중이면 최신 패킷의 동기 시각, 아니면 현재 시각
+            var now = serialManager ? (serialManager.connected ? serialManager.telemetryTime
+                                                               : serialManager.hostTime())
+                                    : timeIndex * 0.1
+            if (timeOrigin < 0) timeOrigin = now
+            var t = now - timeOrigin
+            timeIndex++
+            dateTimeLabel.text = Qt.formatDateTime(new Date(), "yyyy-MM-dd hh:mm:ss")
+            if (t <= lastPlotTime) return   // 새 패킷 없음 → 중복 점 생략
+            lastPlotTime = t
+            if (serialManager) {
+                // 풀레이트 히스토리에서 표시 구간(최근 20초)을 통째로 교체, 갭은 마커로 표시
+                var from = Math.max(timeOrigin, now - 20)
+                plotChannel(rollAngleSeries, rollAngleGapSeries, "roll", from, now)
+                plotChannel(gimbalAngleSeries, gimbalAngleGapSeries, "gimbalAngle", from, now)
+                plotChannel(rollVelocitySeries, rollVelocityGapSeries, "gyroX", from, now)
+                plotChannel(gimbalVelocitySeries, gimbalVelocityGapSeries, "gimbalVelocity", from, now)
+                plotChannel(torqueSeries, torqueGapSeries, "torque", from, now)
+                serialManager.events.updateMarkerSeries(rollAngleEventSeries, "roll", timeOrigin, from, now)
             }
+            fitAxis(rollAngleAxisY, "roll", 1.0)
+            fitAxis(gimbalAngleAxisY, "gimbalAngle", 2.0)
+            fitAxis(rollVelAxisY, "gyroX", 0.2)
+            fitAxis(gimbalVelAxisY, "gimbalVelocity", 0.2)
+            fitAxis(torqueAxisY, "torque", 0.2)
             if (t > 20) {
                 var m = t - 20
                 rollAngleAxisX.min=m; rollAngleAxisX.max=t; gimbalAngleAxisX.min=m; gimbalAngleAxisX.max=t
                 rollVelAxisX.min=m; rollVelAxisX.max=t; gimbalVelAxisX.min=m; gimbalVelAxisX.max=t
                 torqueAxisX.min=m; torqueAxisX.max=t
             }
-            timeIndex++
-            dateTimeLabel.text = Qt.formatDateTime(new Date(), "yyyy-MM-dd hh:mm:ss")
         }
     }
 
+    function plotChannel(series, gapSeries, channel, from, to) {
+        serialManager.history.updateSeries(series, channel, timeOrigin, from, to, maxPoints)
+        serialManager.history.updateGapSeries(gapSeries, channel, timeOrigin, from, to)
+    }
+
     onIsRunningChanged: {
         if (serialManager) {
             if (isRunning) serialManager.startRecording(dataFileField.text)
@@ -158,9 +162,18 @@ Rectangle {
     }
 
     function resetAll() {
-        isRunning = false; timeIndex = 0
-        rollAngleSeries.clear(); gimbalAngleSeries.clear()
-        rollVelocitySeries.clear(); gimbalVelocitySeries.clear(); torqueSeries.clear()
+        isRunning = false; timeIndex = 0; timeOrigin = -1; lastPlotTime = -1
+        if (serialManager) {
+            // 갭에서 나뉜 보조 시리즈까지 비움
+            var lines = [rollAngleSeries, gimbalAngleSeries, rollVelocitySeries, gimbalVelocitySeries, torqueSeries]
+            for (var i = 0; i < lines.length; i++) serialManager.history.clearSeries(lines[i])
+        } else {
+            rollAngleSeries.clear(); gimbalAngleSeries.clear()
+            rollVelocitySeries.clear(); gimbalVelocitySeries.clear(); torqueSeries.clear()
+        }
+        rollAngleGapSeries.clear(); gimbalAngleGapSeries.clear()
+        rollVelocityGapSeries.clear(); gimbalVelocityGapSeries.clear(); torqueGapSeries.clear()
+        rollAngleEventSeries.clear()
         rollAngleAxisX.min=0; rollAngleAxisX.max=20; gimbalAngleAxisX.min=0; gimbalAngleAxisX.max=20
         rollVelAxisX.min=0; rollVelAxisX.max=20; gimbalVelAxisX.min=0; gimbalVelAxisX.max=20
         torqueAxisX.min=0; torqueAxisX.max=20
@@ -198,10 +211,38 @@ Rectangle {
                 var s = serialManager.connectionStatus
                 if (s.indexOf("Connected:") === 0) return colLampOn
                 if (s.indexOf("Connecting") === 0) return colAccent
-                if (s.indexOf("No data") === 0) return "#e84040"
+                if (s.indexOf("Link degraded") === 0) return colAccent
+                if (s.indexOf("No data") === 0 || s.indexOf("Bad data") === 0
+                    || s.indexOf("Link lost") === 0) return "#e84040"
                 return colLabel
             }
         }
+        // ── 링크 품질 (timestamp 갭 기반) ──
+        Text {
+            id: linkQualityLabel
+            anchors.left: connStatusLabel.right; anchors.leftMargin: 16
+            anchors.verticalCenter: parent.verticalCenter
+            visible: serialManager ? serialManager.connected : false
+            text: serialManager
+                  ? "LINK " + serialManager.linkQuality.toFixed(1) + "%  lost " + serialManager.packetsLost
+                    + "  max gap " + serialManager.longestGapMs + " ms"
+                    + "  period " + serialManager.linkPeriodMs.toFixed(1) + " ms"
+                    + "  util " + serialManager.linkUtilization.toFixed(0) + "%"
+                    + (serialManager.autoBaud ? " @ " + serialManager.baudRate + " auto" : "")
+                  : ""
+            font.pixelSize: 14; font.family: monoFont
+            color: !serialManager ? colLabel
+                 : serialManager.linkQuality >= 99 ? colLampOn
+                 : serialManager.linkQuality >= 90 ? colAccent : "#e84040"
+        }
+        // ── 발생 중 알람 ──
+        Text {
+            anchors.left: linkQualityLabel.right; anchors.leftMargin: 16
+            anchors.verticalCenter: parent.verticalCenter
+            visible: serialManager ? serialManager.alarms.activeAlarms.length > 0 : false
+            text: serialManager ? "ALARM " + serialManager.alarms.activeAlarms.join(" ") : ""
+            font.pixelSize: 14; font.family: monoFont; font.bold: true; color: "#e84040"
+        }
         Text {
             anchors.centerIn: parent
             text: "CONTROL MOMENT GYROSCOPE SYSTEM  v1.0"
@@ -240,7 +281,9 @@ Rectangle {
                 rxLogView.positionViewAtEnd()
                 pktLogView.positionViewAtEnd()
             })
+            if (serialManager) serialManager.spectrum.enabled = true
         }
+        onClosed: if (serialManager) serialManager.spectrum.enabled = false
         background: Rectangle { color: colPanel; radius: 0; border.color: colAccent; border.width: 1 }
         Column {
             spacing: 10; width: parent.width
@@ -257,34 +300,330 @@ Rectangle {
                 spacing: 6; width: parent.width
                 // RPM TX
                 Rectangle {
-                    width: (parent.width - 18) / 4; height: 400; color: colInputBg; radius: 0; border.color: colInputBorder; border.width: 1
+                    width: (parent.width - 18) / 4; height: 300; color: colInputBg; radius: 0; border.color: colInputBorder; border.width: 1
                     ListView {
-                        id: rpmLogView; anchors.fill: parent; anchors.margins: 6; clip: true; model: rpmLogModel
-                        delegate: Text { width: rpmLogView.width; text: modelData; color: "#f0a500"; font.pixelSize: 11; font.family: monoFont; wrapMode: Text.Wrap }
+                        id: rpmLogView; anchors.fill: parent; anchors.margins: 6; clip: true; model: serialManager ? serialManager.logs.rpmTx : null
+                        Connections { target: rpmLogView.model; function onBatchAppended() { if (settingsPopup.opened) rpmLogView.positionViewAtEnd() } }
+                        delegate: Text { width: rpmLogView.width; text: line; color: "#f0a500"; font.pixelSize: 11; font.family: monoFont; wrapMode: Text.Wrap }
                     }
                 }
                 // PID TX
                 Rectangle {
-                    width: (parent.width - 18) / 4; height: 400; color: colInputBg; radius: 0; border.color: colInputBorder; border.width: 1
+                    width: (parent.width - 18) / 4; height: 300; color: colInputBg; radius: 0; border.color: colInputBorder; border.width: 1
                     ListView {
-                        id: pidLogView; anchors.fill: parent; anchors.margins: 6; clip: true; model: pidLogModel
-                        delegate: Text { width: pidLogView.width; text: modelData; color: "#80cbc4"; font.pixelSize: 11; font.family: monoFont; wrapMode: Text.Wrap }
+                        id: pidLogView; anchors.fill: parent; anchors.margins: 6; clip: true; model: serialManager ? serialManager.logs.pidTx : null
+                        Connections { target: pidLogView.model; function onBatchAppended() { if (settingsPopup.opened) pidLogView.positionViewAtEnd() } }
+                        delegate: Text { width: pidLogView.width; text: line; color: "#80cbc4"; font.pixelSize: 11; font.family: monoFont; wrapMode: Text.Wrap }
                     }
                 }
                 // RX
                 Rectangle {
-                    width: (parent.width - 18) / 4; height: 400; color: colInputBg; radius: 0; border.color: colInputBorder; border.width: 1
+                    width: (parent.width - 18) / 4; height: 300; color: colInputBg; radius: 0; border.color: colInputBorder; border.width: 1
                     ListView {
-                        id: rxLogView; anchors.fill: parent; anchors.margins: 6; clip: true; model: rxLogModel
-                        delegate: Text { width: rxLogView.width; text: modelData; color: colText; font.pixelSize: 11; font.family: monoFont; wrapMode: Text.Wrap }
+                        id: rxLogView; anchors.fill: parent; anchors.margins: 6; clip: true; model: serialManager ? serialManager.logs.rx : null
+                        Connections { target: rxLogView.model; function onBatchAppended() { if (settingsPopup.opened) rxLogView.positionViewAtEnd() } }
+                        delegate: Text { width: rxLogView.width; text: line; color: colText; font.pixelSize: 11; font.family: monoFont; wrapMode: Text.Wrap }
                     }
                 }
                 // PKT
                 Rectangle {
-                    width: (parent.width - 18) / 4; height: 400; color: colInputBg; radius: 0; border.color: colInputBorder; border.width: 1
+                    width: (parent.width - 18) / 4; height: 300; color: colInputBg; radius: 0; border.color: colInputBorder; border.width: 1
                     ListView {
-                        id: pktLogView; anchors.fill: parent; anchors.margins: 6; clip: true; model: pktLogModel
-                        delegate: Text { width: pktLogView.width; text: modelData; color: "#c0c0c0"; font.pixelSize: 11; font.family: monoFont; wrapMode: Text.Wrap }
+                        id: pktLogView; anchors.fill: parent; anchors.margins: 6; clip: true; model: serialManager ? serialManager.logs.pkt : null
+                        Connections { target: pktLogView.model; function onBatchAppended() { if (settingsPopup.opened) pktLogView.positionViewAtEnd() } }
+                        delegate: Text { width: pktLogView.width; text: line; color: "#c0c0c0"; font.pixelSize: 11; font.family: monoFont; wrapMode: Text.Wrap }
+                    }
+                }
+            }
+            // ── 슬라이딩 통계 (1/5/30초) ──
+            Text {
+                width: parent.width
+                text: "[ STATISTICS ]   channel / window :  mean  rms  std  min  max  p2p"
+                font.pixelSize: 13; font.bold: true; font.family: monoFont; color: colAccent
+            }
+            Grid {
+                columns: 3; columnSpacing: 12; rowSpacing: 2; width: parent.width
+                Repeater {
+                    model: [["roll", 1], ["roll", 5], ["roll", 30],
+                            ["gyroX", 1], ["gyroX", 5], ["gyroX", 30],
+                            ["wheel1Rpm", 1], ["wheel1Rpm", 5], ["wheel1Rpm", 30]]
+                    delegate: Text {
+                        width: 386
+                        property var st: serialManager && serialManager.stats.snapshot[modelData[0]]
+                                         ? serialManager.stats.snapshot[modelData[0]][String(modelData[1])] : undefined
+                        text: {
+                            var head = modelData[0] + "/" + modelData[1] + "s: "
+                            if (!st || st.count === 0) return head + "--"
+                            var d = modelData[0].indexOf("Rpm") >= 0 ? 0 : 3
+                            return head + st.mean.toFixed(d) + " " + st.rms.toFixed(d) + " " + st.std.toFixed(d)
+                                   + " " + st.min.toFixed(d) + " " + st.max.toFixed(d) + " " + st.p2p.toFixed(d)
+                        }
+                        font.pixelSize: 11; font.family: monoFont; color: colText
+                    }
+                }
+            }
+            // ── 파생 채널 (이름 = 식) ──
+            Row {
+                spacing: 8; width: parent.width
+                Text {
+                    text: "[ DERIVED ]"
+                    font.pixelSize: 13; font.bold: true; font.family: monoFont; color: colAccent
+                    anchors.verticalCenter: parent.verticalCenter
+                }
+                TextField {
+                    id: derivedField; width: 420; height: 26
+                    placeholderText: "name = expression   e.g. rpmAvg = (wheel1Rpm + wheel2Rpm) / 2"
+                    font.pixelSize: 11; font.family: monoFont; color: colAccent
+                    background: Rectangle { color: colInputBg; radius: 0; border.color: colInputBorder; border.width: 1 }
+                    onAccepted: {
+                        var eq = text.indexOf("=")
+                        if (eq < 0) { derivedError.text = "expected name = expression"; return }
+                        var err = serialManager.defineDerivedChannel(text.substring(0, eq), text.substring(eq + 1))
+                        derivedError.text = err
+                        if (err === "") text = ""
+                    }
+                }
+                Text {
+                    id: derivedError
+                    anchors.verticalCenter: parent.verticalCenter
+                    font.pixelSize: 11; font.family: monoFont; color: "#e84040"
+                }
+            }
+            Text {
+                width: parent.width; wrapMode: Text.Wrap
+                text: {
+                    if (!serialManager || serialManager.packetCount < 0) return ""   // packetCount: 패킷마다 재평가
+                    return serialManager.derivedChannels.map(function(c) {
+                        return c.name + " = " + c.expression + " (" + serialManager.channelValue(c.name).toFixed(3) + ")"
+                    }).join("   |   ")
+                }
+                font.pixelSize: 11; font.family: monoFont; color: colText
+            }
+            // ── 스펙트럼 (Welch PSD, 휠 RPM 고조파 마커) ──
+            Row {
+                spacing: 8; width: parent.width
+                Text {
+                    text: "[ SPECTRUM ]"
+                    font.pixelSize: 13; font.bold: true; font.family: monoFont; color: colAccent
+                    anchors.verticalCenter: parent.verticalCenter
+                }
+                Repeater {
+                    model: serialManager ? serialManager.spectrum.channels : []
+                    delegate: Rectangle {
+                        width: 90; height: 22; radius: 0
+                        color: spectrumChannel === modelData ? colBtnHover : colBtn
+                        border.color: spectrumChannel === modelData ? colAccent : colInputBorder; border.width: 1
+                        Text { anchors.centerIn: parent; text: modelData; color: colText; font.pixelSize: 11; font.family: monoFont }
+                        MouseArea { anchors.fill: parent; onClicked: { spectrumChannel = modelData; updateSpectrum() } }
+                    }
+                }
+                Text {
+                    anchors.verticalCenter: parent.verticalCenter
+                    text: {
+                        if (!serialManager) return ""
+                        var sp = serialManager.spectrum
+                        var pk = sp.peaks[spectrumChannel]
+                        var h = sp.harmonics.filter(function(x) { return x.order === 1 })
+                                            .map(function(x) { return "W" + x.wheel + " " + x.trueFreq.toFixed(1) + " Hz"
+                                                                      + (x.aliased ? " (→" + x.freq.toFixed(1) + ")" : "") })
+                        return "fs " + sp.sampleRate.toFixed(1) + " Hz  Δf " + sp.resolutionHz.toFixed(2) + " Hz"
+                               + (pk ? "  peak " + pk.freq.toFixed(2) + " Hz " + pk.db.toFixed(1) + " dB" : "")
+                               + (h.length > 0 ? "  |  1x " + h.join(", ") : "")
+                    }
+                    font.pixelSize: 11; font.family: monoFont; color: colText
+                }
+            }
+            ChartView {
+                width: parent.width; height: 220
+                antialiasing: true; backgroundColor: colChartBg; legend.visible: false
+                plotAreaColor: colChartBg
+                margins.top: 4; margins.bottom: 4
+                ValuesAxis { id: spectrumAxisX; min: 0; max: 50; titleText: "Hz"; labelsFont.pixelSize: 11; labelsFont.family: monoFont; gridLineColor: colGrid; labelsColor: colLabel; titleBrush: colLabel }
+                ValuesAxis { id: spectrumAxisY; min: -80; max: 20; tickCount: 6; titleText: "PSD (dB)"; labelsFont.pixelSize: 11; labelsFont.family: monoFont; gridLineColor: colGrid; labelsColor: colLabel; titleBrush: colLabel }
+                LineSeries { id: spectrumSeries; color: "#80cbc4"; width: 1.5; axisX: spectrumAxisX; axisY: spectrumAxisY }
+                ScatterSeries { id: harmonicSeries; color: "#e84040"; borderColor: "transparent"; markerSize: 8; axisX: spectrumAxisX; axisY: spectrumAxisY }
+            }
+            // ── 알람 규칙 (N: 알림, M: 녹화 마크, E: 자동 비상 정지) ──
+            Text {
+                width: parent.width
+                text: {
+                    if (!serialManager) return "[ ALARMS ]"
+                    var l = serialManager.alarmLatency
+                    return "[ ALARMS ]   auto E-stop " + l.estopCount
+                           + (l.rxToTxMs >= 0 ? "   rx→TX " + l.rxToTxMs.toFixed(2) + " ms (max " + l.rxToTxMaxMs.toFixed(2) + ")"
+                                                + "   detect→TX " + l.detectToTxMs.toFixed(3) + " ms" : "")
+                }
+                font.pixelSize: 13; font.bold: true; font.family: monoFont; color: colAccent
+            }
+            Flow {
+                width: parent.width; spacing: 6
+                Repeater {
+                    model: serialManager ? serialManager.alarms : null
+                    delegate: Rectangle {
+                        width: 250; height: 24; radius: 0
+                        color: active ? "#5a2020" : colBtn
+                        border.color: active ? "#e84040" : colInputBorder; border.width: 1
+                        Row {
+                            anchors.fill: parent; anchors.leftMargin: 6; spacing: 4
+                            Text {
+                                width: 150; anchors.verticalCenter: parent.verticalCenter
+                                text: name + " (" + tripCount + ")"; elide: Text.ElideRight
+                                color: ruleEnabled ? colText : colLabel; font.pixelSize: 11; font.family: monoFont
+                            }
+                            Repeater {
+                                model: [ { label: "N", bit: 1 }, { label: "M", bit: 2 }, { label: "E", bit: 4 } ]
+                                delegate: Rectangle {
+                                    width: 22; height: 18; radius: 0; anchors.verticalCenter: parent.verticalCenter
+                                    property bool on: (actions & modelData.bit) !== 0
+                                    color: on ? (modelData.bit === 4 ? "#e84040" : colBtnHover) : colInputBg
+                                    border.color: colInputBorder; border.width: 1
+                                    Text { anchors.centerIn: parent; text: modelData.label; color: colText; font.pixelSize: 10; font.family: monoFont }
+                                    MouseArea { anchors.fill: parent; onClicked: serialManager.alarms.setActions(name, actions ^ modelData.bit) }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+            // ── 세션 로그 파일 (회전 로그, 인덱스 검색) ──
+            Row {
+                spacing: 8; width: parent.width
+                Text {
+                    text: "[ LOG FILES ]"
+                    font.pixelSize: 13; font.bold: true; font.family: monoFont; color: colAccent
+                    anchors.verticalCenter: parent.verticalCenter
+                }
+                Repeater {
+                    model: serialManager ? serialManager.sessionLog.files.slice(0, 4) : []
+                    delegate: Rectangle {
+                        width: 190; height: 22; radius: 0
+                        property bool current: serialManager && serialManager.logViewer.path === modelData
+                        color: current ? colBtnHover : colBtn
+                        border.color: current ? colAccent : colInputBorder; border.width: 1
+                        Text { anchors.centerIn: parent; text: modelData.substring(modelData.lastIndexOf("/") + 1); color: colText; font.pixelSize: 11; font.family: monoFont }
+                        MouseArea {
+                            anchors.fill: parent
+                            onClicked: {
+                                serialManager.sessionLog.flush()
+                                serialManager.logViewer.open(modelData)
+                                if (logSearchField.text !== "") serialManager.logViewer.filter(logSearchField.text, 0, -1, -1)
+                            }
+                        }
+                    }
+                }
+                TextField {
+                    id: logSearchField; width: 220; height: 26
+                    placeholderText: "search (Enter)"
+                    font.pixelSize: 11; font.family: monoFont; color: colAccent
+                    background: Rectangle { color: colInputBg; radius: 0; border.color: colInputBorder; border.width: 1 }
+                    onAccepted: {
+                        if (text === "") serialManager.logViewer.clearFilter()
+                        else serialManager.logViewer.filter(text, 0, -1, -1)
+                    }
+                }
+                Text {
+                    anchors.verticalCenter: parent.verticalCenter
+                    text: serialManager ? serialManager.logViewer.count + " / " + serialManager.logViewer.totalCount + " lines" : ""
+                    font.pixelSize: 11; font.family: monoFont; color: colText
+                }
+            }
+            Rectangle {
+                width: parent.width; height: 200; color: colInputBg; radius: 0; border.color: colInputBorder; border.width: 1
+                ListView {
+                    id: logFileView; anchors.fill: parent; anchors.margins: 6; clip: true
+                    model: serialManager ? serialManager.logViewer : null
+                    reuseItems: true
+                    delegate: Text {
+                        width: logFileView.width; elide: Text.ElideRight
+                        text: line; color: colText
+                        font.pixelSize: 11; font.family: monoFont
+                    }
+                    ScrollBar.vertical: ScrollBar { }
+                }
+            }
+            // ── 트레이스 (Perfetto / chrome://tracing 용 JSON) ──
+            Row {
+                spacing: 8; width: parent.width
+                Text {
+                    text: "[ TRACE ]"
+                    font.pixelSize: 13; font.bold: true; font.family: monoFont; color: colAccent
+                    anchors.verticalCenter: parent.verticalCenter
+                }
+                Rectangle {
+                    width: 70; height: 22; radius: 0
+                    property bool on: serialManager && serialManager.tracing
+                    color: on ? colBtnHover : colBtn
+                    border.color: on ? colAccent : colInputBorder; border.width: 1
+                    Text { anchors.centerIn: parent; text: parent.on ? "ON" : "OFF"; color: colText; font.pixelSize: 11; font.family: monoFont }
+                    MouseArea { anchors.fill: parent; onClicked: serialManager.tracing = !serialManager.tracing }
+                }
+                Rectangle {
+                    width: 70; height: 22; radius: 0; color: traceExportArea.pressed ? colBtnHover : colBtn
+                    border.color: colInputBorder; border.width: 1
+                    Text { anchors.centerIn: parent; text: "EXPORT"; color: colText; font.pixelSize: 11; font.family: monoFont }
+                    MouseArea { id: traceExportArea; anchors.fill: parent; onClicked: tracePathText.text = serialManager.exportTrace() }
+                }
+                Text {
+                    id: tracePathText
+                    anchors.verticalCenter: parent.verticalCenter
+                    font.pixelSize: 11; font.family: monoFont; color: colText
+                }
+            }
+            // ── 저지연 모드 (Linux 전용, 항목별 적용 결과 표시) ──
+            Row {
+                spacing: 8; width: parent.width
+                Text {
+                    text: "[ LOW LATENCY ]"
+                    font.pixelSize: 13; font.bold: true; font.family: monoFont; color: colAccent
+                    anchors.verticalCenter: parent.verticalCenter
+                }
+                Rectangle {
+                    width: 70; height: 22; radius: 0
+                    property bool on: serialManager && serialManager.lowLatency
+                    color: on ? colBtnHover : colBtn
+                    border.color: on ? colAccent : colInputBorder; border.width: 1
+                    Text { anchors.centerIn: parent; text: parent.on ? "ON" : "OFF"; color: colText; font.pixelSize: 11; font.family: monoFont }
+                    MouseArea { anchors.fill: parent; onClicked: serialManager.lowLatency = !serialManager.lowLatency }
+                }
+                Text {
+                    anchors.verticalCenter: parent.verticalCenter
+                    font.pixelSize: 11; font.family: monoFont; color: colText
+                    text: {
+                        if (!serialManager) return ""
+                        var r = serialManager.lowLatencyReport
+                        return Object.keys(r).filter(function(k) { return k !== "enabled" })
+                                             .map(function(k) { return k + ": " + r[k] }).join("  ")
+                    }
+                }
+            }
+            // ── 명령 응답 추적 (송신 → LOG 응답 왕복 지연) ──
+            Row {
+                spacing: 0; width: parent.width
+                Text {
+                    width: parent.width
+                    text: {
+                        if (!serialManager) return "[ COMMAND ACK ]"
+                        var c = serialManager.commands
+                        var hist = c.latencyHistogram.map(function(b) { return b.label + ":" + b.count }).join("  ")
+                        return "[ COMMAND ACK ]  pending " + c.pendingCount + "  ok " + c.ackedCount
+                               + "  timeout " + c.timeoutCount + "  last " + c.lastLatencyMs.toFixed(1)
+                               + " ms  max " + c.maxLatencyMs.toFixed(1) + " ms   |  " + hist
+                    }
+                    font.pixelSize: 13; font.bold: true; font.family: monoFont; color: colAccent
+                }
+            }
+            Rectangle {
+                width: parent.width; height: 110; color: colInputBg; radius: 0; border.color: colInputBorder; border.width: 1
+                ListView {
+                    id: ackLogView; anchors.fill: parent; anchors.margins: 6; clip: true
+                    model: serialManager ? serialManager.commands : null
+                    onCountChanged: Qt.callLater(positionViewAtEnd)
+                    delegate: Text {
+                        width: ackLogView.width
+                        text: "[" + time.toFixed(2) + "] " + command + "  " + status
+                              + (latencyMs >= 0 ? "  " + latencyMs.toFixed(1) + " ms" : "")
+                        color: status === "timeout" ? "#e84040" : status === "pending" ? colAccent : colText
+                        font.pixelSize: 11; font.family: monoFont
                     }
                 }
             }
@@ -299,81 +638,21 @@ Rectangle {
         }
     }
 
-    // ── 로그 모델 (4개) ──
-    ListModel { id: rpmLogModel }
-    ListModel { id: pidLogModel }
-    ListModel { id: rxLogModel }
-    ListModel { id: pktLogModel }
-
-    function appendToLog(model, msg) {
-        model.append({"modelData": msg})
-        if (model.count > 100) model.remove(0)
-        if (settingsPopup.opened) {
-            if (model === rpmLogModel) Qt.callLater(rpmLogView.positionViewAtEnd)
-            else if (model === pidLogModel) Qt.callLater(pidLogView.positionViewAtEnd)
-            else if (model === rxLogModel) Qt.callLater(rxLogView.positionViewAtEnd)
-            else if (model === pktLogModel) Qt.callLater(pktLogView.positionViewAtEnd)
-        }
-    }
-    function classifyAndAppend(msg) {
-        var formatted = formatLog(msg)
-        // PKT 로그 → PKT 칼럼
-        if (msg.indexOf("PKT #") === 0) {
-            appendToLog(pktLogModel, msg); return
-        }
-        // JSON에서 detail 필드로 분류
-        var idx = msg.indexOf('{')
-        if (idx >= 0) {
-            try {
-                var obj = JSON.parse(msg.substring(idx))
-                var d = (obj.detail || "").toUpperCase()
-                if (d.indexOf("CMD:R") >= 0 || d.indexOf("RPM") >= 0) {
-                    appendToLog(rpmLogModel, formatted); return
-                }
-                if (d.indexOf("CMD:K") >= 0 || d.indexOf("CMD:B") >= 0 || d.indexOf("CMD:W") >= 0
-                    || d.indexOf("BALANCING") >= 0 || d.indexOf("PID") >= 0) {
-                    appendToLog(pidLogModel, formatted); return
-                }
-            } catch(e) {}
-        }
-        // 나머지 전부 RX (RX bytes, CHECKSUM FAIL, Buffer overflow, ASCII 등)
-        appendToLog(rxLogModel, formatted)
+    // ── 스펙트럼 갱신 (분석 스레드 결과 도착 시) ──
+    Connections {
+        target: serialManager ? serialManager.spectrum : null
+        function onSpectrumChanged() { updateSpectrum() }
     }
-    function formatLog(msg) {
-        // JSON 메시지 감지 및 포맷
-        var idx = msg.indexOf('{')
-        if (idx < 0) return msg
-        try {
-            var prefix = msg.substring(0, idx).trim()
-            var obj = JSON.parse(msg.substring(idx))
-            var t = obj.t !== undefined ? obj.t : "?"
-            var ev = obj.event || "?"
-            var detail = obj.detail || ""
-            var lines = "[" + t + "] " + ev + ": " + detail
-            // 주요 상태 표시
-            var state = []
-            if (obj.wheelState !== undefined) state.push("wheel=" + obj.wheelState)
-            if (obj.balancing !== undefined)  state.push("bal=" + (obj.balancing ? "ON" : "OFF"))
-            if (obj.targetRPM !== undefined)  state.push("RPM=" + obj.targetRPM)
-            if (obj.targetGimbal !== undefined) state.push("gimbal=" + obj.targetGimbal)
-            if (state.length > 0) lines += "\n  " + state.join("  ")
-            // 통신 상태 (변경 이벤트일 때만)
-            if (obj.event === "comm" || obj.event === "init") {
-                var c = obj.comm
-                if (c) {
-                    var sensors = []
-                    if (c.angleSensor) sensors.push("angle"); else sensors.push("!angle")
-                    if (c.rpmSensor1) sensors.push("rpm1"); else sensors.push("!rpm1")
-                    if (c.rpmSensor2) sensors.push("rpm2"); else sensors.push("!rpm2")
-                    if (c.wheelMotor) sensors.push("wheel"); else sensors.push("!wheel")
-                    if (c.gimbalMotor) sensors.push("gimbal"); else sensors.push("!gimbal")
-                    if (c.mainLoop) sensors.push("main"); else sensors.push("!main")
-                    lines += "\n  comm: " + sensors.join(" ")
-                }
-            }
-            return prefix ? (prefix + "\n" + lines) : lines
-        } catch(e) {
-            return msg  // JSON 파싱 실패 → 원본 그대로
+    function updateSpectrum() {
+        var sp = serialManager.spectrum
+        if (sp.sampleRate <= 0) return
+        sp.updateSeries(spectrumSeries, spectrumChannel)
+        sp.updateHarmonicSeries(harmonicSeries, spectrumChannel)
+        spectrumAxisX.max = sp.sampleRate / 2
+        var pk = sp.peaks[spectrumChannel]
+        if (pk) {
+            spectrumAxisY.max = Math.ceil(pk.db / 10) * 10 + 10
+            spectrumAxisY.min = spectrumAxisY.max - 100
         }
     }
 
@@ -400,6 +679,8 @@ Rectangle {
                 ValuesAxis { id: rollAngleAxisX; min: 0; max: 20; titleText: "Time"; labelsFont.pixelSize: 11; labelsFont.family: monoFont; gridLineColor: colGrid; labelsColor: colLabel; titleBrush: colLabel }
                 ValuesAxis { id: rollAngleAxisY; min: -10; max: 10; tickCount: 11; titleText: "Roll (deg)"; labelsFont.pixelSize: 11; labelsFont.family: monoFont; gridLineColor: colGrid; labelsColor: colLabel; titleBrush: colLabel }
                 LineSeries { id: rollAngleSeries; color: "#f0a500"; width: 2; axisX: rollAngleAxisX; axisY: rollAngleAxisY }
+                ScatterSeries { id: rollAngleGapSeries; color: "#e84040"; borderColor: "transparent"; markerSize: 7; axisX: rollAngleAxisX; axisY: rollAngleAxisY }
+                ScatterSeries { id: rollAngleEventSeries; color: "#40a0e8"; borderColor: "transparent"; markerSize: 9; markerShape: ScatterSeries.MarkerShapeRectangle; axisX: rollAngleAxisX; axisY: rollAngleAxisY }
             }
             ChartView {
                 Layout.fillWidth: true; Layout.fillHeight: true
@@ -409,6 +690,7 @@ Rectangle {
                 ValuesAxis { id: gimbalAngleAxisX; min: 0; max: 20; titleText: "Time"; labelsFont.pixelSize: 11; labelsFont.family: monoFont; gridLineColor: colGrid; labelsColor: colLabel; titleBrush: colLabel }
                 ValuesAxis { id: gimbalAngleAxisY; min: -65; max: 65; tickCount: 9; titleText: "Gimbal (deg)"; labelsFont.pixelSize: 11; labelsFont.family: monoFont; gridLineColor: colGrid; labelsColor: colLabel; titleBrush: colLabel }
                 LineSeries { id: gimbalAngleSeries; color: "#e8e8e8"; width: 2; axisX: gimbalAngleAxisX; axisY: gimbalAngleAxisY }
+                ScatterSeries { id: gimbalAngleGapSeries; color: "#e84040"; borderColor: "transparent"; markerSize: 7; axisX: gimbalAngleAxisX; axisY: gimbalAngleAxisY }
             }
             ChartView {
                 Layout.fillWidth: true; Layout.fillHeight: true
@@ -418,6 +700,7 @@ Rectangle {
                 ValuesAxis { id: rollVelAxisX; min: 0; max: 20; titleText: "Time"; labelsFont.pixelSize: 11; labelsFont.family: monoFont; gridLineColor: colGrid; labelsColor: colLabel; titleBrush: colLabel }
                 ValuesAxis { id: rollVelAxisY; min: -1; max: 1; tickCount: 11; titleText: "Roll Vel"; labelsFont.pixelSize: 11; labelsFont.family: monoFont; gridLineColor: colGrid; labelsColor: colLabel; titleBrush: colLabel }
                 LineSeries { id: rollVelocitySeries; color: "#c0c0c0"; width: 2; axisX: rollVelAxisX; axisY: rollVelAxisY }
+                ScatterSeries { id: rollVelocityGapSeries; color: "#e84040"; borderColor: "transparent"; markerSize: 7; axisX: rollVelAxisX; axisY: rollVelAxisY }
             }
             ChartView {
                 Layout.fillWidth: true; Layout.fillHeight: true
@@ -427,6 +710,7 @@ Rectangle {
                 ValuesAxis { id: gimbalVelAxisX; min: 0; max: 20; titleText: "Time"; labelsFont.pixelSize: 11; labelsFont.family: monoFont; gridLineColor: colGrid; labelsColor: colLabel; titleBrush: colLabel }
                 ValuesAxis { id: gimbalVelAxisY; min: -1; max: 1; tickCount: 11; titleText: "Gimbal Vel"; labelsFont.pixelSize: 11; labelsFont.family: monoFont; gridLineColor: colGrid; labelsColor: colLabel; titleBrush: colLabel }
                 LineSeries { id: gimbalVelocitySeries; color: "#d4770b"; width: 2; axisX: gimbalVelAxisX; axisY: gimbalVelAxisY }
+                ScatterSeries { id: gimbalVelocityGapSeries; color: "#e84040"; borderColor: "transparent"; markerSize: 7; axisX: gimbalVelAxisX; axisY: gimbalVelAxisY }
             }
         }
     }
@@ -494,7 +778,7 @@ Rectangle {
                 spacing: 0; anchors.verticalCenter: parent.verticalCenter
                 TextField {
                     id: baudField; width: 100; height: 34; font.pixelSize: 16; font.family: monoFont
-                    text: "115200"; readOnly: true; horizontalAlignment: Text.AlignHCenter
+                    text: "AUTO"; readOnly: true; horizontalAlignment: Text.AlignHCenter
                     color: colAccent
                     background: Rectangle { color: colInputBg; radius: 0; border.color: colInputBorder; border.width: 1 }
                 }
@@ -510,7 +794,7 @@ Rectangle {
                     Column {
                         width: parent.width
                         Repeater {
-                            model: ["9600", "19200", "38400", "57600", "115200"]
+                            model: ["AUTO", "57600", "115200", "230400", "460800", "921600", "1000000", "2000000"]
                             delegate: Rectangle {
                                 width: 118; height: 30; color: baudItemArea.containsMouse ? colBtnHover : colPanel
                                 border.color: colInputBorder; border.width: 1
@@ -567,19 +851,19 @@ Rectangle {
                         id: rpmField; width: 90; height: 40; text: "0"; font.pixelSize: 20; font.family: monoFont; horizontalAlignment: Text.AlignHCenter
                         color: colAccent; validator: IntValidator { bottom: 0; top: 10000 }
                         background: Rectangle { color: colInputBg; radius: 0; border.color: colInputBorder; border.width: 1 }
-                        onAccepted: rpmSendTimer.restart()
+                        onAccepted: sendRpm()
                     }
                     Column {
                         spacing: 0
                         Rectangle {
                             width: 20; height: 20; radius: 0; color: rpmUp.pressed ? colBtnHover : colBtn; border.color: colInputBorder; border.width: 1
                             Text { anchors.centerIn: parent; text: "\u25B2"; font.pixelSize: 7; color: colAccent }
-                            MouseArea { id: rpmUp; anchors.fill: parent; onClicked: { rpmField.text = String(Math.min(10000, Number(rpmField.text) + 100)); rpmSendTimer.restart() } }
+                            MouseArea { id: rpmUp; anchors.fill: parent; onClicked: { rpmField.text = String(Math.min(10000, Number(rpmField.text) + 100)); sendRpm() } }
                         }
                         Rectangle {
                             width: 20; height: 20; radius: 0; color: rpmDn.pressed ? colBtnHover : colBtn; border.color: colInputBorder; border.width: 1
                             Text { anchors.centerIn: parent; text: "\u25BC"; font.pixelSize: 7; color: colAccent }
-                            MouseArea { id: rpmDn; anchors.fill: parent; onClicked: { rpmField.text = String(Math.max(0, Number(rpmField.text) - 100)); rpmSendTimer.restart() } }
+                            MouseArea { id: rpmDn; anchors.fill: parent; onClicked: { rpmField.text = String(Math.max(0, Number(rpmField.text) - 100)); sendRpm() } }
                         }
                     }
                 }
@@ -609,18 +893,16 @@ Rectangle {
                             if (!root.isRunning) {
                                 if (serialManager) {
                                     if (!serialManager.connected)
-                                        serialManager.connectPort(portField.text, Number(baudField.text))
+                                        serialManager.connectPort(portField.text, Number(baudField.text) || 0)
                                     serialManager.sendRPM(Number(rpmField.text))
                                     serialManager.setBalancingPID(Number(kpField.text), Number(kiField.text), Number(kdField.text), Number(gainField.text))
                                     serialManager.startBalancing()
                                     serialManager.startRecording(dataFileField.text)
-                                    appendToLog(pidLogModel, "TX: B1 (START)")
                                 }
                             } else {
                                 if (serialManager && serialManager.connected) {
                                     serialManager.stopBalancing()
                                     serialManager.stopRecording()
-                                    appendToLog(pidLogModel, "TX: B0 (STOP)")
                                 }
                             }
                             root.isRunning = !root.isRunning
@@ -677,19 +959,19 @@ Rectangle {
                         id: kpField; width: 75; height: 40; text: "50"; font.pixelSize: 20; font.family: monoFont; horizontalAlignment: Text.AlignHCenter
                         color: colAccent
                         background: Rectangle { color: colInputBg; radius: 0; border.color: colInputBorder; border.width: 1 }
-                        onAccepted: pidSendTimer.restart()
+                        onAccepted: sendPid()
                     }
                     Column {
                         spacing: 0
                         Rectangle {
                             width: 20; height: 20; radius: 0; color: kpUp.pressed ? colBtnHover : colBtn; border.color: colInputBorder; border.width: 1
                             Text { anchors.centerIn: parent; text: "\u25B2"; font.pixelSize: 7; color: colAccent }
-                            MouseArea { id: kpUp; anchors.fill: parent; onClicked: { kpField.text = String(Number(kpField.text) + 1); pidSendTimer.restart() } }
+                            MouseArea { id: kpUp; anchors.fill: parent; onClicked: { kpField.text = String(Number(kpField.text) + 1); sendPid() } }
                         }
                         Rectangle {
                             width: 20; height: 20; radius: 0; color: kpDn.pressed ? colBtnHover : colBtn; border.color: colInputBorder; border.width: 1
                             Text { anchors.centerIn: parent; text: "\u25BC"; font.pixelSize: 7; color: colAccent }
-                            MouseArea { id: kpDn; anchors.fill: parent; onClicked: { kpField.text = String(Math.max(0, Number(kpField.text) - 1)); pidSendTimer.restart() } }
+                            MouseArea { id: kpDn; anchors.fill: parent; onClicked: { kpField.text = String(Math.max(0, Number(kpField.text) - 1)); sendPid() } }
                         }
                     }
                 }
@@ -700,19 +982,19 @@ Rectangle {
                         id: kiField; width: 75; height: 40; text: "0.03"; font.pixelSize: 20; font.family: monoFont; horizontalAlignment: Text.AlignHCenter
                         color: colAccent
                         background: Rectangle { color: colInputBg; radius: 0; border.color: colInputBorder; border.width: 1 }
-                        onAccepted: pidSendTimer.restart()
+                        onAccepted: sendPid()
                     }
                     Column {
                         spacing: 0
                         Rectangle {
                             width: 20; height: 20; radius: 0; color: kiUp.pressed ? colBtnHover : colBtn; border.color: colInputBorder; border.width: 1
                             Text { anchors.centerIn: parent; text: "\u25B2"; font.pixelSize: 7; color: colAccent }
-                            MouseArea { id: kiUp; anchors.fill: parent; onClicked: { kiField.text = String((Number(kiField.text) + 0.01).toFixed(2)); pidSendTimer.restart() } }
+                            MouseArea { id: kiUp; anchors.fill: parent; onClicked: { kiField.text = String((Number(kiField.text) + 0.01).toFixed(2)); sendPid() } }
                         }
                         Rectangle {
                             width: 20; height: 20; radius: 0; color: kiDn.pressed ? colBtnHover : colBtn; border.color: colInputBorder; border.width: 1
                             Text { anchors.centerIn: parent; text: "\u25BC"; font.pixelSize: 7; color: colAccent }
-                            MouseArea { id: kiDn; anchors.fill: parent; onClicked: { kiField.text = String(Math.max(0, (Number(kiField.text) - 0.01)).toFixed(2)); pidSendTimer.restart() } }
+                            MouseArea { id: kiDn; anchors.fill: parent; onClicked: { kiField.text = String(Math.max(0, (Number(kiField.text) - 0.01)).toFixed(2)); sendPid() } }
                         }
                     }
                 }
@@ -723,19 +1005,19 @@ Rectangle {
                         id: kdField; width: 75; height: 40; text: "20"; font.pixelSize: 20; font.family: monoFont; horizontalAlignment: Text.AlignHCenter
                         color: colAccent
                         background: Rectangle { color: colInputBg; radius: 0; border.color: colInputBorder; border.width: 1 }
-                        onAccepted: pidSendTimer.restart()
+                        onAccepted: sendPid()
                     }
                     Column {
                         spacing: 0
                         Rectangle {
                             width: 20; height: 20; radius: 0; color: kdUp.pressed ? colBtnHover : colBtn; border.color: colInputBorder; border.width: 1
                             Text { anchors.centerIn: parent; text: "\u25B2"; font.pixelSize: 7; color: colAccent }
-                            MouseArea { id: kdUp; anchors.fill: parent; onClicked: { kdField.text = String(Number(kdField.text) + 1); pidSendTimer.restart() } }
+                            MouseArea { id: kdUp; anchors.fill: parent; onClicked: { kdField.text = String(Number(kdField.text) + 1); sendPid() } }
                         }
                         Rectangle {
                             width: 20; height: 20; radius: 0; color: kdDn.pressed ? colBtnHover : colBtn; border.color: colInputBorder; border.width: 1
                             Text { anchors.centerIn: parent; text: "\u25BC"; font.pixelSize: 7; color: colAccent }
-                            MouseArea { id: kdDn; anchors.fill: parent; onClicked: { kdField.text = String(Math.max(0, Number(kdField.text) - 1)); pidSendTimer.restart() } }
+                            MouseArea { id: kdDn; anchors.fill: parent; onClicked: { kdField.text = String(Math.max(0, Number(kdField.text) - 1)); sendPid() } }
                         }
                     }
                 }
@@ -749,19 +1031,19 @@ Rectangle {
                         id: gainField; width: 75; height: 40; text: "0.03"; font.pixelSize: 20; font.family: monoFont; horizontalAlignment: Text.AlignHCenter
                         color: colAccent
                         background: Rectangle { color: colInputBg; radius: 0; border.color: colInputBorder; border.width: 1 }
-                        onAccepted: pidSendTimer.restart()
+                        onAccepted: sendPid()
                     }
                     Column {
                         spacing: 0
                         Rectangle {
                             width: 20; height: 20; radius: 0; color: gainUp.pressed ? colBtnHover : colBtn; border.color: colInputBorder; border.width: 1
                             Text { anchors.centerIn: parent; text: "\u25B2"; font.pixelSize: 7; color: colAccent }
-                            MouseArea { id: gainUp; anchors.fill: parent; onClicked: { gainField.text = String((Number(gainField.text) + 0.01).toFixed(2)); pidSendTimer.restart() } }
+                            MouseArea { id: gainUp; anchors.fill: parent; onClicked: { gainField.text = String((Number(gainField.text) + 0.01).toFixed(2)); sendPid() } }
                         }
                         Rectangle {
                             width: 20; height: 20; radius: 0; color: gainDn.pressed ? colBtnHover : colBtn; border.color: colInputBorder; border.width: 1
                             Text { anchors.centerIn: parent; text: "\u25BC"; font.pixelSize: 7; color: colAccent }
-                            MouseArea { id: gainDn; anchors.fill: parent; onClicked: { gainField.text = String(Math.max(0, (Number(gainField.text) - 0.01)).toFixed(2)); pidSendTimer.restart() } }
+                            MouseArea { id: gainDn; anchors.fill: parent; onClicked: { gainField.text = String(Math.max(0, (Number(gainField.text) - 0.01)).toFixed(2)); sendPid() } }
                         }
                     }
                 }
@@ -779,6 +1061,24 @@ Rectangle {
 
         Item {
             anchors.fill: parent
+            // ── 최근 계단 응답 (gimbal / wheel / balance) ──
+            Column {
+                anchors.top: parent.top; anchors.left: parent.left; z: 1
+                Repeater {
+                    model: ["gimbal", "wheel", "balance"]
+                    delegate: Text {
+                        property var r: serialManager ? serialManager.stepResponses[modelData] : undefined
+                        visible: r !== undefined
+                        text: r === undefined ? "" :
+                              modelData.toUpperCase() + "  rise " + (r.riseTime >= 0 ? r.riseTime.toFixed(2) + "s" : "--")
+                              + "  OS " + r.overshootPct.toFixed(1) + "%"
+                              + "  ts " + (r.settled ? r.settlingTime.toFixed(2) + "s" : "--")
+                              + "  ess " + r.steadyStateError.toFixed(3)
+                              + "  IAE " + r.iae.toFixed(2)
+                        font.pixelSize: 11; font.family: monoFont; color: colLabel
+                    }
+                }
+            }
             Row {
                 anchors.top: parent.top; anchors.right: parent.right; spacing: 8; z: 1
                 Text { text: "TORQUE"; font.pixelSize: 22; font.bold: true; font.family: monoFont; color: colLabel }
@@ -791,6 +1091,7 @@ Rectangle {
                 ValuesAxis { id: torqueAxisX; min: 0; max: 20; titleText: "Time"; labelsFont.pixelSize: 11; labelsFont.family: monoFont; gridLineColor: colGrid; labelsColor: colLabel; titleBrush: colLabel }
                 ValuesAxis { id: torqueAxisY; min: -1; max: 1; tickCount: 11; titleText: "Torque (Nm)"; labelsFont.pixelSize: 11; labelsFont.family: monoFont; gridLineColor: colGrid; labelsColor: colLabel; titleBrush: colLabel }
                 LineSeries { id: torqueSeries; color: "#e84040"; width: 2; axisX: torqueAxisX; axisY: torqueAxisY }
+                ScatterSeries { id: torqueGapSeries; color: "#e84040"; borderColor: "transparent"; markerSize: 7; axisX: torqueAxisX; axisY: torqueAxisY }
             }
         }
     }
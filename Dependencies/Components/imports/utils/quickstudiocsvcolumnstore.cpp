@@ -0,0 +1,650 @@
+/****************************************************************************
+**
+** Copyright (C) 2023 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the Qt Quick Dialogs module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "quickstudiocsvcolumnstore.h"
+
+#include <QRegularExpression>
+
+#include <charconv>
+
+QT_BEGIN_NAMESPACE
+
+static inline QColor fromString(const QString &colorName)
+{
+#if QT_VERSION >= QT_VERSION_CHECK(6, 4, 0)
+    return QColor::fromString(colorName);
+#else
+    return colorName;
+#endif // >= Qt 6.4
+}
+
+static inline bool isValidColorName(const QString &colorName)
+{
+#if QT_VERSION >= QT_VERSION_CHECK(6, 4, 0)
+    return QColor::isValidColorName(colorName);
+#else
+    constexpr QStringView colorPattern(
+        u"(?<color>^(?:#(?:(?:[0-9a-fA-F]{2}){3,4}|(?:[0-9a-fA-F]){3,4}))$)");
+    static QRegularExpression colorRegex(colorPattern.toString());
+    return colorRegex.match(colorName).hasMatch();
+#endif // >= Qt 6.4
+}
+
+/*
+    Type inference used to match every first cell of a column against a
+    regular expression. The grammar it accepted is kept, but checked by hand
+    in a single pass over the (trimmed) cell without allocating:
+
+        boolean   true|false
+        number    -?(0|[1-9][0-9]*)?(\.[0-9]*)?(e-?(0|[1-9][0-9]*))?
+                  with at least one digit or the dot before the exponent
+        hex       0x[0-9a-f]+
+        color     #([0-9a-fA-F]{3,4}|([0-9a-fA-F]{2}){3,4})
+*/
+enum class CellKind { String, Boolean, Number, Hex, Color };
+
+static inline bool isDigit(char16_t c)
+{
+    return c >= u'0' && c <= u'9';
+}
+
+static inline int hexDigitValue(char16_t c)
+{
+    if (c >= u'0' && c <= u'9')
+        return c - u'0';
+    if (c >= u'a' && c <= u'f')
+        return c - u'a' + 10;
+    if (c >= u'A' && c <= u'F')
+        return c - u'A' + 10;
+    return -1;
+}
+
+static bool isNumber(QStringView value)
+{
+    const qsizetype size = value.size();
+    qsizetype i = 0;
+    if (i < size && value[i] == u'-')
+        ++i;
+
+    const qsizetype bodyStart = i;
+    if (i < size && value[i] == u'0') {
+        ++i;
+    } else {
+        while (i < size && isDigit(value[i].unicode()))
+            ++i;
+    }
+    if (i < size && value[i] == u'.') {
+        ++i;
+        while (i < size && isDigit(value[i].unicode()))
+            ++i;
+    }
+    if (i == bodyStart)
+        return false;
+
+    if (i < size && value[i] == u'e') {
+        ++i;
+        if (i < size && value[i] == u'-')
+            ++i;
+        if (i < size && value[i] == u'0') {
+            ++i;
+        } else {
+            const qsizetype exponentStart = i;
+            while (i < size && isDigit(value[i].unicode()))
+                ++i;
+            if (i == exponentStart)
+                return false;
+        }
+    }
+    return i == size;
+}
+
+static bool isHex(QStringView value)
+{
+    if (value.size() < 3 || value[0] != u'0' || value[1] != u'x')
+        return false;
+    for (qsizetype i = 2; i < value.size(); ++i) {
+        const char16_t c = value[i].unicode();
+        if (!isDigit(c) && !(c >= u'a' && c <= u'f'))
+            return false;
+    }
+    return true;
+}
+
+static bool isColor(QStringView value)
+{
+    const qsizetype digits = value.size() - 1;
+    if (digits != 3 && digits != 4 && digits != 6 && digits != 8)
+        return false;
+    if (value[0] != u'#')
+        return false;
+    for (qsizetype i = 1; i < value.size(); ++i) {
+        if (hexDigitValue(value[i].unicode()) < 0)
+            return false;
+    }
+    return true;
+}
+
+static CellKind classify(QStringView trimmedValue)
+{
+    if (trimmedValue.isEmpty())
+        return CellKind::String;
+
+    switch (trimmedValue[0].unicode()) {
+    case u't':
+    case u'f':
+        if (trimmedValue == u"true" || trimmedValue == u"false")
+            return CellKind::Boolean;
+        return CellKind::String;
+    case u'#':
+        return isColor(trimmedValue) ? CellKind::Color : CellKind::String;
+    default:
+        if (isNumber(trimmedValue))
+            return CellKind::Number;
+        if (isHex(trimmedValue))
+            return CellKind::Hex;
+        return CellKind::String;
+    }
+}
+
+// QString::toDouble() equivalent on ASCII input, without the QByteArray it
+// allocates for the conversion. Leading and trailing whitespace must have been
+// removed already.
+static bool toDouble(QStringView value, double *result)
+{
+    char buffer[64];
+    if (value.size() > qsizetype(sizeof(buffer))) {
+        bool ok = false;
+        *result = value.toDouble(&ok);
+        return ok;
+    }
+
+    qsizetype length = 0;
+    for (QChar c : value) {
+        if (c.unicode() > 0x7f)
+            return false;
+        buffer[length++] = char(c.unicode());
+    }
+
+    // std::from_chars rejects an explicit plus sign
+    const char *begin = buffer;
+    if (length > 1 && buffer[0] == '+' && buffer[1] != '-' && buffer[1] != '+')
+        ++begin;
+
+    const std::from_chars_result parsed = std::from_chars(begin, buffer + length, *result);
+    return parsed.ec == std::errc() && parsed.ptr == buffer + length;
+}
+
+static double hexToDouble(QStringView value)
+{
+    double result = 0;
+    for (qsizetype i = 2; i < value.size(); ++i)
+        result = result * 16 + hexDigitValue(value[i].unicode());
+    return result;
+}
+
+// Case-insensitive comparison with a lower case ASCII word, as
+// toLower() == word would do.
+static bool equalsIgnoringCase(QStringView value, QLatin1String word)
+{
+    if (value.size() != word.size())
+        return false;
+    for (qsizetype i = 0; i < value.size(); ++i) {
+        char16_t c = value[i].unicode();
+        if (c >= u'A' && c <= u'Z')
+            c += u'a' - u'A';
+        if (c != char16_t(word[i].unicode()))
+            return false;
+    }
+    return true;
+}
+
+static QVariant stringToVariant(QStringView value)
+{
+    const QStringView trimmedValue = value.trimmed();
+
+    switch (classify(trimmedValue)) {
+    case CellKind::Boolean:
+        return QVariant::fromValue<bool>(trimmedValue[0] == u't');
+    case CellKind::Number: {
+        double number = 0;
+        // A lone "." or "-." passes the grammar but is not a number; it stays 0.
+        ::toDouble(trimmedValue, &number);
+        return number;
+    }
+    case CellKind::Hex:
+        return ::hexToDouble(trimmedValue);
+    case CellKind::Color:
+        return ::fromString(trimmedValue.toString());
+    case CellKind::String:
+        break;
+    }
+
+    return value.toString();
+}
+
+static QVariant stringToVariant(QStringView value, QMetaType::Type type, bool *ok = nullptr)
+{
+    if (type == QMetaType::Bool) {
+        const QStringView trimmedValue = value.trimmed();
+        bool conversionOk = true;
+        bool booleanValue = false;
+
+        if (equalsIgnoringCase(trimmedValue, QLatin1String("true")))
+            booleanValue = true;
+        else if (equalsIgnoringCase(trimmedValue, QLatin1String("false")))
+            booleanValue = false;
+        else
+            conversionOk = false;
+
+        if (ok)
+            *ok = conversionOk;
+
+        if (conversionOk)
+            return booleanValue;
+    }
+
+    if (type == QMetaType::Double) {
+        const QStringView trimmedValue = value.trimmed();
+        double numericValue = 0;
+        bool conversionOk = false;
+        if (isHex(trimmedValue)) {
+            numericValue = ::hexToDouble(trimmedValue);
+            conversionOk = true;
+        } else {
+            conversionOk = ::toDouble(trimmedValue, &numericValue);
+        }
+        if (ok)
+            *ok = conversionOk;
+
+        if (conversionOk)
+            return numericValue;
+    }
+
+    if (type == QMetaType::QColor) {
+        const QString colorName = value.toString();
+        bool conversionOk = ::isValidColorName(colorName);
+        if (ok)
+            *ok = conversionOk;
+
+        if (conversionOk)
+            return ::fromString(colorName);
+    }
+
+    if (type == QMetaType::QString) {
+        if (ok)
+            *ok = !value.isEmpty();
+    }
+
+    return value.toString();
+}
+
+static inline bool testBit(const QList<quint64> &bits, int index)
+{
+    return (bits.at(index >> 6) >> (index & 63)) & 1;
+}
+
+static inline void setBit(QList<quint64> &bits, int index)
+{
+    bits[index >> 6] |= quint64(1) << (index & 63);
+}
+
+// Appends srcBits bits of src after the first dstBits bits of dst.
+static void appendBits(QList<quint64> &dst, qsizetype dstBits, const QList<quint64> &src, qsizetype srcBits)
+{
+    const qsizetype firstWord = dstBits >> 6;
+    const int shift = int(dstBits & 63);
+    dst.resize((dstBits + srcBits + 63) / 64);
+
+    const qsizetype srcWords = qMin(src.size(), (srcBits + 63) / 64);
+    for (qsizetype i = 0; i < srcWords; ++i) {
+        const quint64 word = src.at(i);
+        dst[firstWord + i] |= word << shift;
+        if (shift && firstWord + i + 1 < dst.size())
+            dst[firstWord + i + 1] |= word >> (64 - shift);
+    }
+}
+
+void QuickStudioCsvColumnStore::reset(int columnCount, const QList<QMetaType::Type> &types)
+{
+    m_columns.clear();
+    m_columns.resize(columnCount);
+    for (int i = 0; i < columnCount && i < types.size(); ++i)
+        m_columns[i].type = types.at(i);
+    m_rowCount = 0;
+    m_strings.clear();
+    m_stringIndex.clear();
+    m_colors.clear();
+    m_colorIndex.clear();
+}
+
+void QuickStudioCsvColumnStore::reserve(int rowCount)
+{
+    const qsizetype words = (rowCount + 63) / 64;
+    for (Column &column : m_columns) {
+        column.present.reserve(words);
+        if (column.type == QMetaType::Double)
+            column.numbers.reserve(rowCount);
+        else if (column.type == QMetaType::QString || column.type == QMetaType::QColor)
+            column.indices.reserve(rowCount);
+        else if (column.type == QMetaType::Bool)
+            column.bools.reserve(words);
+    }
+}
+
+void QuickStudioCsvColumnStore::appendRow(const QList<QStringView> &fields)
+{
+    const int row = m_rowCount++;
+    if ((row & 63) == 0) {
+        for (Column &column : m_columns)
+            column.present.append(0);
+    }
+
+    int columnIndex = -1;
+    for (QStringView cellString : fields) {
+        if (++columnIndex == m_columns.size())
+            break;
+
+        if (!cellString.size())
+            continue;
+
+        setCell(m_columns[columnIndex], row, cellString);
+    }
+}
+
+void QuickStudioCsvColumnStore::setCell(Column &column, int row, QStringView cellString)
+{
+    if (column.type == QMetaType::UnknownType) {
+        const QVariant cellData = stringToVariant(cellString);
+        column.type = QMetaType::Type(cellData.typeId());
+        setTypedValue(column, row, cellData, cellString);
+        return;
+    }
+
+    bool conversionOk = true;
+    const QVariant cellData = stringToVariant(cellString, column.type, &conversionOk);
+    column.isClean = column.isClean && conversionOk;
+
+    if (conversionOk) {
+        setTypedValue(column, row, cellData, cellString);
+    } else {
+        column.rawCells.insert(row, internString(cellString.toString()));
+        setBit(column.present, row);
+    }
+}
+
+void QuickStudioCsvColumnStore::setTypedValue(Column &column,
+                                              int row,
+                                              const QVariant &value,
+                                              QStringView cellString)
+{
+    growTo(column, row + 1);
+
+    switch (column.type) {
+    case QMetaType::Double:
+        column.numbers[row] = value.toDouble();
+        break;
+    case QMetaType::Bool:
+        if (value.toBool())
+            setBit(column.bools, row);
+        break;
+    case QMetaType::QColor:
+        column.indices[row] = internColor(cellString.toString(), value.value<QColor>());
+        break;
+    default:
+        column.indices[row] = internString(value.toString());
+        break;
+    }
+
+    setBit(column.present, row);
+}
+
+void QuickStudioCsvColumnStore::growTo(Column &column, int rowCount)
+{
+    switch (column.type) {
+    case QMetaType::Double:
+        if (column.numbers.size() < rowCount)
+            column.numbers.resize(rowCount);
+        break;
+    case QMetaType::Bool:
+        if (column.bools.size() < (rowCount + 63) / 64)
+            column.bools.resize((rowCount + 63) / 64);
+        break;
+    default:
+        if (column.indices.size() < rowCount)
+            column.indices.resize(rowCount);
+        break;
+    }
+}
+
+void QuickStudioCsvColumnStore::append(const QuickStudioCsvColumnStore &chunk)
+{
+    if (chunk.m_rowCount == 0)
+        return;
+
+    QList<quint32> stringMap;
+    stringMap.reserve(chunk.m_strings.size());
+    for (const QString &value : chunk.m_strings)
+        stringMap.append(internString(value));
+
+    QList<quint32> colorMap(chunk.m_colors.size());
+    for (auto it = chunk.m_colorIndex.cbegin(); it != chunk.m_colorIndex.cend(); ++it)
+        colorMap[it.value()] = internColor(it.key(), chunk.m_colors.at(it.value()));
+
+    const int base = m_rowCount;
+    const int columns = qMin(m_columns.size(), chunk.m_columns.size());
+    for (int i = 0; i < columns; ++i) {
+        Column &dst = m_columns[i];
+        const Column &src = chunk.m_columns.at(i);
+
+        if (dst.type == QMetaType::UnknownType)
+            dst.type = src.type;
+        dst.isClean = dst.isClean && src.isClean;
+        appendBits(dst.present, base, src.present, chunk.m_rowCount);
+
+        switch (dst.type) {
+        case QMetaType::Double:
+            if (!src.numbers.isEmpty()) {
+                dst.numbers.resize(base);
+                dst.numbers.append(src.numbers);
+            }
+            break;
+        case QMetaType::Bool:
+            appendBits(dst.bools, base, src.bools, chunk.m_rowCount);
+            break;
+        case QMetaType::QColor:
+        case QMetaType::QString:
+            if (!src.indices.isEmpty()) {
+                const QList<quint32> &map = dst.type == QMetaType::QColor ? colorMap : stringMap;
+                dst.indices.resize(base);
+                dst.indices.reserve(base + src.indices.size());
+                for (quint32 index : src.indices)
+                    dst.indices.append(index < quint32(map.size()) ? map.at(index) : 0);
+            }
+            break;
+        default:
+            break;
+        }
+
+        for (auto it = src.rawCells.cbegin(); it != src.rawCells.cend(); ++it)
+            dst.rawCells.insert(base + it.key(), stringMap.at(it.value()));
+    }
+
+    m_rowCount += chunk.m_rowCount;
+    for (Column &column : m_columns)
+        column.present.resize((m_rowCount + 63) / 64);
+}
+
+// Keeps the first bitCount bits; the bits after them are cleared so that
+// appendBits() can OR new words in.
+static void truncateBits(QList<quint64> &bits, int bitCount)
+{
+    bits.resize(qMin(bits.size(), qsizetype(bitCount + 63) / 64));
+    if ((bitCount & 63) && !bits.isEmpty())
+        bits.last() &= (quint64(1) << (bitCount & 63)) - 1;
+}
+
+void QuickStudioCsvColumnStore::truncate(int rowCount)
+{
+    if (rowCount >= m_rowCount)
+        return;
+
+    for (Column &column : m_columns) {
+        truncateBits(column.present, rowCount);
+        truncateBits(column.bools, rowCount);
+        if (column.numbers.size() > rowCount)
+            column.numbers.resize(rowCount);
+        if (column.indices.size() > rowCount)
+            column.indices.resize(rowCount);
+        column.rawCells.removeIf([rowCount](const QHash<int, quint32>::iterator &it) {
+            return it.key() >= rowCount;
+        });
+    }
+    m_rowCount = rowCount;
+}
+
+quint32 QuickStudioCsvColumnStore::internString(const QString &value)
+{
+    auto it = m_stringIndex.constFind(value);
+    if (it != m_stringIndex.constEnd())
+        return it.value();
+
+    const quint32 index = quint32(m_strings.size());
+    m_strings.append(value);
+    m_stringIndex.insert(value, index);
+    return index;
+}
+
+quint32 QuickStudioCsvColumnStore::internColor(const QString &name, const QColor &color)
+{
+    auto it = m_colorIndex.constFind(name);
+    if (it != m_colorIndex.constEnd())
+        return it.value();
+
+    const quint32 index = quint32(m_colors.size());
+    m_colors.append(color);
+    m_colorIndex.insert(name, index);
+    return index;
+}
+
+QList<QMetaType::Type> QuickStudioCsvColumnStore::types() const
+{
+    QList<QMetaType::Type> result;
+    result.reserve(m_columns.size());
+    for (const Column &c : m_columns)
+        result.append(c.type);
+    return result;
+}
+
+bool QuickStudioCsvColumnStore::isPresent(int row, int column) const
+{
+    const Column &c = m_columns.at(column);
+    return row >= 0 && row < m_rowCount && testBit(c.present, row);
+}
+
+bool QuickStudioCsvColumnStore::isRaw(int row, int column) const
+{
+    return m_columns.at(column).rawCells.contains(row);
+}
+
+QVariant QuickStudioCsvColumnStore::value(int row, int column) const
+{
+    if (!isPresent(row, column))
+        return {};
+
+    const Column &c = m_columns.at(column);
+    if (!c.isClean) {
+        auto it = c.rawCells.constFind(row);
+        if (it != c.rawCells.constEnd())
+            return m_strings.at(it.value());
+    }
+
+    switch (c.type) {
+    case QMetaType::Double:
+        return c.numbers.at(row);
+    case QMetaType::Bool:
+        return testBit(c.bools, row);
+    case QMetaType::QColor:
+        return m_colors.at(c.indices.at(row));
+    default:
+        return m_strings.at(c.indices.at(row));
+    }
+}
+
+void QuickStudioCsvColumnStore::updateStats(int columnIndex, Stats *stats) const
+{
+    const Column &column = m_columns.at(columnIndex);
+    const bool numeric = column.type == QMetaType::Double;
+    const bool hasRawCells = !column.rawCells.isEmpty();
+
+    for (int row = stats->rows; row < m_rowCount; ++row) {
+        if (!testBit(column.present, row))
+            continue;
+        ++stats->count;
+        if (!numeric || (hasRawCells && column.rawCells.contains(row)))
+            continue;
+
+        // Welford's online algorithm, so appended rows update the result
+        const double value = column.numbers.at(row);
+        if (stats->numbers++ == 0) {
+            stats->min = value;
+            stats->max = value;
+        } else {
+            stats->min = qMin(stats->min, value);
+            stats->max = qMax(stats->max, value);
+        }
+        const double delta = value - stats->mean;
+        stats->mean += delta / double(stats->numbers);
+        stats->m2 += delta * (value - stats->mean);
+    }
+    stats->rows = m_rowCount;
+}
+
+qsizetype QuickStudioCsvColumnStore::memoryUsage() const
+{
+    qsizetype bytes = 0;
+    for (const Column &c : m_columns) {
+        bytes += c.numbers.capacity() * qsizetype(sizeof(double));
+        bytes += c.indices.capacity() * qsizetype(sizeof(quint32));
+        bytes += (c.bools.capacity() + c.present.capacity()) * qsizetype(sizeof(quint64));
+        bytes += c.rawCells.size() * qsizetype(sizeof(int) + sizeof(quint32) + 2 * sizeof(void *));
+    }
+    for (const QString &s : m_strings)
+        bytes += s.capacity() * qsizetype(sizeof(QChar)) + qsizetype(sizeof(QString));
+    bytes += m_colors.capacity() * qsizetype(sizeof(QColor));
+    return bytes;
+}
+
+QT_END_NAMESPACE
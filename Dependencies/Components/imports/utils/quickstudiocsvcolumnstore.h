@@ -0,0 +1,153 @@
+/****************************************************************************
+**
+** Copyright (C) 2023 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the Qt Quick Dialogs module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QUICKSTUDIOCSVCOLUMNSTORE_H
+#define QUICKSTUDIOCSVCOLUMNSTORE_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qhash.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qmetatype.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qvariant.h>
+#include <QtGui/qcolor.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Column-oriented cell storage for QuickStudioCsvTableModel.
+
+    The type of a column is inferred from its first non-empty cell. From then
+    on every cell is converted to that type and stored in a contiguous array:
+    doubles in a QList<double>, booleans in a bit vector, colors and strings as
+    32-bit indices into shared pools. A second bit vector marks which cells are
+    present. Cells that do not convert to the column type are kept verbatim in
+    a sparse per-column side table, so data() returns exactly what the
+    row-of-QVariant storage used to return.
+*/
+class QuickStudioCsvColumnStore
+{
+public:
+    struct Column
+    {
+        QMetaType::Type type = QMetaType::UnknownType;
+        bool isClean = true;
+
+        QList<double> numbers;          // QMetaType::Double
+        QList<quint32> indices;         // QMetaType::QString / QColor, index into pool
+        QList<quint64> bools;           // QMetaType::Bool
+        QList<quint64> present;         // one bit per row, set if the cell is not empty
+        QHash<int, quint32> rawCells;   // row -> string pool index, failed conversions
+    };
+
+    // Aggregates of one column. count is the number of non-empty cells; the
+    // others are only computed for Double columns, over the cells that
+    // converted. Kept up to date by folding in the rows added since.
+    struct Stats
+    {
+        int rows = 0;           // rows folded in so far
+        qsizetype count = 0;
+        qsizetype numbers = 0;
+        double min = 0;
+        double max = 0;
+        double mean = 0;
+        double m2 = 0;          // sum of squared deviations from the mean
+
+        double variance() const { return numbers > 1 ? m2 / double(numbers - 1) : 0; }
+    };
+
+    // Columns listed in types start with that type instead of inferring it
+    // (used to keep row blocks parsed separately consistent with each other).
+    void reset(int columnCount, const QList<QMetaType::Type> &types = {});
+    void reserve(int rowCount);
+
+    int rowCount() const { return m_rowCount; }
+    int columnCount() const { return int(m_columns.size()); }
+
+    // Appends one record. Extra fields are ignored, missing fields stay empty.
+    // Only cells that end up in the string pools are copied.
+    void appendRow(const QList<QStringView> &fields);
+    // Appends all rows of a store parsed separately (e.g. on a loader thread)
+    // whose column types were seeded from this one with reset(count, types()).
+    void append(const QuickStudioCsvColumnStore &chunk);
+    // Drops the rows from rowCount on. Column types are kept.
+    void truncate(int rowCount);
+
+    bool isPresent(int row, int column) const;
+    bool isRaw(int row, int column) const;
+    QMetaType::Type type(int column) const { return m_columns.at(column).type; }
+    QList<QMetaType::Type> types() const;
+    bool isClean(int column) const { return m_columns.at(column).isClean; }
+    const Column &column(int column) const { return m_columns.at(column); }
+
+    QVariant value(int row, int column) const;
+    QString string(quint32 index) const { return m_strings.at(index); }
+    QColor color(quint32 index) const { return m_colors.at(index); }
+
+    // Folds rows stats->rows .. rowCount() - 1 of column into stats
+    void updateStats(int column, Stats *stats) const;
+
+    qsizetype memoryUsage() const;
+
+private:
+    void setCell(Column &column, int row, QStringView cellString);
+    void setTypedValue(Column &column, int row, const QVariant &value, QStringView cellString);
+    void growTo(Column &column, int rowCount);
+    quint32 internString(const QString &value);
+    quint32 internColor(const QString &name, const QColor &color);
+
+    QList<Column> m_columns;
+    int m_rowCount = 0;
+
+    QList<QString> m_strings;
+    QHash<QString, quint32> m_stringIndex;
+    QList<QColor> m_colors;
+    QHash<QString, quint32> m_colorIndex;
+};
+
+QT_END_NAMESPACE
+
+#endif // QUICKSTUDIOCSVCOLUMNSTORE_H
@@ -0,0 +1,853 @@
+/****************************************************************************
+**
+** Copyright (C) 2023 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the Qt Quick Dialogs module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "quickstudiocsvsortfiltermodel.h"
+#include "quickstudiocsvtablemodel.h"
+
+#include <QElapsedTimer>
+#include <QLoggingCategory>
+#include <QThread>
+#include <QTimer>
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#ifndef Q_STATIC_LOGGING_CATEGORY // introduced with Qt 6.9
+static Q_LOGGING_CATEGORY(quickStudioCsvSortFilterModelDebug, "qt.StudioCsvSortFilterModel.debug", QtDebugMsg)
+#else
+Q_STATIC_LOGGING_CATEGORY(quickStudioCsvSortFilterModelDebug, "qt.StudioCsvSortFilterModel.debug", QtDebugMsg)
+#endif
+
+// Below this many rows per thread a single thread sorts faster
+static constexpr qsizetype MinRowsPerThread = 1 << 16;
+// Rows appended while a sort is active are merged in at most this often
+static constexpr int MergeIntervalMs = 250;
+
+using Operator = QuickStudioCsvSortFilterModel::Operator;
+using Filter = QuickStudioCsvSortFilterModel::Filter;
+
+static inline bool testBit(const QList<quint64> &bits, qsizetype index)
+{
+    const qsizetype word = index >> 6;
+    return word < bits.size() && ((bits.at(word) >> (index & 63)) & 1);
+}
+
+// The 64 bits of bits starting at bit index begin
+static inline quint64 bitsFrom(const QList<quint64> &bits, qsizetype begin)
+{
+    const qsizetype word = begin >> 6;
+    const int shift = int(begin & 63);
+    quint64 result = word < bits.size() ? bits.at(word) >> shift : 0;
+    if (shift && word + 1 < bits.size())
+        result |= bits.at(word + 1) << (64 - shift);
+    return result;
+}
+
+static bool parseOperator(const QString &text, Operator *op)
+{
+    static const QHash<QString, Operator> operators = {
+        {QStringLiteral("<"), Operator::Less},
+        {QStringLiteral("<="), Operator::LessEqual},
+        {QStringLiteral(">"), Operator::Greater},
+        {QStringLiteral(">="), Operator::GreaterEqual},
+        {QStringLiteral("=="), Operator::Equal},
+        {QStringLiteral("="), Operator::Equal},
+        {QStringLiteral("!="), Operator::NotEqual},
+        {QStringLiteral("contains"), Operator::Contains},
+    };
+
+    auto it = operators.constFind(text.trimmed().toLower());
+    if (it == operators.constEnd())
+        return false;
+    *op = it.value();
+    return true;
+}
+
+static inline bool holds(Operator op, int comparison)
+{
+    switch (op) {
+    case Operator::Less:
+        return comparison < 0;
+    case Operator::LessEqual:
+        return comparison <= 0;
+    case Operator::Greater:
+        return comparison > 0;
+    case Operator::GreaterEqual:
+        return comparison >= 0;
+    case Operator::Equal:
+        return comparison == 0;
+    case Operator::NotEqual:
+        return comparison != 0;
+    case Operator::Contains:
+        break;
+    }
+    return false;
+}
+
+// Predicate for cells that are not stored typed (strings, raw cells): numeric
+// comparison if both sides are numbers, string comparison otherwise.
+static bool matchesText(const QString &cell, const Filter &filter)
+{
+    const QString value = filter.value.toString();
+    if (filter.op == Operator::Contains)
+        return cell.contains(value, Qt::CaseInsensitive);
+
+    bool cellIsNumber = false;
+    bool valueIsNumber = false;
+    const double cellNumber = cell.toDouble(&cellIsNumber);
+    const double valueNumber = value.toDouble(&valueIsNumber);
+    if (cellIsNumber && valueIsNumber)
+        return holds(filter.op, cellNumber < valueNumber ? -1 : cellNumber > valueNumber ? 1 : 0);
+
+    return holds(filter.op, QString::compare(cell, value));
+}
+
+// Sets bit i of mask if compare(numbers[first + i], value). Branch-free so
+// that the inner loop is vectorized.
+template <typename Compare>
+static void compareNumbers(const QList<double> &numbers,
+                           qsizetype first,
+                           qsizetype count,
+                           double value,
+                           Compare compare,
+                           QList<quint64> &mask)
+{
+    const double *data = numbers.constData();
+    for (qsizetype word = 0; word < mask.size(); ++word) {
+        const qsizetype begin = first + word * 64;
+        const qsizetype end = qMin(qMin(begin + 64, first + count), numbers.size());
+        quint64 bits = 0;
+        for (qsizetype i = begin; i < end; ++i)
+            bits |= quint64(compare(data[i], value)) << (i - begin);
+        mask[word] = bits;
+    }
+}
+
+static bool compareNumbers(Operator op,
+                           const QList<double> &numbers,
+                           qsizetype first,
+                           qsizetype count,
+                           double value,
+                           QList<quint64> &mask)
+{
+    switch (op) {
+    case Operator::Less:
+        compareNumbers(numbers, first, count, value, std::less<double>(), mask);
+        return true;
+    case Operator::LessEqual:
+        compareNumbers(numbers, first, count, value, std::less_equal<double>(), mask);
+        return true;
+    case Operator::Greater:
+        compareNumbers(numbers, first, count, value, std::greater<double>(), mask);
+        return true;
+    case Operator::GreaterEqual:
+        compareNumbers(numbers, first, count, value, std::greater_equal<double>(), mask);
+        return true;
+    case Operator::Equal:
+        compareNumbers(numbers, first, count, value, std::equal_to<double>(), mask);
+        return true;
+    case Operator::NotEqual:
+        compareNumbers(numbers, first, count, value, std::not_equal_to<double>(), mask);
+        return true;
+    case Operator::Contains:
+        break;
+    }
+    return false;
+}
+
+// Rows first .. first + count - 1 of the column that match filter, as a bit mask
+static QList<quint64> filterMask(const QuickStudioCsvColumnStore &store,
+                                 const Filter &filter,
+                                 qsizetype first,
+                                 qsizetype count)
+{
+    const qsizetype words = (count + 63) / 64;
+    QList<quint64> mask(words, 0);
+    if (filter.column < 0 || filter.column >= store.columnCount())
+        return mask;
+
+    const QuickStudioCsvColumnStore::Column &column = store.column(filter.column);
+    bool typed = false;
+
+    switch (column.type) {
+    case QMetaType::Double: {
+        bool isNumber = false;
+        const double value = filter.value.toDouble(&isNumber);
+        typed = isNumber && compareNumbers(filter.op, column.numbers, first, count, value, mask);
+        break;
+    }
+    case QMetaType::Bool:
+        if (filter.op == Operator::Equal || filter.op == Operator::NotEqual) {
+            const bool wanted = filter.value.toBool() == (filter.op == Operator::Equal);
+            for (qsizetype word = 0; word < words; ++word) {
+                const quint64 bits = bitsFrom(column.bools, first + word * 64);
+                mask[word] = wanted ? bits : ~bits;
+            }
+            typed = true;
+        }
+        break;
+    case QMetaType::QString: {
+        // Evaluated once per distinct string
+        QList<qint8> matches;
+        for (qsizetype i = 0; i < count; ++i) {
+            const qsizetype row = first + i;
+            if (row >= column.indices.size())
+                break;
+            const quint32 index = column.indices.at(row);
+            if (index >= quint32(matches.size()))
+                matches.resize(index + 1, -1);
+            if (matches.at(index) < 0)
+                matches[index] = ::matchesText(store.string(index), filter) ? 1 : 0;
+            if (matches.at(index))
+                mask[i >> 6] |= quint64(1) << (i & 63);
+        }
+        typed = true;
+        break;
+    }
+    default:
+        break;
+    }
+
+    if (!typed) {
+        for (qsizetype i = 0; i < count; ++i) {
+            if (::matchesText(store.value(int(first + i), filter.column).toString(), filter))
+                mask[i >> 6] |= quint64(1) << (i & 63);
+        }
+    }
+
+    // Empty cells never match
+    for (qsizetype word = 0; word < words; ++word)
+        mask[word] &= bitsFrom(column.present, first + word * 64);
+    if (words && (count & 63))
+        mask.last() &= (quint64(1) << (count & 63)) - 1;
+
+    // Cells that did not convert to the column type are compared as text
+    if (typed) {
+        for (auto it = column.rawCells.cbegin(); it != column.rawCells.cend(); ++it) {
+            const qsizetype i = it.key() - first;
+            if (i < 0 || i >= count)
+                continue;
+            const quint64 bit = quint64(1) << (i & 63);
+            if (::matchesText(store.string(it.value()), filter))
+                mask[i >> 6] |= bit;
+            else
+                mask[i >> 6] &= ~bit;
+        }
+    }
+
+    return mask;
+}
+
+struct SortEntry
+{
+    quint64 key;
+    quint32 row;
+};
+
+// Maps a double to an unsigned integer with the same order
+static inline quint64 orderedBits(double value)
+{
+    quint64 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const quint64 sign = quint64(1) << 63;
+    return (bits & sign) ? ~bits : bits | sign;
+}
+
+// Stable LSD radix sort, one byte per pass. Passes over bytes that are the
+// same in every key are skipped, so small keys cost few passes.
+static void radixSort(SortEntry *entries, SortEntry *scratch, qsizetype count)
+{
+    if (count < 2)
+        return;
+
+    quint64 differing = 0;
+    const quint64 firstKey = entries[0].key;
+    for (qsizetype i = 1; i < count; ++i)
+        differing |= entries[i].key ^ firstKey;
+
+    SortEntry *source = entries;
+    SortEntry *target = scratch;
+    for (int shift = 0; shift < 64; shift += 8) {
+        if (!((differing >> shift) & 0xff))
+            continue;
+
+        qsizetype offsets[256] = {};
+        for (qsizetype i = 0; i < count; ++i)
+            ++offsets[(source[i].key >> shift) & 0xff];
+        qsizetype total = 0;
+        for (qsizetype &offset : offsets) {
+            const qsizetype bucket = offset;
+            offset = total;
+            total += bucket;
+        }
+        for (qsizetype i = 0; i < count; ++i)
+            target[offsets[(source[i].key >> shift) & 0xff]++] = source[i];
+        std::swap(source, target);
+    }
+
+    if (source != entries)
+        std::copy(source, source + count, entries);
+}
+
+// Orders two rows the way sortRows() does: typed cells by value, then cells
+// that did not convert to the column type as text, then empty cells.
+static bool sortsBefore(const QuickStudioCsvColumnStore &store,
+                        const QuickStudioCsvColumnStore::Column &column,
+                        bool descending,
+                        int a,
+                        int b)
+{
+    auto cellClass = [&column](int row) {
+        if (!::testBit(column.present, row))
+            return 2;
+        return column.rawCells.contains(row) ? 1 : 0;
+    };
+
+    const int classA = cellClass(a);
+    const int classB = cellClass(b);
+    if (classA != classB)
+        return classA < classB;
+
+    int comparison = 0;
+    if (classA == 1) {
+        comparison = QString::compare(store.string(column.rawCells.value(a)),
+                                      store.string(column.rawCells.value(b)));
+    } else if (classA == 0) {
+        auto compareKeys = [](quint64 x, quint64 y) { return x < y ? -1 : x > y ? 1 : 0; };
+        switch (column.type) {
+        case QMetaType::Double:
+            comparison = compareKeys(::orderedBits(column.numbers.at(a)),
+                                     ::orderedBits(column.numbers.at(b)));
+            break;
+        case QMetaType::Bool:
+            comparison = int(::testBit(column.bools, a)) - int(::testBit(column.bools, b));
+            break;
+        case QMetaType::QString:
+            comparison = QString::compare(store.string(column.indices.at(a)),
+                                          store.string(column.indices.at(b)));
+            break;
+        case QMetaType::QColor:
+            comparison = compareKeys(store.color(column.indices.at(a)).rgba(),
+                                     store.color(column.indices.at(b)).rgba());
+            break;
+        default:
+            break;
+        }
+    }
+    return descending ? comparison > 0 : comparison < 0;
+}
+
+// Radix sorts one slice per thread, then merges the slices pairwise, also in
+// parallel. std::merge takes from the left slice on ties, so the result is
+// stable like a single radix sort.
+static void parallelSort(QList<SortEntry> &entries)
+{
+    const qsizetype count = entries.size();
+    const int threads = int(qBound<qsizetype>(1, QThread::idealThreadCount(), count / MinRowsPerThread));
+
+    QList<SortEntry> scratch(count);
+    SortEntry *data = entries.data();
+    SortEntry *buffer = scratch.data();
+
+    QList<qsizetype> bounds;
+    for (int i = 0; i <= threads; ++i)
+        bounds.append(count * i / threads);
+
+    auto runParallel = [](int jobs, const std::function<void(int)> &job) {
+        std::vector<std::thread> workers;
+        for (int i = 1; i < jobs; ++i)
+            workers.emplace_back(job, i);
+        job(0);
+        for (std::thread &worker : workers)
+            worker.join();
+    };
+
+    runParallel(threads, [&](int slice) {
+        radixSort(data + bounds[slice], buffer + bounds[slice], bounds[slice + 1] - bounds[slice]);
+    });
+
+    for (int width = 1; width < threads; width *= 2) {
+        const int pairs = (threads + 2 * width - 1) / (2 * width);
+        runParallel(pairs, [&](int pair) {
+            const qsizetype begin = bounds[pair * 2 * width];
+            const qsizetype middle = bounds[qMin(pair * 2 * width + width, threads)];
+            const qsizetype end = bounds[qMin(pair * 2 * width + 2 * width, threads)];
+            std::merge(data + begin, data + middle, data + middle, data + end, buffer + begin,
+                       [](const SortEntry &a, const SortEntry &b) { return a.key < b.key; });
+        });
+        std::swap(data, buffer);
+    }
+
+    if (data != entries.data())
+        std::copy(data, data + count, entries.data());
+}
+
+QuickStudioCsvSortFilterModel::QuickStudioCsvSortFilterModel(QObject *parent)
+    : QAbstractProxyModel(parent)
+    , m_mergeTimer(new QTimer(this))
+{
+    m_mergeTimer->setSingleShot(true);
+    m_mergeTimer->setInterval(MergeIntervalMs);
+    connect(m_mergeTimer, &QTimer::timeout, this, &QuickStudioCsvSortFilterModel::mergeAppendedRows);
+}
+
+void QuickStudioCsvSortFilterModel::setSourceModel(QAbstractItemModel *sourceModel)
+{
+    if (sourceModel == this->sourceModel())
+        return;
+
+    beginResetModel();
+
+    for (const QMetaObject::Connection &connection : std::as_const(m_sourceConnections))
+        disconnect(connection);
+    m_sourceConnections.clear();
+    m_mergeTimer->stop();
+    m_appendedFrom = -1;
+
+    QAbstractProxyModel::setSourceModel(sourceModel);
+    m_csvModel = qobject_cast<QuickStudioCsvTableModel *>(sourceModel);
+
+    if (sourceModel) {
+        if (!m_csvModel)
+            qWarning() << "CsvSortFilterModel: source model is not a CsvTableModel, rows are passed through";
+
+        m_sourceConnections << connect(sourceModel, &QAbstractItemModel::modelReset,
+                                       this, &QuickStudioCsvSortFilterModel::rebuild);
+        m_sourceConnections << connect(sourceModel, &QAbstractItemModel::layoutChanged,
+                                       this, &QuickStudioCsvSortFilterModel::rebuild);
+        m_sourceConnections << connect(sourceModel, &QAbstractItemModel::rowsRemoved,
+                                       this, &QuickStudioCsvSortFilterModel::rebuild);
+        m_sourceConnections << connect(sourceModel, &QAbstractItemModel::rowsInserted, this,
+                                       [this](const QModelIndex &parent, int first, int last) {
+                                           if (!parent.isValid())
+                                               appendSourceRows(first, last);
+                                       });
+        m_sourceConnections << connect(sourceModel, &QAbstractItemModel::headerDataChanged,
+                                       this, &QAbstractItemModel::headerDataChanged);
+    }
+
+    m_rows = sourceModel ? mappedRows(0, sourceModel->rowCount() - 1) : QList<int>();
+    m_sortedType = sortType();
+    m_sourceToProxy.clear();
+
+    endResetModel();
+}
+
+QModelIndex QuickStudioCsvSortFilterModel::index(int row, int column, const QModelIndex &parent) const
+{
+    if (parent.isValid() || row < 0 || row >= m_rows.size() || column < 0
+        || column >= columnCount())
+        return {};
+    return createIndex(row, column);
+}
+
+QModelIndex QuickStudioCsvSortFilterModel::parent([[maybe_unused]] const QModelIndex &child) const
+{
+    return {};
+}
+
+int QuickStudioCsvSortFilterModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : int(m_rows.size());
+}
+
+int QuickStudioCsvSortFilterModel::columnCount(const QModelIndex &parent) const
+{
+    if (parent.isValid() || !sourceModel())
+        return 0;
+    return sourceModel()->columnCount();
+}
+
+QModelIndex QuickStudioCsvSortFilterModel::mapToSource(const QModelIndex &proxyIndex) const
+{
+    if (!proxyIndex.isValid() || !sourceModel() || proxyIndex.row() >= m_rows.size())
+        return {};
+    return sourceModel()->index(m_rows.at(proxyIndex.row()), proxyIndex.column());
+}
+
+QModelIndex QuickStudioCsvSortFilterModel::mapFromSource(const QModelIndex &sourceIndex) const
+{
+    if (!sourceIndex.isValid() || !sourceModel())
+        return {};
+
+    if (m_sourceToProxy.isEmpty() && !m_rows.isEmpty()) {
+        m_sourceToProxy.fill(-1, sourceModel()->rowCount());
+        for (int row = 0; row < m_rows.size(); ++row) {
+            if (m_rows.at(row) < m_sourceToProxy.size())
+                m_sourceToProxy[m_rows.at(row)] = row;
+        }
+    }
+
+    const int row = sourceIndex.row() < m_sourceToProxy.size()
+                        ? m_sourceToProxy.at(sourceIndex.row())
+                        : -1;
+    return row < 0 ? QModelIndex() : index(row, sourceIndex.column());
+}
+
+void QuickStudioCsvSortFilterModel::sort(int column, Qt::SortOrder order)
+{
+    if (m_sortColumn == column && m_sortOrder == order)
+        return;
+
+    m_sortColumn = column;
+    m_sortOrder = order;
+    emit sortChanged();
+    rebuild();
+}
+
+int QuickStudioCsvSortFilterModel::sortColumn() const
+{
+    return m_sortColumn;
+}
+
+void QuickStudioCsvSortFilterModel::setSortColumn(int column)
+{
+    sort(column, m_sortOrder);
+}
+
+Qt::SortOrder QuickStudioCsvSortFilterModel::sortOrder() const
+{
+    return m_sortOrder;
+}
+
+void QuickStudioCsvSortFilterModel::setSortOrder(Qt::SortOrder order)
+{
+    sort(m_sortColumn, order);
+}
+
+int QuickStudioCsvSortFilterModel::filterCount() const
+{
+    return int(m_filters.size());
+}
+
+bool QuickStudioCsvSortFilterModel::addFilter(const QVariant &column,
+                                              const QString &op,
+                                              const QVariant &value)
+{
+    Filter filter;
+    filter.column = resolveColumn(column);
+    filter.value = value;
+    if (filter.column < 0 || !::parseOperator(op, &filter.op)) {
+        qWarning() << "CsvSortFilterModel: invalid filter" << column << op << value;
+        return false;
+    }
+
+    m_filters.append(filter);
+    emit filtersChanged();
+    rebuild();
+    return true;
+}
+
+void QuickStudioCsvSortFilterModel::clearFilters()
+{
+    if (m_filters.isEmpty())
+        return;
+
+    m_filters.clear();
+    emit filtersChanged();
+    rebuild();
+}
+
+int QuickStudioCsvSortFilterModel::sourceRow(int row) const
+{
+    return row >= 0 && row < m_rows.size() ? m_rows.at(row) : -1;
+}
+
+int QuickStudioCsvSortFilterModel::resolveColumn(const QVariant &column) const
+{
+    if (!sourceModel())
+        return -1;
+
+    const int columns = sourceModel()->columnCount();
+    if (column.typeId() == QMetaType::QString) {
+        const QString name = column.toString();
+        for (int i = 0; i < columns; ++i) {
+            if (sourceModel()->headerData(i, Qt::Horizontal).toString() == name)
+                return i;
+        }
+        return -1;
+    }
+
+    bool ok = false;
+    const int index = column.toInt(&ok);
+    return ok && index >= 0 && index < columns ? index : -1;
+}
+
+void QuickStudioCsvSortFilterModel::rebuild()
+{
+    beginResetModel();
+    m_mergeTimer->stop();
+    m_appendedFrom = -1;
+    m_rows = sourceModel() ? mappedRows(0, sourceModel()->rowCount() - 1) : QList<int>();
+    m_sortedType = sortType();
+    m_sourceToProxy.clear();
+    endResetModel();
+}
+
+// Type of the sort column in the source's column store, if sorting applies
+QMetaType::Type QuickStudioCsvSortFilterModel::sortType() const
+{
+    const QuickStudioCsvColumnStore *store = m_csvModel ? m_csvModel->columnStore() : nullptr;
+    if (!store || m_sortColumn < 0 || m_sortColumn >= store->columnCount())
+        return QMetaType::UnknownType;
+    return store->column(m_sortColumn).type;
+}
+
+/*
+    Rows appended to the source are filtered and appended to the proxy. While
+    a sort is active they are merged in a little later, see mergeAppendedRows().
+*/
+void QuickStudioCsvSortFilterModel::appendSourceRows(int first, int last)
+{
+    if (last != sourceModel()->rowCount() - 1) {
+        rebuild();
+        return;
+    }
+
+    if (m_sortColumn >= 0 && m_csvModel && m_csvModel->columnStore()) {
+        if (m_appendedFrom < 0)
+            m_appendedFrom = first;
+        if (!m_mergeTimer->isActive())
+            m_mergeTimer->start();
+        return;
+    }
+
+    const QList<int> rows = mappedRows(first, last);
+    if (rows.isEmpty())
+        return;
+
+    beginInsertRows({}, int(m_rows.size()), int(m_rows.size() + rows.size()) - 1);
+    m_rows.append(rows);
+    m_sourceToProxy.clear();
+    endInsertRows();
+}
+
+/*
+    Sorts the rows appended since the last merge on their own and merges them
+    into the sorted rows, so the cost is that of the new rows plus one linear
+    merge rather than a full sort and model reset. The new rows are first
+    inserted at the end, then moved to their places with a layout change that
+    keeps persistent indexes (current row, selection) on their rows. The
+    merge keeps older rows first among equal keys, as a full stable sort of
+    the source would.
+*/
+void QuickStudioCsvSortFilterModel::mergeAppendedRows()
+{
+    const int first = m_appendedFrom;
+    m_appendedFrom = -1;
+    const QuickStudioCsvColumnStore *store = m_csvModel ? m_csvModel->columnStore() : nullptr;
+    if (first < 0 || !store)
+        return;
+
+    // The sort column got its type only with the new rows
+    if (sortType() != m_sortedType) {
+        rebuild();
+        return;
+    }
+
+    const QList<int> rows = mappedRows(first, sourceModel()->rowCount() - 1);
+    if (rows.isEmpty())
+        return;
+
+    const qsizetype sorted = m_rows.size();
+    beginInsertRows({}, int(sorted), int(sorted + rows.size()) - 1);
+    m_rows.append(rows);
+    m_sourceToProxy.clear();
+    endInsertRows();
+
+    if (m_sortColumn >= store->columnCount())
+        return;
+
+    emit layoutAboutToBeChanged({}, QAbstractItemModel::VerticalSortHint);
+    const QModelIndexList persistent = persistentIndexList();
+    QList<int> persistentRows;
+    persistentRows.reserve(persistent.size());
+    for (const QModelIndex &index : persistent)
+        persistentRows.append(m_rows.at(index.row()));
+
+    const QuickStudioCsvColumnStore::Column &column = store->column(m_sortColumn);
+    const bool descending = m_sortOrder == Qt::DescendingOrder;
+    std::inplace_merge(m_rows.begin(), m_rows.begin() + sorted, m_rows.end(),
+                       [&](int a, int b) { return ::sortsBefore(*store, column, descending, a, b); });
+    m_sourceToProxy.clear();
+
+    QModelIndexList moved;
+    moved.reserve(persistent.size());
+    for (qsizetype i = 0; i < persistent.size(); ++i) {
+        const QModelIndex sourceIndex = sourceModel()->index(persistentRows.at(i),
+                                                             persistent.at(i).column());
+        moved.append(mapFromSource(sourceIndex));
+    }
+    changePersistentIndexList(persistent, moved);
+    emit layoutChanged({}, QAbstractItemModel::VerticalSortHint);
+}
+
+// The proxy rows for source rows first .. last: filtered, then sorted
+QList<int> QuickStudioCsvSortFilterModel::mappedRows(int first, int last) const
+{
+    QList<int> rows;
+    if (last < first)
+        return rows;
+
+    const QuickStudioCsvColumnStore *store = m_csvModel ? m_csvModel->columnStore() : nullptr;
+    if (!store || (m_filters.isEmpty() && m_sortColumn < 0)) {
+        rows.reserve(last - first + 1);
+        for (int row = first; row <= last; ++row)
+            rows.append(row);
+        return rows;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    rows = filteredRows(*store, first, last);
+    if (m_sortColumn >= 0 && m_sortColumn < store->columnCount())
+        sortRows(*store, rows);
+
+    qCDebug(quickStudioCsvSortFilterModelDebug) << Q_FUNC_INFO << last - first + 1 << "rows ->"
+                                                << rows.size() << "in" << timer.elapsed() << "ms";
+    return rows;
+}
+
+QList<int> QuickStudioCsvSortFilterModel::filteredRows(const QuickStudioCsvColumnStore &store,
+                                                       int first,
+                                                       int last) const
+{
+    const qsizetype count = last - first + 1;
+    QList<quint64> mask((count + 63) / 64, ~quint64(0));
+    if (count & 63)
+        mask.last() = (quint64(1) << (count & 63)) - 1;
+
+    for (const Filter &filter : m_filters) {
+        const QList<quint64> matches = ::filterMask(store, filter, first, count);
+        for (qsizetype word = 0; word < mask.size(); ++word)
+            mask[word] &= matches.at(word);
+    }
+
+    QList<int> rows;
+    for (qsizetype word = 0; word < mask.size(); ++word) {
+        quint64 bits = mask.at(word);
+        while (bits) {
+            rows.append(first + int(word * 64) + qCountTrailingZeroBits(bits));
+            bits &= bits - 1;
+        }
+    }
+    return rows;
+}
+
+void QuickStudioCsvSortFilterModel::sortRows(const QuickStudioCsvColumnStore &store,
+                                             QList<int> &rows) const
+{
+    const QuickStudioCsvColumnStore::Column &column = store.column(m_sortColumn);
+    const bool descending = m_sortOrder == Qt::DescendingOrder;
+
+    // Strings sort by rank among the distinct strings of the column
+    QList<quint32> ranks;
+    if (column.type == QMetaType::QString) {
+        QList<quint32> distinct;
+        QList<bool> seen;
+        for (int row : std::as_const(rows)) {
+            if (row >= column.indices.size() || !::testBit(column.present, row))
+                continue;
+            const quint32 index = column.indices.at(row);
+            if (index >= quint32(seen.size()))
+                seen.resize(index + 1, false);
+            if (!seen.at(index)) {
+                seen[index] = true;
+                distinct.append(index);
+            }
+        }
+        std::sort(distinct.begin(), distinct.end(), [&store](quint32 a, quint32 b) {
+            return QString::compare(store.string(a), store.string(b)) < 0;
+        });
+        ranks.resize(seen.size());
+        for (qsizetype i = 0; i < distinct.size(); ++i)
+            ranks[distinct.at(i)] = quint32(i);
+    }
+
+    QList<SortEntry> entries;
+    entries.reserve(rows.size());
+    QList<int> rawRows;
+    QList<int> emptyRows;
+    const bool hasRawCells = !column.rawCells.isEmpty();
+
+    for (int row : std::as_const(rows)) {
+        if (!::testBit(column.present, row)) {
+            emptyRows.append(row);
+            continue;
+        }
+        if (hasRawCells && column.rawCells.contains(row)) {
+            rawRows.append(row);
+            continue;
+        }
+
+        quint64 key = 0;
+        switch (column.type) {
+        case QMetaType::Double:
+            key = ::orderedBits(column.numbers.at(row));
+            break;
+        case QMetaType::Bool:
+            key = ::testBit(column.bools, row);
+            break;
+        case QMetaType::QString:
+            key = ranks.at(column.indices.at(row));
+            break;
+        case QMetaType::QColor:
+            key = store.color(column.indices.at(row)).rgba();
+            break;
+        default:
+            break;
+        }
+        entries.append({descending ? ~key : key, quint32(row)});
+    }
+
+    ::parallelSort(entries);
+
+    std::stable_sort(rawRows.begin(), rawRows.end(), [&](int a, int b) {
+        const int comparison = QString::compare(store.string(column.rawCells.value(a)),
+                                                store.string(column.rawCells.value(b)));
+        return descending ? comparison > 0 : comparison < 0;
+    });
+
+    rows.clear();
+    for (const SortEntry &entry : std::as_const(entries))
+        rows.append(int(entry.row));
+    rows.append(rawRows);
+    rows.append(emptyRows);
+}
@@ -0,0 +1,153 @@
+/****************************************************************************
+**
+** Copyright (C) 2023 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the Qt Quick Dialogs module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QUICKSTUDIOCSVSORTFILTERMODEL_P_H
+#define QUICKSTUDIOCSVSORTFILTERMODEL_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QAbstractProxyModel>
+#include <QtQml/qqml.h>
+
+QT_BEGIN_NAMESPACE
+
+class QTimer;
+class QuickStudioCsvColumnStore;
+class QuickStudioCsvTableModel;
+
+/*
+    Sorting and filtering proxy for CsvTableModel.
+
+    Unlike QSortFilterProxyModel it does not go through data() and QVariant:
+    filters are evaluated column-wise over the typed arrays of the source's
+    column store into row bit masks, and sorting orders a permutation of the
+    remaining rows by precomputed integer keys (radix sort per thread, then
+    stable merges). Cells of another type than their column sort after the
+    typed ones, empty cells last.
+
+    Rows appended to the source are filtered and appended without a reset. With
+    a sort active they are collected for a short while, sorted on their own and
+    merged into the sorted rows as a layout change.
+    In lazy loading mode the source has no column store and rows are passed
+    through unchanged.
+*/
+class QuickStudioCsvSortFilterModel : public QAbstractProxyModel
+{
+    Q_OBJECT
+
+    QML_NAMED_ELEMENT(CsvSortFilterModel)
+    QML_ADDED_IN_VERSION(6, 2)
+
+    Q_PROPERTY(int sortColumn READ sortColumn WRITE setSortColumn NOTIFY sortChanged)
+    Q_PROPERTY(Qt::SortOrder sortOrder READ sortOrder WRITE setSortOrder NOTIFY sortChanged)
+    Q_PROPERTY(int filterCount READ filterCount NOTIFY filtersChanged)
+
+public:
+    enum class Operator { Less, LessEqual, Greater, GreaterEqual, Equal, NotEqual, Contains };
+
+    struct Filter
+    {
+        int column = -1;
+        Operator op = Operator::Equal;
+        QVariant value;
+    };
+
+    explicit QuickStudioCsvSortFilterModel(QObject *parent = nullptr);
+
+    void setSourceModel(QAbstractItemModel *sourceModel) override;
+
+    QModelIndex index(int row, int column, const QModelIndex &parent = {}) const override;
+    QModelIndex parent(const QModelIndex &child) const override;
+    int rowCount(const QModelIndex &parent = {}) const override;
+    int columnCount(const QModelIndex &parent = {}) const override;
+    QModelIndex mapToSource(const QModelIndex &proxyIndex) const override;
+    QModelIndex mapFromSource(const QModelIndex &sourceIndex) const override;
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+    int sortColumn() const;
+    void setSortColumn(int column);
+    Qt::SortOrder sortOrder() const;
+    void setSortOrder(Qt::SortOrder order);
+    int filterCount() const;
+
+    // column is an index or a header name; op is one of
+    // < <= > >= == != contains. Filters are combined with AND.
+    Q_INVOKABLE bool addFilter(const QVariant &column, const QString &op, const QVariant &value);
+    Q_INVOKABLE void clearFilters();
+    Q_INVOKABLE int sourceRow(int row) const;
+
+signals:
+    void sortChanged();
+    void filtersChanged();
+
+private:
+    void rebuild();
+    void appendSourceRows(int first, int last);
+    void mergeAppendedRows();
+    QMetaType::Type sortType() const;
+    QList<int> mappedRows(int first, int last) const;
+    QList<int> filteredRows(const QuickStudioCsvColumnStore &store, int first, int last) const;
+    void sortRows(const QuickStudioCsvColumnStore &store, QList<int> &rows) const;
+    int resolveColumn(const QVariant &column) const;
+
+    QuickStudioCsvTableModel *m_csvModel = nullptr;
+    QList<QMetaObject::Connection> m_sourceConnections;
+    QTimer *m_mergeTimer = nullptr;
+    int m_appendedFrom = -1;            // first source row not merged yet
+
+    QList<Filter> m_filters;
+    int m_sortColumn = -1;
+    Qt::SortOrder m_sortOrder = Qt::AscendingOrder;
+    QMetaType::Type m_sortedType = QMetaType::UnknownType; // of the sort column when sorted
+
+    QList<int> m_rows;                  // proxy row -> source row
+    mutable QList<int> m_sourceToProxy; // built on first mapFromSource()
+};
+
+QT_END_NAMESPACE
+
+QML_DECLARE_TYPE(QuickStudioCsvSortFilterModel)
+
+#endif // QUICKSTUDIOCSVSORTFILTERMODEL_P_H
@@ -36,109 +36,18 @@
 
 #include "quickstudiocsvtablemodel.h"
 
-#include <QColor>
+#include <QElapsedTimer>
 #include <QFile>
 #include <QFileInfo>
 #include <QFileSystemWatcher>
 #include <QLoggingCategory>
-#include <QRegularExpression>
-#include <QTextStream>
+#include <QPromise>
+#include <QThread>
+#include <QThreadPool>
+#include <QTimer>
 
-static inline QColor fromString(const QString &colorName)
-{
-#if QT_VERSION >= QT_VERSION_CHECK(6, 4, 0)
-    return QColor::fromString(colorName);
-#else
-    return colorName;
-#endif // >= Qt 6.4
-}
-
-static inline bool isValidColorName(const QString &colorName)
-{
-#if QT_VERSION >= QT_VERSION_CHECK(6, 4, 0)
-    return QColor::isValidColorName(colorName);
-#else
-    constexpr QStringView colorPattern(
-        u"(?<color>^(?:#(?:(?:[0-9a-fA-F]{2}){3,4}|(?:[0-9a-fA-F]){3,4}))$)");
-    static QRegularExpression colorRegex(colorPattern.toString());
-    return colorRegex.match(colorName).hasMatch();
-#endif // >= Qt 6.4
-}
-
-static QVariant stringToVariant(const QString &value)
-{
-    constexpr QStringView typesPattern{u"(?<boolean>^(?:true|false)$)|"
-                                       u"(?<number>^(?:-?(?:0|[1-9]\\d*)?(?:\\.\\d*)?(?<=\\d|\\.)"
-                                       u"(?:e-?(?:0|[1-9]\\d*))?|0x[0-9a-f]+)$)|"
-                                       u"(?<color>^(?:#(?:(?:[0-9a-fA-F]{2}){3,4}|"
-                                       u"(?:[0-9a-fA-F]){3,4}))$)"};
-
-    static QRegularExpression validator(typesPattern.toString());
-    const QString trimmedValue = value.trimmed();
-    QRegularExpressionMatch match = validator.match(trimmedValue);
-
-    if (!match.hasMatch())
-        return value;
-
-    if (!match.captured(u"boolean").isEmpty())
-        return QVariant::fromValue<bool>(trimmedValue.at(0).toLower() == u't');
-
-    if (!match.captured(u"number").isEmpty())
-        return trimmedValue.toDouble();
-
-    if (!match.captured(u"color").isEmpty())
-        return ::fromString(trimmedValue);
-
-    return value;
-}
-
-static QVariant stringToVariant(const QString &value, QMetaType::Type type, bool *ok = nullptr)
-{
-    if (type == QMetaType::Bool) {
-        const QString lowerValue = value.toLower().trimmed();
-        bool conversionOk = true;
-        bool booleanValue = false;
-
-        if (lowerValue == u"true")
-            booleanValue = true;
-        else if (lowerValue == u"false")
-            booleanValue = false;
-        else
-            conversionOk = false;
-
-        if (ok)
-            *ok = conversionOk;
-
-        if (conversionOk)
-            return booleanValue;
-    }
-
-    if (type == QMetaType::Double) {
-        bool conversionOk = false;
-        double numericValue = value.toDouble(&conversionOk);
-        if (ok)
-            *ok = conversionOk;
-
-        if (conversionOk)
-            return numericValue;
-    }
-
-    if (type == QMetaType::QColor) {
-        bool conversionOk = ::isValidColorName(value);
-        if (ok)
-            *ok = conversionOk;
-
-        if (conversionOk)
-            return ::fromString(value);
-    }
-
-    if (type == QMetaType::QString) {
-        if (ok)
-            *ok = !value.isEmpty();
-    }
-
-    return value;
-}
+#include <cmath>
+#include <cstring>
 
 static QString urlToLocalPath(const QUrl &url)
 {
@@ -161,20 +70,138 @@ static Q_LOGGING_CATEGORY(quickStudioCsvTableModelDebug, "qt.StudioCsvTableModel
 Q_STATIC_LOGGING_CATEGORY(quickStudioCsvTableModelDebug, "qt.StudioCsvTableModel.debug", QtDebugMsg)
 #endif
 
+// Lazy loading: the first bytes are indexed before the model reset completes,
+// the rest in chunks from the event loop, so time-to-first-row does not depend
+// on the file size.
+static constexpr qint64 InitialIndexBytes = 1 << 20;
+static constexpr qint64 IndexChunkBytes = 16 << 20;
+static constexpr int BlockRows = 256;
+static constexpr int BlockCacheSize = 16;
+
+// Background loading: a chunk is published after this many rows or this much
+// time, whichever comes first, so the first rows show up quickly.
+static constexpr int LoadChunkRows = 16384;
+static constexpr qint64 LoadChunkMs = 50;
+static constexpr qint64 ReadChunkBytes = 1 << 20;
+
+// Tail following: an append is recognized by the file having grown and the
+// last TailCheckBytes bytes known so far being unchanged.
+static constexpr qint64 TailCheckBytes = 4096;
+
+static size_t tailChecksum(const char *data, qint64 size)
+{
+    const qint64 begin = qMax<qint64>(0, size - TailCheckBytes);
+    return qHash(QByteArrayView(data + begin, size - begin));
+}
+
+static size_t tailChecksum(QFile &file, qint64 size)
+{
+    const qint64 begin = qMax<qint64>(0, size - TailCheckBytes);
+    if (!file.seek(begin))
+        return 0;
+    const QByteArray tail = file.read(size - begin);
+    return tailChecksum(tail.constData(), tail.size());
+}
+
+using Column = QuickStudioCsvColumnStore::Column;
+
+static inline bool hasNumber(const Column &column, int row)
+{
+    return column.type == QMetaType::Double && row < column.numbers.size()
+           && ((column.present.at(row >> 6) >> (row & 63)) & 1)
+           && (column.rawCells.isEmpty() || !column.rawCells.contains(row));
+}
+
+/*
+    Min/max decimation: the x range is split into pixelWidth buckets and each
+    keeps its lowest and highest point, in row order. A line through the
+    result has the same envelope on screen as one through all points.
+*/
+static QList<QPointF> decimate(const Column &x, const Column &y, int rowCount, int pixelWidth)
+{
+    const bool rowX = x.type != QMetaType::Double;
+    auto xAt = [&](int row) { return rowX ? double(row) : x.numbers.at(row); };
+    auto valid = [&](int row) { return hasNumber(y, row) && (rowX || hasNumber(x, row)); };
+
+    qsizetype count = 0;
+    double xMin = 0;
+    double xMax = 0;
+    for (int row = 0; row < rowCount; ++row) {
+        if (!valid(row))
+            continue;
+        const double value = xAt(row);
+        xMin = count ? qMin(xMin, value) : value;
+        xMax = count ? qMax(xMax, value) : value;
+        ++count;
+    }
+
+    QList<QPointF> points;
+    if (pixelWidth <= 0 || count <= 2 * qsizetype(pixelWidth) || !(xMax > xMin)) {
+        points.reserve(count);
+        for (int row = 0; row < rowCount; ++row) {
+            if (valid(row))
+                points.append(QPointF(xAt(row), y.numbers.at(row)));
+        }
+        return points;
+    }
+
+    QList<int> minRows(pixelWidth, -1);
+    QList<int> maxRows(pixelWidth, -1);
+    const double scale = pixelWidth / (xMax - xMin);
+    for (int row = 0; row < rowCount; ++row) {
+        if (!valid(row))
+            continue;
+        const int bucket = qBound(0, int((xAt(row) - xMin) * scale), pixelWidth - 1);
+        const double value = y.numbers.at(row);
+        if (minRows.at(bucket) < 0 || value < y.numbers.at(minRows.at(bucket)))
+            minRows[bucket] = row;
+        if (maxRows.at(bucket) < 0 || value > y.numbers.at(maxRows.at(bucket)))
+            maxRows[bucket] = row;
+    }
+
+    points.reserve(2 * pixelWidth);
+    for (int bucket = 0; bucket < pixelWidth; ++bucket) {
+        const int minRow = minRows.at(bucket);
+        const int maxRow = maxRows.at(bucket);
+        if (minRow < 0)
+            continue;
+        const int first = qMin(minRow, maxRow);
+        const int second = qMax(minRow, maxRow);
+        points.append(QPointF(xAt(first), y.numbers.at(first)));
+        if (second != first)
+            points.append(QPointF(xAt(second), y.numbers.at(second)));
+    }
+    return points;
+}
 
 QuickStudioCsvTableModel::QuickStudioCsvTableModel(QObject *parent)
     : QAbstractTableModel(parent)
     , m_fileWatcher(new QFileSystemWatcher(this))
+    , m_indexTimer(new QTimer(this))
 {
     connect(m_fileWatcher,
             &QFileSystemWatcher::fileChanged,
             this,
             &QuickStudioCsvTableModel::checkPathAndReload);
+
+    m_indexTimer->setInterval(0);
+    connect(m_indexTimer, &QTimer::timeout, this, &QuickStudioCsvTableModel::indexNextChunk);
+}
+
+QuickStudioCsvTableModel::~QuickStudioCsvTableModel()
+{
+    cancelLoading();
+    for (QThread *thread : std::as_const(m_loaderThreads)) {
+        thread->wait();
+        delete thread;
+    }
 }
 
 int QuickStudioCsvTableModel::rowCount([[maybe_unused]] const QModelIndex &parent) const
 {
-    return m_rows.size();
+    if (m_mappedData)
+        return int(m_lineStarts.size()) - 1;
+    return m_store.rowCount();
 }
 
 int QuickStudioCsvTableModel::columnCount([[maybe_unused]] const QModelIndex &parent) const
@@ -187,12 +214,19 @@ QVariant QuickStudioCsvTableModel::data(const QModelIndex &index, int role) cons
     if (!index.isValid())
         return {};
 
-    const QHash<int, QVariant> &recordData = m_rows.at(index.row());
+    // Cells are stored typed per column; the QVariant is only built here.
+    QVariant cellData;
+    if (m_mappedData) {
+        const RowBlock &rowBlock = block(index.row() / BlockRows);
+        cellData = rowBlock.store.value(index.row() % BlockRows, index.column());
+    } else {
+        cellData = m_store.value(index.row(), index.column());
+    }
 
     if (role == Qt::DisplayRole)
-        return recordData.value(index.column()).toString();
+        return cellData.toString();
 
-    return recordData.value(index.column());
+    return cellData;
 }
 
 QVariant QuickStudioCsvTableModel::headerData(int section,
@@ -203,7 +237,7 @@ QVariant QuickStudioCsvTableModel::headerData(int section,
         if (section > -1 && section < m_headers.size())
             return m_headers.at(section);
     } else if (orientation == Qt::Vertical) {
-        if (section > -1 && section < m_rows.size())
+        if (section > -1 && section < rowCount())
             return section;
     }
 
@@ -227,15 +261,44 @@ void QuickStudioCsvTableModel::setSource(const QUrl &newSource)
     reloadModel();
 }
 
+bool QuickStudioCsvTableModel::lazyLoading() const
+{
+    return m_lazyLoading;
+}
+
+void QuickStudioCsvTableModel::setLazyLoading(bool lazyLoading)
+{
+    if (m_lazyLoading == lazyLoading)
+        return;
+
+    m_lazyLoading = lazyLoading;
+    emit lazyLoadingChanged(m_lazyLoading);
+
+    if (!m_source.isEmpty())
+        reloadModel();
+}
+
 void QuickStudioCsvTableModel::reloadModel()
 {
+    cancelLoading();
     beginResetModel();
     m_headers.clear();
-    m_rows.clear();
-    m_types.clear();
-    m_columnIsClean.clear();
+    m_store.reset(0);
+    m_columnStats.clear();
+    unmapSource();
+    m_follow = {};
 
     QString filePath = ::urlToLocalPath(source());
+
+    if (m_lazyLoading && mapSource(filePath)) {
+        m_follow.end = m_mappedSize;
+        m_follow.modified = QFileInfo(m_mappedFile).lastModified();
+        m_follow.checksum = ::tailChecksum(reinterpret_cast<const char *>(m_mappedData), m_mappedSize);
+        endResetModel();
+        if (m_indexedUpTo < m_mappedSize)
+            m_indexTimer->start();
+        return;
+    }
     QFile sourceFile(filePath);
 
     if (!sourceFile.open(QFile::ReadOnly)) {
@@ -244,55 +307,555 @@ void QuickStudioCsvTableModel::reloadModel()
         return;
     }
 
-    QTextStream stream(&sourceFile);
-
-    if (!stream.atEnd())
-        m_headers = stream.readLine().split(u',', Qt::KeepEmptyParts);
-
-    m_types.insert(0, m_headers.size(), QMetaType::UnknownType);
-    m_columnIsClean.insert(0, m_headers.size(), true);
-
-    if (!m_headers.isEmpty()) {
-        while (!stream.atEnd()) {
-            const QStringList recordDataList = stream.readLine().split(u',', Qt::KeepEmptyParts);
-            int column = -1;
-            QHash<int, QVariant> recordData;
-            for (const QString &cellString : recordDataList) {
-                if (++column == m_headers.size())
-                    break;
-
-                if (!cellString.size())
-                    continue;
-
-                const QMetaType::Type &type = m_types.at(column);
-
-                QVariant cellData;
-                if (type == QMetaType::UnknownType) {
-                    cellData = stringToVariant(cellString);
-                    m_types.replace(column, QMetaType::Type(cellData.typeId()));
-                } else {
-                    bool columnIsClean = m_columnIsClean.at(column);
-                    bool *ok = columnIsClean ? &columnIsClean : nullptr;
-                    cellData = stringToVariant(cellString, type, ok);
-                    if (ok)
-                        m_columnIsClean.replace(column, *ok);
-                }
-                recordData.insert(column, cellData);
+    // The header is read here; records are parsed on a loader thread and
+    // inserted as they arrive (see startLoading).
+    if (!sourceFile.atEnd()) {
+        QByteArray headerLine = sourceFile.readLine();
+        if (headerLine.startsWith("\xEF\xBB\xBF"))
+            headerLine.remove(0, 3);
+        m_headers = QuickStudioCsvTokenizer::split(headerLine);
+    }
+
+    m_store.reset(m_headers.size());
+    endResetModel();
+
+    if (!m_headers.isEmpty())
+        startLoading(filePath, sourceFile.pos(), sourceFile.size(), {});
+}
+
+bool QuickStudioCsvTableModel::loading() const
+{
+    return m_loading;
+}
+
+qreal QuickStudioCsvTableModel::progress() const
+{
+    return m_progress;
+}
+
+const QuickStudioCsvColumnStore *QuickStudioCsvTableModel::columnStore() const
+{
+    return m_mappedData ? nullptr : &m_store;
+}
+
+int QuickStudioCsvTableModel::columnIndex(const QVariant &column) const
+{
+    if (column.typeId() == QMetaType::QString)
+        return int(m_headers.indexOf(column.toString()));
+
+    bool ok = false;
+    const int index = column.toInt(&ok);
+    return ok && index >= 0 && index < m_headers.size() ? index : -1;
+}
+
+/*
+    Aggregates are cached per column. Rows appended since the last query are
+    folded in, so repeated queries while a file is followed cost time
+    proportional to the new rows only. Not available in lazy loading mode.
+*/
+QVariantMap QuickStudioCsvTableModel::columnStats(const QVariant &column) const
+{
+    const int index = columnIndex(column);
+    const QuickStudioCsvColumnStore *store = columnStore();
+    if (index < 0 || !store || index >= store->columnCount())
+        return {};
+
+    if (m_columnStats.size() != store->columnCount())
+        m_columnStats.resize(store->columnCount());
+    QuickStudioCsvColumnStore::Stats &stats = m_columnStats[index];
+    store->updateStats(index, &stats);
+
+    QVariantMap result;
+    result.insert(QStringLiteral("count"), stats.count);
+    if (stats.numbers > 0) {
+        result.insert(QStringLiteral("min"), stats.min);
+        result.insert(QStringLiteral("max"), stats.max);
+        result.insert(QStringLiteral("mean"), stats.mean);
+        result.insert(QStringLiteral("std"), std::sqrt(stats.variance()));
+    }
+    return result;
+}
+
+QFuture<QList<QPointF>> QuickStudioCsvTableModel::seriesFor(int xColumn, int yColumn, int pixelWidth) const
+{
+    auto promise = std::make_shared<QPromise<QList<QPointF>>>();
+    QFuture<QList<QPointF>> future = promise->future();
+    promise->start();
+
+    const QuickStudioCsvColumnStore *store = columnStore();
+    if (!store || yColumn < 0 || yColumn >= store->columnCount()) {
+        promise->addResult(QList<QPointF>());
+        promise->finish();
+        return future;
+    }
+
+    // The columns are implicitly shared, so this is a cheap snapshot that
+    // later appends on this thread do not touch.
+    const Column x = xColumn >= 0 && xColumn < store->columnCount() ? store->column(xColumn)
+                                                                    : Column();
+    const Column y = store->column(yColumn);
+    const int rowCount = store->rowCount();
+
+    QThreadPool::globalInstance()->start([promise, x, y, rowCount, pixelWidth]() {
+        promise->addResult(::decimate(x, y, rowCount, pixelWidth));
+        promise->finish();
+    });
+    return future;
+}
+
+int QuickStudioCsvTableModel::requestSeries(const QVariant &xColumn,
+                                            const QVariant &yColumn,
+                                            int pixelWidth)
+{
+    const int request = ++m_seriesRequest;
+    seriesFor(columnIndex(xColumn), columnIndex(yColumn), pixelWidth)
+        .then(this, [this, request](const QList<QPointF> &points) {
+            emit seriesReady(request, points);
+        });
+    return request;
+}
+
+/*
+    Parses the records from dataOffset on a loader thread. Type inference runs
+    on the loader thread too: each chunk is seeded with the column types of the
+    previous one (the first with types), so the result is the same as parsing
+    the file in one pass. When done, the loader reports how far it got so that
+    later appends can be followed from there (see followSource).
+    Chunks are handed to the model with a queued call and inserted with
+    beginInsertRows. Starting another load (or destroying the model) cancels
+    this one; chunks of a superseded load are dropped by their generation.
+*/
+void QuickStudioCsvTableModel::startLoading(const QString &filePath,
+                                            qint64 dataOffset,
+                                            qint64 fileSize,
+                                            const QList<QMetaType::Type> &types)
+{
+    const int generation = ++m_loadGeneration;
+    const int columnCount = m_headers.size();
+    auto cancelled = std::make_shared<std::atomic_bool>(false);
+    m_cancelLoading = cancelled;
+
+    QThread *thread = QThread::create([this, filePath, dataOffset, fileSize, generation, columnCount,
+                                       types, cancelled]() {
+        QFile file(filePath);
+        if (!file.open(QFile::ReadOnly) || !file.seek(dataOffset)) {
+            QMetaObject::invokeMethod(this, [this, generation]() { finishLoading(generation, {}); },
+                                      Qt::QueuedConnection);
+            return;
+        }
+
+        QElapsedTimer chunkTimer;
+        chunkTimer.start();
+        QuickStudioCsvColumnStore chunk;
+        chunk.reset(columnCount, types);
+
+        // End of the last terminated record; a trailing record without a line
+        // break may still be being written.
+        FollowState follow;
+        follow.offset = dataOffset;
+
+        QuickStudioCsvTokenizer tokenizer;
+        QList<QStringView> fields;
+        QByteArray buffer;
+        qint64 bufferOffset = dataOffset;
+
+        auto publish = [&]() {
+            const qreal progress = fileSize > 0 ? qreal(file.pos()) / qreal(fileSize) : 1.0;
+            const QList<QMetaType::Type> types = chunk.types();
+            QMetaObject::invokeMethod(this, [this, generation, chunk, progress]() {
+                appendChunk(generation, chunk, progress);
+            }, Qt::QueuedConnection);
+            chunk.reset(columnCount, types);
+            chunkTimer.restart();
+        };
+
+        // Read in large blocks; a record cut by the end of a block is kept and
+        // completed by the next one. Only the newly read bytes are indexed, so
+        // a very long record does not make every read rescan the whole buffer.
+        bool atEnd = false;
+        while (!atEnd) {
+            if (cancelled->load(std::memory_order_relaxed))
+                return;
+
+            const qsizetype kept = buffer.size();
+            buffer.resize(kept + ReadChunkBytes);
+            const qint64 bytesRead = file.read(buffer.data() + kept, ReadChunkBytes);
+            buffer.resize(kept + qMax<qint64>(bytesRead, 0));
+            atEnd = bytesRead <= 0 || file.atEnd();
+
+            tokenizer.extend(buffer, atEnd);
+            while (tokenizer.readRecord(&fields)) {
+                chunk.appendRow(fields);
+                if (buffer.at(tokenizer.position() - 1) == '\n')
+                    follow.offset = bufferOffset + tokenizer.position();
+                if (chunk.rowCount() >= LoadChunkRows
+                    || (chunk.rowCount() % 1024 == 0 && chunkTimer.elapsed() >= LoadChunkMs))
+                    publish();
             }
-            m_rows.append(recordData);
+            const qsizetype consumed = tokenizer.position();
+            tokenizer.discardRead();
+            buffer.remove(0, consumed);
+            bufferOffset += consumed;
         }
+        if (chunk.rowCount() > 0)
+            publish();
+
+        follow.end = file.pos();
+        follow.modified = QFileInfo(file).lastModified();
+        follow.checksum = ::tailChecksum(file, follow.end);
+        QMetaObject::invokeMethod(this, [this, generation, follow]() {
+            finishLoading(generation, follow);
+        }, Qt::QueuedConnection);
+    });
+
+    thread->setObjectName(QStringLiteral("CsvTableModelLoader"));
+    connect(thread, &QThread::finished, this, [this, thread]() {
+        m_loaderThreads.removeOne(thread);
+        thread->deleteLater();
+    });
+    m_loaderThreads.append(thread);
+
+    setLoading(true);
+    setProgress(fileSize > 0 ? qreal(dataOffset) / qreal(fileSize) : 0);
+    thread->start(QThread::LowPriority);
+}
+
+void QuickStudioCsvTableModel::cancelLoading()
+{
+    m_followPending = false;
+    if (m_cancelLoading)
+        m_cancelLoading->store(true);
+    m_cancelLoading.reset();
+    ++m_loadGeneration;
+    setLoading(false);
+}
+
+void QuickStudioCsvTableModel::appendChunk(int generation,
+                                           const QuickStudioCsvColumnStore &chunk,
+                                           qreal progress)
+{
+    if (generation != m_loadGeneration || chunk.rowCount() == 0)
+        return;
+
+    const int first = m_store.rowCount();
+    beginInsertRows({}, first, first + chunk.rowCount() - 1);
+    m_store.append(chunk);
+    endInsertRows();
+    setProgress(progress);
+}
+
+void QuickStudioCsvTableModel::finishLoading(int generation, const FollowState &follow)
+{
+    if (generation != m_loadGeneration)
+        return;
+
+    qCDebug(quickStudioCsvTableModelDebug) << Q_FUNC_INFO << m_store.rowCount() << "rows,"
+                                           << m_store.memoryUsage() << "bytes";
+    m_cancelLoading.reset();
+    m_follow = follow;
+    setProgress(1.0);
+    setLoading(false);
+
+    // The file changed while it was being loaded
+    if (m_followPending) {
+        m_followPending = false;
+        if (!followSource())
+            reloadModel();
     }
+}
 
-    endResetModel();
+void QuickStudioCsvTableModel::setLoading(bool loading)
+{
+    if (m_loading == loading)
+        return;
+    m_loading = loading;
+    emit loadingChanged(m_loading);
+}
+
+void QuickStudioCsvTableModel::setProgress(qreal progress)
+{
+    if (qFuzzyCompare(m_progress, progress))
+        return;
+    m_progress = progress;
+    emit progressChanged(m_progress);
+}
+
+/*
+    Maps the file and indexes its header plus the first InitialIndexBytes.
+    Column types are inferred from the first block here and stay fixed, so
+    they do not depend on which rows are scrolled to first. Returns false if the file cannot be mapped (for example a compressed
+    resource), in which case the caller falls back to reading it.
+*/
+bool QuickStudioCsvTableModel::mapSource(const QString &filePath)
+{
+    m_mappedFile.setFileName(filePath);
+    if (!m_mappedFile.open(QFile::ReadOnly))
+        return false;
+
+    m_mappedSize = m_mappedFile.size();
+    m_mappedData = m_mappedSize > 0 ? m_mappedFile.map(0, m_mappedSize) : nullptr;
+    if (!m_mappedData) {
+        m_mappedFile.close();
+        m_mappedSize = 0;
+        return false;
+    }
+
+    const char *data = reinterpret_cast<const char *>(m_mappedData);
+    qint64 headerStart = 0;
+    if (m_mappedSize >= 3 && std::memcmp(data, "\xEF\xBB\xBF", 3) == 0)
+        headerStart = 3;
+
+    const void *newline = std::memchr(data + headerStart, '\n', size_t(m_mappedSize - headerStart));
+    const qint64 headerEnd = newline ? reinterpret_cast<const char *>(newline) - data : m_mappedSize;
+    m_headers = QuickStudioCsvTokenizer::split(
+        QByteArrayView(data + headerStart, headerEnd - headerStart));
+
+    m_lineStarts.clear();
+    m_lineStarts.append(qMin(headerEnd + 1, m_mappedSize));
+    m_indexedUpTo = m_lineStarts.constFirst();
+    if (m_headers.isEmpty())
+        m_indexedUpTo = m_mappedSize;
+    m_scannedUpTo = m_indexedUpTo;
+    m_scanState = {};
+
+    m_lineStarts.append(indexLines(InitialIndexBytes));
+    m_lazyTypes = block(0).store.types();
+    return true;
+}
+
+void QuickStudioCsvTableModel::unmapSource()
+{
+    m_indexTimer->stop();
+    if (m_mappedData)
+        m_mappedFile.unmap(const_cast<uchar *>(m_mappedData));
+    m_mappedFile.close();
+    m_mappedData = nullptr;
+    m_mappedSize = 0;
+    m_indexedUpTo = 0;
+    m_scannedUpTo = 0;
+    m_scanState = {};
+    m_lineStarts.clear();
+    m_blockCache.clear();
+    m_lazyTypes.clear();
+}
+
+/*
+    Reading the mapping past the end of a file that has since been truncated
+    raises SIGBUS, so it is only read while the file is still at least as
+    long as the mapping. A file that is truncated while a block is being
+    parsed can still fault; sources that are rewritten in place rather than
+    appended to should not be loaded lazily.
+*/
+bool QuickStudioCsvTableModel::mappingValid() const
+{
+    return m_mappedData && m_mappedFile.size() >= m_mappedSize;
+}
+
+/*
+    Finds record starts in the next maxBytes of the mapped file. Line breaks
+    inside quoted fields do not end a record. The scan continues where the
+    previous one stopped, inside a quoted field if need be, so every call
+    makes progress even when a record is longer than maxBytes. An
+    unterminated last record gets a sentinel start one past the end of the
+    file.
+*/
+QList<qint64> QuickStudioCsvTableModel::indexLines(qint64 maxBytes)
+{
+    QList<qint64> starts;
+    const char *data = reinterpret_cast<const char *>(m_mappedData);
+    const qint64 end = qMin(m_mappedSize, m_scannedUpTo + maxBytes);
+
+    QuickStudioCsvTokenizer::findRecordEnds(QByteArrayView(data + m_scannedUpTo, end - m_scannedUpTo),
+                                            m_scannedUpTo,
+                                            &m_scanState,
+                                            &starts);
+    m_scannedUpTo = end;
+    if (!starts.isEmpty())
+        m_indexedUpTo = starts.constLast();
+
+    if (end == m_mappedSize && m_indexedUpTo < m_mappedSize) {
+        starts.append(m_mappedSize + 1);
+        m_indexedUpTo = m_mappedSize;
+    }
+    return starts;
+}
+
+void QuickStudioCsvTableModel::indexNextChunk()
+{
+    if (!m_mappedData || m_indexedUpTo >= m_mappedSize) {
+        m_indexTimer->stop();
+        return;
+    }
+
+    // Truncated or rewritten behind our back
+    if (!mappingValid()) {
+        reloadModel();
+        return;
+    }
+
+    const QList<qint64> starts = indexLines(IndexChunkBytes);
+    if (!starts.isEmpty()) {
+        const int first = rowCount();
+        // The last cached block may have been parsed while it was still partial
+        if (first % BlockRows != 0) {
+            m_blockCache.removeIf([first](const RowBlock &rowBlock) {
+                return rowBlock.index == first / BlockRows;
+            });
+        }
+        beginInsertRows({}, first, first + int(starts.size()) - 1);
+        m_lineStarts.append(starts);
+        endInsertRows();
+    }
+
+    if (m_indexedUpTo >= m_mappedSize)
+        m_indexTimer->stop();
+}
+
+/*
+    Returns the parsed block of BlockRows rows, parsing it on first use. The
+    most recently used blocks are kept, least recently used first out. Every
+    block starts with the column types of the first one (see mapSource()); a
+    column that is empty there is typed by each block on its own.
+*/
+const QuickStudioCsvTableModel::RowBlock &QuickStudioCsvTableModel::block(int blockIndex) const
+{
+    for (int i = 0; i < m_blockCache.size(); ++i) {
+        if (m_blockCache.at(i).index == blockIndex) {
+            if (i > 0)
+                m_blockCache.move(i, 0);
+            return m_blockCache.constFirst();
+        }
+    }
+
+    RowBlock rowBlock;
+    rowBlock.index = blockIndex;
+    rowBlock.store.reset(m_headers.size(), m_lazyTypes);
+
+    const int firstRow = blockIndex * BlockRows;
+    const int lastRow = qMin(firstRow + BlockRows, rowCount());
+    // Left empty if the file shrank; the file watcher reloads it
+    if (firstRow < lastRow && mappingValid()) {
+        const char *data = reinterpret_cast<const char *>(m_mappedData);
+        const qint64 begin = m_lineStarts.at(firstRow);
+        const qint64 end = qMin(m_lineStarts.at(lastRow), m_mappedSize);
+
+        QuickStudioCsvTokenizer tokenizer;
+        QList<QStringView> fields;
+        tokenizer.reset(QByteArrayView(data + begin, end - begin), true);
+        while (tokenizer.readRecord(&fields))
+            rowBlock.store.appendRow(fields);
+    }
+
+
+    m_blockCache.prepend(rowBlock);
+    if (m_blockCache.size() > BlockCacheSize)
+        m_blockCache.removeLast();
+    return m_blockCache.constFirst();
 }
 
 void QuickStudioCsvTableModel::checkPathAndReload(const QString &path)
 {
     QString sourceLocalPath = ::urlToLocalPath(source());
-    if (path == sourceLocalPath)
+    if (path == sourceLocalPath && !followSource())
         reloadModel();
 }
 
+/*
+    Picks up rows appended to the source since it was loaded, so following a
+    file that is being recorded costs time proportional to the new data only.
+    The file counts as appended to if it did not shrink, is not older, and the
+    last TailCheckBytes bytes seen so far are unchanged. A row parsed from an
+    unterminated last line is dropped and parsed again from the new data.
+    Returns false if the file was truncated or rewritten; the caller then
+    reloads it.
+*/
+bool QuickStudioCsvTableModel::followSource()
+{
+    if (m_follow.end < 0)
+        return false;
+
+    if (m_loading) {
+        m_followPending = true;
+        return true;
+    }
+
+    const QString filePath = ::urlToLocalPath(source());
+    QFile file(filePath);
+    if (!file.open(QFile::ReadOnly))
+        return false;
+
+    const qint64 size = file.size();
+    if (size < m_follow.end || QFileInfo(file).lastModified() < m_follow.modified)
+        return false;
+    if (m_mappedData && !mappingValid())
+        return false;
+
+    const size_t checksum = m_mappedData
+                                ? ::tailChecksum(reinterpret_cast<const char *>(m_mappedData),
+                                                 m_follow.end)
+                                : ::tailChecksum(file, m_follow.end);
+    if (checksum != m_follow.checksum)
+        return false;
+
+    if (size == m_follow.end)
+        return true;
+
+    qCDebug(quickStudioCsvTableModelDebug) << Q_FUNC_INFO << size - m_follow.end << "bytes appended";
+
+    if (m_mappedData)
+        return followMappedSource(size);
+
+    if (m_follow.offset < m_follow.end) {
+        const int last = m_store.rowCount() - 1;
+        beginRemoveRows({}, last, last);
+        m_store.truncate(last);
+        m_columnStats.clear();
+        endRemoveRows();
+    }
+
+    startLoading(filePath, m_follow.offset, size, m_store.types());
+    return true;
+}
+
+/*
+    Lazy loading counterpart of followSource(): maps the grown file and lets
+    the indexer continue from where it stopped.
+*/
+bool QuickStudioCsvTableModel::followMappedSource(qint64 size)
+{
+    // The unterminated last line was indexed with a sentinel start past the end
+    const int rows = rowCount();
+    if (rows > 0 && m_lineStarts.constLast() > m_mappedSize) {
+        beginRemoveRows({}, rows - 1, rows - 1);
+        m_lineStarts.removeLast();
+        m_indexedUpTo = m_lineStarts.constLast();
+        m_scannedUpTo = m_indexedUpTo;
+        m_scanState = {};
+        m_blockCache.removeIf([rows](const RowBlock &rowBlock) {
+            return rowBlock.index == (rows - 1) / BlockRows;
+        });
+        endRemoveRows();
+    }
+
+    // The path may now name another file than the one mapped
+    if (m_mappedFile.size() < size)
+        return false;
+
+    m_mappedFile.unmap(const_cast<uchar *>(m_mappedData));
+    m_mappedData = m_mappedFile.map(0, size);
+    if (!m_mappedData)
+        return false;
+
+    m_mappedSize = size;
+    m_follow.end = size;
+    m_follow.modified = QFileInfo(m_mappedFile).lastModified();
+    m_follow.checksum = ::tailChecksum(reinterpret_cast<const char *>(m_mappedData), size);
+    indexNextChunk();
+    if (m_indexedUpTo < m_mappedSize)
+        m_indexTimer->start();
+    return true;
+}
+
 void QuickStudioCsvTableModel::startWatchingSource()
 {
     qCDebug(quickStudioCsvTableModelDebug) << Q_FUNC_INFO << "Load file: " << source();
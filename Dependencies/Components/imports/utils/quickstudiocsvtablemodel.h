@@ -48,13 +48,25 @@
 // We mean it.
 //
 
+#include "quickstudiocsvcolumnstore.h"
+#include "quickstudiocsvtokenizer.h"
+
 #include <QAbstractTableModel>
+#include <QDateTime>
+#include <QFile>
+#include <QFuture>
+#include <QPointF>
 #include <QtCore/qurl.h>
 #include <QtQml/qqml.h>
 
+#include <atomic>
+#include <memory>
+
 QT_BEGIN_NAMESPACE
 
 class QFileSystemWatcher;
+class QThread;
+class QTimer;
 class QuickStudioCsvTableModel : public QAbstractTableModel
 {
     Q_OBJECT
@@ -63,9 +75,13 @@ class QuickStudioCsvTableModel : public QAbstractTableModel
     QML_ADDED_IN_VERSION(6, 2)
 
     Q_PROPERTY(QUrl source READ source WRITE setSource NOTIFY sourceChanged)
+    Q_PROPERTY(bool lazyLoading READ lazyLoading WRITE setLazyLoading NOTIFY lazyLoadingChanged)
+    Q_PROPERTY(bool loading READ loading NOTIFY loadingChanged)
+    Q_PROPERTY(qreal progress READ progress NOTIFY progressChanged)
 
 public:
     explicit QuickStudioCsvTableModel(QObject *parent = nullptr);
+    ~QuickStudioCsvTableModel() override;
 
     int rowCount(const QModelIndex &parent = {}) const override;
     int columnCount(const QModelIndex &parent = {}) const override;
@@ -77,23 +93,108 @@ public:
     QUrl source() const;
     void setSource(const QUrl &newSource);
 
+    bool lazyLoading() const;
+    void setLazyLoading(bool lazyLoading);
+
+    bool loading() const;
+    qreal progress() const;
+
+    // Typed cell storage, or nullptr in lazy loading mode where only the
+    // cached row blocks are parsed. Valid until the next change signal.
+    const QuickStudioCsvColumnStore *columnStore() const;
+
+    // column is an index or a header name
+    Q_INVOKABLE int columnIndex(const QVariant &column) const;
+    // count, and for number columns min, max, mean and std
+    Q_INVOKABLE QVariantMap columnStats(const QVariant &column) const;
+
+    // Points (x, y) of two number columns, reduced to the lowest and highest
+    // y per pixel column when there are more than two points per pixel. A
+    // negative or non-number xColumn plots against the row number. Computed
+    // on the thread pool; the result can be passed to QXYSeries::replace().
+    QFuture<QList<QPointF>> seriesFor(int xColumn, int yColumn, int pixelWidth) const;
+    // QML variant of seriesFor(): the result arrives with seriesReady()
+    Q_INVOKABLE int requestSeries(const QVariant &xColumn, const QVariant &yColumn, int pixelWidth);
+
 signals:
     void sourceChanged(const QUrl &url);
+    void lazyLoadingChanged(bool lazyLoading);
+    void loadingChanged(bool loading);
+    void progressChanged(qreal progress);
+    void seriesReady(int request, const QList<QPointF> &points);
 
 private slots:
     void reloadModel();
     void checkPathAndReload(const QString &path);
+    void indexNextChunk();
 
 private:
+    struct RowBlock
+    {
+        int index = -1;
+        QuickStudioCsvColumnStore store;
+    };
+
+    // How much of the source has been loaded, to tell appends from rewrites
+    struct FollowState
+    {
+        qint64 offset = -1;     // where parsing resumes (end of the last terminated line)
+        qint64 end = -1;        // bytes seen, -1 if the source cannot be followed
+        QDateTime modified;
+        size_t checksum = 0;    // of the last bytes before end
+    };
+
     void startWatchingSource();
+    void startLoading(const QString &filePath,
+                      qint64 dataOffset,
+                      qint64 fileSize,
+                      const QList<QMetaType::Type> &types);
+    void cancelLoading();
+    void appendChunk(int generation, const QuickStudioCsvColumnStore &chunk, qreal progress);
+    void finishLoading(int generation, const FollowState &follow);
+    bool followSource();
+    bool followMappedSource(qint64 size);
+    void setLoading(bool loading);
+    void setProgress(qreal progress);
+    bool mapSource(const QString &filePath);
+    void unmapSource();
+    bool mappingValid() const;
+    QList<qint64> indexLines(qint64 maxBytes);
+    const RowBlock &block(int blockIndex) const;
 
     QFileSystemWatcher *m_fileWatcher = nullptr;
     QUrl m_source;
 
     QStringList m_headers;
-    QList<QHash<int, QVariant>> m_rows;
-    QList<QMetaType::Type> m_types;
-    QList<bool> m_columnIsClean;
+    QuickStudioCsvColumnStore m_store;
+
+    // Background loading
+    bool m_loading = false;
+    qreal m_progress = 0;
+    int m_loadGeneration = 0;
+    std::shared_ptr<std::atomic_bool> m_cancelLoading;
+    QList<QThread *> m_loaderThreads;
+
+    // Aggregates, extended to appended rows when queried
+    mutable QList<QuickStudioCsvColumnStore::Stats> m_columnStats;
+    int m_seriesRequest = 0;
+
+    // Tail following
+    FollowState m_follow;
+    bool m_followPending = false;
+
+    // Lazy loading: memory-mapped file, line start offsets, parsed block cache
+    bool m_lazyLoading = false;
+    QFile m_mappedFile;
+    const uchar *m_mappedData = nullptr;
+    qint64 m_mappedSize = 0;
+    qint64 m_indexedUpTo = 0;   // end of the last indexed record
+    qint64 m_scannedUpTo = 0;   // end of the bytes scanned for record ends
+    QuickStudioCsvTokenizer::ScanState m_scanState;
+    QList<qint64> m_lineStarts;
+    QTimer *m_indexTimer = nullptr;
+    mutable QList<RowBlock> m_blockCache;
+    mutable QList<QMetaType::Type> m_lazyTypes;
 };
 
 QT_END_NAMESPACE
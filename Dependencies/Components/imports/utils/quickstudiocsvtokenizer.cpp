@@ -0,0 +1,361 @@
+/****************************************************************************
+**
+** Copyright (C) 2023 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the Qt Quick Dialogs module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "quickstudiocsvtokenizer.h"
+
+#include <QtCore/qalgorithms.h>
+
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define QUICKSTUDIOCSV_SSE2
+#elif defined(__ARM_NEON) && (defined(__aarch64__) || defined(_M_ARM64))
+#  include <arm_neon.h>
+#  define QUICKSTUDIOCSV_NEON
+#endif
+
+QT_BEGIN_NAMESPACE
+
+static constexpr qsizetype BlockSize = 64;
+
+// One bit per byte of a 64-byte block
+struct BlockMasks
+{
+    quint64 quotes = 0;
+    quint64 commas = 0;
+    quint64 lineFeeds = 0;
+};
+
+#if defined(QUICKSTUDIOCSV_SSE2)
+
+static inline BlockMasks blockMasks(const char *block)
+{
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i comma = _mm_set1_epi8(',');
+    const __m128i lineFeed = _mm_set1_epi8('\n');
+
+    BlockMasks masks;
+    for (int i = 0; i < 4; ++i) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 16 * i));
+        const int shift = 16 * i;
+        masks.quotes |= quint64(quint16(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, quote)))) << shift;
+        masks.commas |= quint64(quint16(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, comma)))) << shift;
+        masks.lineFeeds |= quint64(quint16(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, lineFeed))))
+                           << shift;
+    }
+    return masks;
+}
+
+#elif defined(QUICKSTUDIOCSV_NEON)
+
+// NEON has no movemask; weight each lane by its bit and add pairwise.
+static inline quint64 toBits(uint8x16_t v0, uint8x16_t v1, uint8x16_t v2, uint8x16_t v3)
+{
+    const uint8x16_t weights = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80,
+                                0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80};
+    uint8x16_t sum0 = vpaddq_u8(vandq_u8(v0, weights), vandq_u8(v1, weights));
+    const uint8x16_t sum1 = vpaddq_u8(vandq_u8(v2, weights), vandq_u8(v3, weights));
+    sum0 = vpaddq_u8(sum0, sum1);
+    sum0 = vpaddq_u8(sum0, sum0);
+    return vgetq_lane_u64(vreinterpretq_u64_u8(sum0), 0);
+}
+
+static inline BlockMasks blockMasks(const char *block)
+{
+    const uint8_t *bytes = reinterpret_cast<const uint8_t *>(block);
+    const uint8x16_t b0 = vld1q_u8(bytes);
+    const uint8x16_t b1 = vld1q_u8(bytes + 16);
+    const uint8x16_t b2 = vld1q_u8(bytes + 32);
+    const uint8x16_t b3 = vld1q_u8(bytes + 48);
+
+    auto match = [&](uint8_t c) {
+        const uint8x16_t needle = vdupq_n_u8(c);
+        return toBits(vceqq_u8(b0, needle), vceqq_u8(b1, needle), vceqq_u8(b2, needle),
+                      vceqq_u8(b3, needle));
+    };
+
+    BlockMasks masks;
+    masks.quotes = match('"');
+    masks.commas = match(',');
+    masks.lineFeeds = match('\n');
+    return masks;
+}
+
+#else
+
+static inline BlockMasks blockMasks(const char *block)
+{
+    BlockMasks masks;
+    for (int i = 0; i < BlockSize; ++i) {
+        const quint64 bit = quint64(1) << i;
+        switch (block[i]) {
+        case '"':
+            masks.quotes |= bit;
+            break;
+        case ',':
+            masks.commas |= bit;
+            break;
+        case '\n':
+            masks.lineFeeds |= bit;
+            break;
+        default:
+            break;
+        }
+    }
+    return masks;
+}
+
+#endif
+
+// Bit i is set if an odd number of quotes is at or before byte i, i.e. byte i
+// is inside a quoted field (opening quote included, closing quote excluded).
+static inline quint64 prefixXor(quint64 bits)
+{
+    bits ^= bits << 1;
+    bits ^= bits << 2;
+    bits ^= bits << 4;
+    bits ^= bits << 8;
+    bits ^= bits << 16;
+    bits ^= bits << 32;
+    return bits;
+}
+
+// The quoted mask of a block with a stray quote, one byte at a time: outside
+// quotes, a quote is text unless it starts a field or follows a closing quote
+// (a doubled quote). Updates state to the end of the block.
+static quint64 quotedScalar(const char *block,
+                            qsizetype length,
+                            QuickStudioCsvTokenizer::ScanState *state)
+{
+    quint64 quoted = 0;
+    for (qsizetype i = 0; i < length; ++i) {
+        const char c = block[i];
+        if (state->quoted) {
+            if (c == '"') {
+                state->quoted = false;
+                state->quoteOpens = true;
+                continue;
+            }
+        } else if (c == '"' && state->quoteOpens) {
+            state->quoted = true;
+        } else {
+            state->quoteOpens = c == ',' || c == '\n';
+        }
+        if (state->quoted)
+            quoted |= quint64(1) << i;
+    }
+    return quoted;
+}
+
+// Calls found(offset) for each line feed, and each comma if withCommas is set,
+// that is not inside a quoted field. data must start where state was left;
+// state is updated to the end of data.
+template <typename Found>
+static void scanStructure(QByteArrayView data,
+                          bool withCommas,
+                          QuickStudioCsvTokenizer::ScanState *state,
+                          Found found)
+{
+    const char *bytes = data.data();
+    const qsizetype size = data.size();
+    quint64 carry = state->quoted ? ~quint64(0) : 0; // all ones inside quotes
+    quint64 quoteOpens = state->quoteOpens ? 1 : 0;  // bit 0: a quote there opens
+    char tail[BlockSize];
+
+    for (qsizetype base = 0; base < size; base += BlockSize) {
+        const qsizetype length = qMin(size - base, BlockSize);
+        const char *block = bytes + base;
+        if (length < BlockSize) {
+            std::memset(tail, 0, BlockSize);
+            std::memcpy(tail, block, size_t(length));
+            block = tail;
+        }
+
+        const BlockMasks masks = blockMasks(block);
+        const quint64 lastByte = quint64(1) << (length - 1);
+        quint64 quoted = prefixXor(masks.quotes) ^ carry;
+
+        // Opening quotes are the quotes inside quoted regions. Each must follow
+        // a comma, a line feed or a (closing) quote, or the prefix XOR is wrong
+        // from there on.
+        const quint64 delimiters = masks.commas | masks.lineFeeds | masks.quotes;
+        if (masks.quotes & quoted & ~((delimiters << 1) | quoteOpens)) {
+            QuickStudioCsvTokenizer::ScanState blockState{carry != 0, quoteOpens != 0};
+            quoted = quotedScalar(block, length, &blockState);
+            carry = blockState.quoted ? ~quint64(0) : 0;
+            quoteOpens = blockState.quoteOpens ? 1 : 0;
+        } else {
+            carry = (quoted & lastByte) ? ~quint64(0) : 0;
+            quoteOpens = (delimiters & lastByte) ? 1 : 0;
+        }
+
+        quint64 structural = (withCommas ? masks.commas | masks.lineFeeds : masks.lineFeeds)
+                             & ~quoted;
+        while (structural) {
+            found(base + qCountTrailingZeroBits(structural));
+            structural &= structural - 1;
+        }
+    }
+
+    state->quoted = carry != 0;
+    state->quoteOpens = quoteOpens != 0;
+}
+
+void QuickStudioCsvTokenizer::reset(QByteArrayView data, bool atEnd)
+{
+    m_data = {};
+    m_next = 0;
+    m_position = 0;
+    m_separators.clear();
+    m_scanState = {};
+    extend(data, atEnd);
+}
+
+void QuickStudioCsvTokenizer::extend(QByteArrayView data, bool atEnd)
+{
+    const qsizetype scanned = m_data.size();
+    m_data = data;
+    m_atEnd = atEnd;
+    scanStructure(data.sliced(scanned), true, &m_scanState, [this, scanned](qsizetype offset) {
+        m_separators.append(scanned + offset);
+    });
+}
+
+void QuickStudioCsvTokenizer::discardRead()
+{
+    m_separators.remove(0, m_next);
+    for (qsizetype &separator : m_separators)
+        separator -= m_position;
+    m_data = m_data.sliced(m_position);
+    m_next = 0;
+    m_position = 0;
+}
+
+bool QuickStudioCsvTokenizer::readRecord(QList<QStringView> *fields)
+{
+    const qsizetype recordStart = m_position;
+    if (recordStart >= m_data.size())
+        return false;
+
+    qsizetype lineFeed = m_next;
+    while (lineFeed < m_separators.size() && m_data[m_separators.at(lineFeed)] != '\n')
+        ++lineFeed;
+
+    const bool terminated = lineFeed < m_separators.size();
+    if (!terminated && !m_atEnd)
+        return false;
+    const qsizetype recordEnd = terminated ? m_separators.at(lineFeed) : m_data.size();
+
+    // UTF-16 never needs more code units than UTF-8 needs bytes
+    m_text.resize(recordEnd - recordStart);
+    QChar *out = m_text.data();
+    const QChar *text = out;
+    m_fieldEnds.clear();
+
+    qsizetype fieldStart = recordStart;
+    for (qsizetype separator = m_next;; ++separator) {
+        const bool last = separator == lineFeed;
+        qsizetype fieldEnd = last ? recordEnd : m_separators.at(separator);
+        if (last && fieldEnd > fieldStart && m_data[fieldEnd - 1] == '\r')
+            --fieldEnd;
+
+        out = decodeField(m_data.sliced(fieldStart, fieldEnd - fieldStart), out);
+        m_fieldEnds.append(out - text);
+        if (last)
+            break;
+        fieldStart = fieldEnd + 1;
+    }
+
+    fields->clear();
+    qsizetype start = 0;
+    for (qsizetype end : std::as_const(m_fieldEnds)) {
+        fields->append(QStringView(text + start, end - start));
+        start = end;
+    }
+
+    m_next = terminated ? lineFeed + 1 : lineFeed;
+    m_position = terminated ? recordEnd + 1 : recordEnd;
+    return true;
+}
+
+// Decodes one field to out. In a quoted field a doubled quote stands for a
+// quote; anything after the closing quote is kept rather than rejected.
+QChar *QuickStudioCsvTokenizer::decodeField(QByteArrayView field, QChar *out)
+{
+    if (field.isEmpty() || field.front() != '"')
+        return m_decoder.appendToBuffer(out, field);
+
+    qsizetype begin = 1;
+    for (qsizetype i = 1; i < field.size(); ++i) {
+        if (field[i] != '"')
+            continue;
+        out = m_decoder.appendToBuffer(out, field.sliced(begin, i - begin));
+        if (i + 1 < field.size() && field[i + 1] == '"') {
+            *out++ = u'"';
+            ++i;
+        }
+        begin = i + 1;
+    }
+    return m_decoder.appendToBuffer(out, field.sliced(begin));
+}
+
+void QuickStudioCsvTokenizer::findRecordEnds(QByteArrayView data,
+                                             qint64 base,
+                                             ScanState *state,
+                                             QList<qint64> *recordEnds)
+{
+    scanStructure(data, false, state, [base, recordEnds](qsizetype offset) {
+        recordEnds->append(base + offset + 1);
+    });
+}
+
+QStringList QuickStudioCsvTokenizer::split(QByteArrayView record)
+{
+    QuickStudioCsvTokenizer tokenizer;
+    tokenizer.reset(record, true);
+
+    QStringList result;
+    QList<QStringView> fields;
+    if (tokenizer.readRecord(&fields)) {
+        result.reserve(fields.size());
+        for (QStringView field : std::as_const(fields))
+            result.append(field.toString());
+    }
+    return result;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,136 @@
+/****************************************************************************
+**
+** Copyright (C) 2023 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the Qt Quick Dialogs module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QUICKSTUDIOCSVTOKENIZER_H
+#define QUICKSTUDIOCSVTOKENIZER_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qbytearrayview.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qstringconverter.h>
+#include <QtCore/qstringlist.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    RFC 4180 tokenizer for QuickStudioCsvTableModel.
+
+    reset() builds a structural index of the buffer: the offsets of the commas
+    and line breaks that are not inside quoted fields. Quotes, commas and line
+    feeds are located 64 bytes at a time with SSE2 or NEON compares turned
+    into bit masks (plain C++ elsewhere); the quoted regions are the prefix XOR
+    of the quote mask, carried from block to block, so a comma or line break
+    inside quotes drops out with a single AND. This follows simdjson/simdcsv.
+    A quote only opens a quoted field at the start of a field; a block with a
+    stray quote elsewhere (as in 5" floppy) is scanned byte by byte instead,
+    so the quote is kept as text and does not swallow the rest of the file.
+
+    readRecord() then walks the index. The fields of a record are decoded into
+    one reused buffer (doubled quotes unescaped, the \r of a CRLF dropped) and
+    returned as views into it, so no memory is allocated per field.
+*/
+class QuickStudioCsvTokenizer
+{
+public:
+    // Where a scan stopped, so that it can be continued with the next bytes.
+    // The default state is the beginning of a record.
+    struct ScanState
+    {
+        bool quoted = false;    // inside a quoted field
+        bool quoteOpens = true; // a quote at the next byte opens a quoted field
+    };
+
+    // Indexes data, which must outlive the tokenizer or the next reset().
+    // Unless atEnd is set, a record without a line break after it is
+    // considered incomplete and is not returned.
+    void reset(QByteArrayView data, bool atEnd);
+
+    // Like reset(), but data starts with the bytes indexed so far (less
+    // those dropped by discardRead()) and only the bytes after them are
+    // scanned, so a buffer that is read in pieces is indexed only once.
+    void extend(QByteArrayView data, bool atEnd);
+
+    // Drops the records read so far: offsets, position() included, then
+    // count from the first byte that has not been read.
+    void discardRead();
+
+    // Reads the next complete record. The views stay valid until the next
+    // call. Returns false when no complete record is left.
+    bool readRecord(QList<QStringView> *fields);
+
+    // Offset just past the last record read (and its line break, if any).
+    qsizetype position() const { return m_position; }
+
+    // Appends base plus the offset just past each line break that is not
+    // inside a quoted field. data must start where state was left; state is
+    // updated to the end of data.
+    static void findRecordEnds(QByteArrayView data,
+                               qint64 base,
+                               ScanState *state,
+                               QList<qint64> *recordEnds);
+
+    // Splits a single record (e.g. the header line) into its fields.
+    static QStringList split(QByteArrayView record);
+
+private:
+    QChar *decodeField(QByteArrayView field, QChar *out);
+
+    QByteArrayView m_data;
+    bool m_atEnd = false;
+    ScanState m_scanState;
+    QList<qsizetype> m_separators;
+    qsizetype m_next = 0;
+    qsizetype m_position = 0;
+
+    QString m_text;
+    QList<qsizetype> m_fieldEnds;
+    QStringDecoder m_decoder{QStringDecoder::Utf8, QStringDecoder::Flag::Stateless};
+};
+
+QT_END_NAMESPACE
+
+#endif // QUICKSTUDIOCSVTOKENIZER_H
@@ -0,0 +1,351 @@
+/****************************************************************************
+**
+** Copyright (C) 2023 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the Qt Quick Dialogs module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "quickstudiocsvcolumnstore.h"
+
+#include <QRandomGenerator>
+#include <QRegularExpression>
+#include <QtTest>
+
+#include <iterator>
+
+/*
+    Differential test of the column type inference. The column store used to
+    classify the first cell of a column with the regular expression below; it
+    now does so by hand. Both must give the same type and value for any cell,
+    except for hex numbers, which the old code typed as numbers but converted
+    to 0 and now convert to their value.
+
+    The cells after the first one of a typed column are converted to the
+    column type; that conversion used QString::toDouble() and now uses
+    std::from_chars() on the trimmed cell, and is checked the same way. The
+    benchmarks compare both paths with their reference.
+*/
+class tst_QuickStudioCsvColumnStore : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void inference_data();
+    void inference();
+    void randomCells();
+    void typedDouble();
+    void typedBool();
+    void benchmarkInference_data();
+    void benchmarkInference();
+    void benchmarkTypedDouble_data();
+    void benchmarkTypedDouble();
+};
+
+// The inference of the column store before the hand-written classifier
+static QVariant referenceInference(const QString &value)
+{
+    constexpr QStringView typesPattern{u"(?<boolean>^(?:true|false)$)|"
+                                       u"(?<number>^(?:-?(?:0|[1-9]\\d*)?(?:\\.\\d*)?(?<=\\d|\\.)"
+                                       u"(?:e-?(?:0|[1-9]\\d*))?|0x[0-9a-f]+)$)|"
+                                       u"(?<color>^(?:#(?:(?:[0-9a-fA-F]{2}){3,4}|"
+                                       u"(?:[0-9a-fA-F]){3,4}))$)"};
+
+    static QRegularExpression validator(typesPattern.toString());
+    const QString trimmedValue = value.trimmed();
+    QRegularExpressionMatch match = validator.match(trimmedValue);
+
+    if (!match.hasMatch())
+        return value;
+
+    if (!match.captured(u"boolean").isEmpty())
+        return QVariant::fromValue<bool>(trimmedValue.at(0).toLower() == u't');
+
+    if (!match.captured(u"number").isEmpty()) {
+        if (trimmedValue.startsWith(u"0x")) {
+            double number = 0;
+            for (qsizetype i = 2; i < trimmedValue.size(); ++i)
+                number = number * 16 + QStringView(trimmedValue).sliced(i, 1).toInt(nullptr, 16);
+            return number;
+        }
+        return trimmedValue.toDouble();
+    }
+
+    if (!match.captured(u"color").isEmpty())
+        return QColor::fromString(trimmedValue);
+
+    return value;
+}
+
+// The conversion of the cells after the first one of a Double column before
+// from_chars(). Hex cells were kept raw; they now convert to their value.
+static QVariant referenceTypedDouble(const QString &cell)
+{
+    const QString trimmedValue = cell.trimmed();
+    if (trimmedValue.size() > 2 && trimmedValue.startsWith(u"0x")) {
+        bool hex = true;
+        double number = 0;
+        for (qsizetype i = 2; i < trimmedValue.size() && hex; ++i) {
+            const int digit = QStringView(trimmedValue).sliced(i, 1).toInt(&hex, 16);
+            hex = hex && !trimmedValue.at(i).isUpper();
+            number = number * 16 + digit;
+        }
+        if (hex)
+            return number;
+    }
+
+    bool ok = false;
+    const double number = cell.toDouble(&ok);
+    if (ok)
+        return number;
+    return cell;
+}
+
+// The conversion of the cells after the first one of a Bool column before
+// equalsIgnoringCase()
+static QVariant referenceTypedBool(const QString &cell)
+{
+    const QString lowerValue = cell.toLower().trimmed();
+    if (lowerValue == u"true")
+        return true;
+    if (lowerValue == u"false")
+        return false;
+    return cell;
+}
+
+static QVariant inferred(const QString &cell)
+{
+    QuickStudioCsvColumnStore store;
+    store.reset(1);
+    store.appendRow({QStringView(cell)});
+    return store.value(0, 0);
+}
+
+static void compareWithReference(const QString &cell)
+{
+    const QVariant expected = referenceInference(cell);
+    const QVariant actual = inferred(cell);
+
+    QVERIFY2(actual.typeId() == expected.typeId(),
+             qPrintable(QStringLiteral("\"%1\": %2 instead of %3")
+                            .arg(cell, QString::fromLatin1(actual.typeName()),
+                                 QString::fromLatin1(expected.typeName()))));
+    if (expected.typeId() == QMetaType::Double)
+        QCOMPARE(actual.toDouble(), expected.toDouble());
+    else
+        QCOMPARE(actual, expected);
+}
+
+void tst_QuickStudioCsvColumnStore::inference_data()
+{
+    QTest::addColumn<QString>("cell");
+
+    const char *cells[] = {
+        "true", "false", " true ", "True", "TRUE", "truex", "t", "f",
+        "0", "-0", "00", "01", "10", "-12.5", "1.", ".5", "-.5", ".", "-.", "-",
+        "1e5", "1e-5", "1e05", "1e", "1E5", "e5", "1.5e-0", "+1", "1,5",
+        "0x1f", "0x", "0X1f", "0x1F", "0xg", "-0x1",
+        "#fff", "#ffff", "#ffffff", "#ffffffff", "#ff", "#fffff", "#ggg", "#FfA0b1",
+        " ", "abc", "nan", "inf", "-inf", "1 2", " 42 ",
+    };
+    for (const char *cell : cells)
+        QTest::newRow(cell) << QString::fromLatin1(cell);
+}
+
+void tst_QuickStudioCsvColumnStore::inference()
+{
+    QFETCH(QString, cell);
+    compareWithReference(cell);
+}
+
+// Cells glued together from pieces that are likely to hit the edges of the
+// grammar
+void tst_QuickStudioCsvColumnStore::randomCells()
+{
+    static const char *pieces[] = {
+        "0", "1", "7", "9", "-", ".", "e", "E", "x", "0x", "a", "f", "F", "g", "#",
+        "t", "true", "false", "ru", " ", "+", "12", "e-",
+    };
+    constexpr int pieceCount = int(std::size(pieces));
+
+    QRandomGenerator random(2047);
+    for (int i = 0; i < 200000; ++i) {
+        QString cell;
+        const int length = random.bounded(1, 7);
+        for (int j = 0; j < length; ++j)
+            cell += QLatin1String(pieces[random.bounded(pieceCount)]);
+        compareWithReference(cell);
+        if (QTest::currentTestFailed())
+            return;
+    }
+}
+
+// Appends cells as rows 1.. of a column typed by firstCell and compares every
+// value with the reference conversion
+static void compareTypedColumn(const QString &firstCell, const QStringList &cells,
+                               QVariant (*reference)(const QString &))
+{
+    QuickStudioCsvColumnStore store;
+    store.reset(1);
+    store.appendRow({QStringView(firstCell)});
+    for (const QString &cell : cells)
+        store.appendRow({QStringView(cell)});
+
+    bool clean = true;
+    for (int i = 0; i < cells.size(); ++i) {
+        const QString &cell = cells.at(i);
+        const QVariant expected = reference(cell);
+        const QVariant actual = store.value(i + 1, 0);
+        const bool raw = expected.typeId() == QMetaType::QString;
+        clean = clean && !raw;
+
+        QVERIFY2(actual.typeId() == expected.typeId(),
+                 qPrintable(QStringLiteral("\"%1\": %2 instead of %3")
+                                .arg(cell, QString::fromLatin1(actual.typeName()),
+                                     QString::fromLatin1(expected.typeName()))));
+        QCOMPARE(actual, expected);
+        QCOMPARE(store.isRaw(i + 1, 0), raw);
+    }
+    QCOMPARE(store.isClean(0), clean);
+}
+
+void tst_QuickStudioCsvColumnStore::typedDouble()
+{
+    const QString longNumber = QStringLiteral("1.") + QString(70, u'5');
+    const QString longInteger = QStringLiteral("1") + QString(69, u'0');
+    const QString boundary = QStringLiteral("0.") + QString(62, u'3');   // 64 characters
+    const QString padded = QString(40, u' ') + QStringLiteral("12.25") + QString(30, u' ');
+    const QString longText = QString(80, u'a');
+
+    QStringList cells = {
+        "2", " 3 ", "\t4.5\n", "  -1e3  ", "+7", "-0", ".5", "5.", "1E5",
+        "0x1f", " 0x10 ", "0x", "0X1f", "0x1F", "-0x1",
+        "abc", "1 2", "1,5", "12abc", "--1", "+-1", "\u00b9",
+        longNumber, longInteger, boundary, padded, longText,
+        QStringLiteral(" ") + longNumber + QStringLiteral(" "),
+    };
+    QCOMPARE(boundary.size(), 64);
+    compareTypedColumn(QStringLiteral("1"), cells, referenceTypedDouble);
+}
+
+void tst_QuickStudioCsvColumnStore::typedBool()
+{
+    const QStringList cells = {
+        "true", "false", " TRUE ", "False", "\ttrue\n", "yes", "1", "truex", "t",
+        QString(70, u' ') + QStringLiteral("false"),
+    };
+    compareTypedColumn(QStringLiteral("false"), cells, referenceTypedBool);
+}
+
+static QStringList benchmarkCells(int count)
+{
+    static const char *samples[] = {
+        "12.5", "-3", "0.001", "1e5", "true", "false", "#ff8800", "label", " 42 ", "0x1f",
+    };
+    QRandomGenerator random(47);
+    QStringList cells;
+    cells.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        if (i % 2)
+            cells << QString::number(random.bounded(100000) / 100.0);
+        else
+            cells << QLatin1String(samples[i % std::size(samples)]);
+    }
+    return cells;
+}
+
+void tst_QuickStudioCsvColumnStore::benchmarkInference_data()
+{
+    QTest::addColumn<bool>("reference");
+    QTest::newRow("classifier") << false;
+    QTest::newRow("regex") << true;
+}
+
+// Type inference of the first cell of 10k columns
+void tst_QuickStudioCsvColumnStore::benchmarkInference()
+{
+    QFETCH(bool, reference);
+    const QStringList cells = benchmarkCells(10000);
+    QList<QStringView> fields;
+    for (const QString &cell : cells)
+        fields << QStringView(cell);
+
+    if (reference) {
+        QBENCHMARK {
+            for (const QString &cell : cells)
+                referenceInference(cell);
+        }
+    } else {
+        QuickStudioCsvColumnStore store;
+        QBENCHMARK {
+            store.reset(int(fields.size()));
+            store.appendRow(fields);
+        }
+    }
+}
+
+void tst_QuickStudioCsvColumnStore::benchmarkTypedDouble_data()
+{
+    QTest::addColumn<bool>("reference");
+    QTest::newRow("from_chars") << false;
+    QTest::newRow("QString::toDouble") << true;
+}
+
+// Conversion of 100k cells of an already typed Double column
+void tst_QuickStudioCsvColumnStore::benchmarkTypedDouble()
+{
+    QFETCH(bool, reference);
+    QStringList cells;
+    QRandomGenerator random(2047);
+    for (int i = 0; i < 100000; ++i)
+        cells << QString::number(random.generateDouble() * 1000.0 - 500.0, 'g', 12);
+
+    if (reference) {
+        QBENCHMARK {
+            for (const QString &cell : cells)
+                referenceTypedDouble(cell);
+        }
+    } else {
+        QuickStudioCsvColumnStore store;
+        const QString first = QStringLiteral("0");
+        QBENCHMARK {
+            store.reset(1);
+            store.reserve(int(cells.size()) + 1);
+            store.appendRow({QStringView(first)});
+            for (const QString &cell : cells)
+                store.appendRow({QStringView(cell)});
+        }
+    }
+}
+
+QTEST_GUILESS_MAIN(tst_QuickStudioCsvColumnStore)
+
+#include "tst_quickstudiocsvcolumnstore.moc"